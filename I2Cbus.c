@@ -6,6 +6,7 @@
  * Author: Goce Boshkovski
  *
  * Copyright (c) 2016  Goce Boshkovski
+ * Copyright (c) 2026  libBMP085 contributors
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -14,16 +15,169 @@
 
 /** @file I2Cbus.c
  *  @brief Implements the functions defined in the header file I2Cbus.h.
- *	@date May 9, 2016
+ *	@date May 9, 2016, extended in 2026
  *  @author Goce Boshkovski
+ *  @author libBMP085 contributors
  */
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
+#include <linux/gpio.h>
 #include <time.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/stat.h>
 #include "I2Cbus.h"
 
+/*
+ * Per file descriptor state of the opened buses: the transfer method supported by
+ * the adapter and the slave address the file descriptor is currently bound to.
+ * openI2CBus() and closeI2CBus() reset the state. It also records the device and
+ * inode of the open file, checked only after a failed transfer, so a number reused
+ * for another file after a plain close() costs one failed transfer and a retry.
+ * Buses with a file descriptor above I2CBUS_MAX_FD are probed on every transfer.
+ */
+#define I2CBUS_MAX_FD 256
+#define I2CBUS_METHOD_UNKNOWN 0
+#define I2CBUS_METHOD_RDWR 1
+#define I2CBUS_METHOD_READWRITE 2
+
+static struct
+{
+	unsigned char method;
+	short slave;	/* Address selected with I2C_SLAVE, -1 when unknown. */
+	dev_t rdev;	/* Device number of the open file the state belongs to. */
+	ino_t ino;	/* Inode of the open file the state belongs to. */
+	char *device;	/* Device the bus was opened from, for I2CBus_reopen(). */
+#ifdef BMP085_STATS
+	BMP085Stats stats;	/* Transactions of the bus, cleared when the bus is opened. */
+#endif
+} I2CBus_state[I2CBUS_MAX_FD];
+
+static void I2CBus_resetState(int bus)
+{
+	if (bus >= 0 && bus < I2CBUS_MAX_FD)
+	{
+		I2CBus_state[bus].method = I2CBUS_METHOD_UNKNOWN;
+		I2CBus_state[bus].slave = -1;
+	}
+}
+
+/* Records the open file of the bus as the owner of the cached state. */
+static void I2CBus_identify(int bus)
+{
+	struct stat status;
+
+	if (bus < 0 || bus >= I2CBUS_MAX_FD)
+		return;
+	if (fstat(bus,&status))
+	{
+		status.st_rdev = 0;
+		status.st_ino = 0;
+	}
+	I2CBus_state[bus].rdev = status.st_rdev;
+	I2CBus_state[bus].ino = status.st_ino;
+}
+
+/* Checks after a failed transfer that the cached state belongs to the open file of the bus, resetting it for a different file. */
+static int I2CBus_validState(int bus)
+{
+	struct stat status;
+
+	if (bus < 0 || bus >= I2CBUS_MAX_FD)
+		return 1;
+	// A closed descriptor has no other file to retry on.
+	if (fstat(bus,&status) || (status.st_rdev == I2CBus_state[bus].rdev && status.st_ino == I2CBus_state[bus].ino))
+		return 1;
+
+	I2CBus_resetState(bus);
+	I2CBus_identify(bus);
+	return 0;
+}
+
+#ifdef BMP085_STATS
+/* Counts a transaction of the bus and its latency. */
+static void I2CBus_count(int bus,int write,int size,int result,long long begin)
+{
+	BMP085Stats *stats;
+
+	if (bus < 0 || bus >= I2CBUS_MAX_FD)
+		return;
+
+	stats = &(I2CBus_state[bus].stats);
+	BMP085Stats_record(&(stats->latency[statsTransfer]),tNow() - begin);
+	if (write)
+	{
+		stats->writes++;
+		if (result)
+			stats->writeErrors++;
+		else
+			stats->bytesWritten += size;
+	}
+	else
+	{
+		stats->reads++;
+		if (result)
+			stats->readErrors++;
+		else
+			stats->bytesRead += size;
+	}
+	if (result)
+		BMP085Stats_countError(stats,errno);
+}
+#endif
+
+/* Returns the transfer method of the bus, probing the adapter functionality on first use. */
+static int I2CBus_method(int bus)
+{
+	unsigned long funcs;
+	int method;
+
+	if (bus >= 0 && bus < I2CBUS_MAX_FD && I2CBus_state[bus].method != I2CBUS_METHOD_UNKNOWN)
+		return I2CBus_state[bus].method;
+
+	if (ioctl(bus,I2C_FUNCS,&funcs) == 0 && (funcs & I2C_FUNC_I2C))
+		method = I2CBUS_METHOD_RDWR;
+	else
+		method = I2CBUS_METHOD_READWRITE;
+
+	if (bus >= 0 && bus < I2CBUS_MAX_FD)
+	{
+		I2CBus_state[bus].method = method;
+		I2CBus_identify(bus);
+	}
+	return method;
+}
+
+/* Binds the file descriptor to the slave address, unless it is already bound to it. */
+static int I2CBus_selectSlave(int bus,unsigned char I2CAddress)
+{
+	if (bus >= 0 && bus < I2CBUS_MAX_FD && I2CBus_state[bus].slave == I2CAddress)
+		return 0;
+
+	if (ioctl(bus,I2C_SLAVE,I2CAddress)<0)
+	{
+		I2CBus_resetState(bus);
+		return 1;
+	}
+
+	if (bus >= 0 && bus < I2CBUS_MAX_FD)
+		I2CBus_state[bus].slave = I2CAddress;
+	return 0;
+}
+
+/* Remembers the device of the bus, or forgets it when device is NULL. */
+static void I2CBus_setDevice(int bus,const char *device)
+{
+	if (bus < 0 || bus >= I2CBUS_MAX_FD)
+		return;
+	free(I2CBus_state[bus].device);
+	I2CBus_state[bus].device = device ? strdup(device) : NULL;
+}
+
 /* Open I2C bus for R/W access. */
 int openI2CBus(int *bus,char * device)
 {
@@ -31,6 +185,10 @@ int openI2CBus(int *bus,char * device)
         if (*bus<0)
 	        return ERROR_OPEN_I2C_BUS;
 
+        I2CBus_resetState(*bus);
+        I2CBus_identify(*bus);
+        I2CBus_resetStats(*bus);
+        I2CBus_setDevice(*bus,device);
         return 0;
 }
 
@@ -38,53 +196,256 @@ int openI2CBus(int *bus,char * device)
 int closeI2CBus(int *bus)
 {
 	if (*bus)
+	{
+		I2CBus_resetState(*bus);
+		I2CBus_setDevice(*bus,NULL);
 		return close(*bus);
+	}
 	else
 		return ERROR_CLOSE_I2C_BUS;
 
 }
 
 /* Read data from the sensor via I2C bus. */
-int I2CSensor_Read(int *bus,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+static int I2CBus_read(int *bus,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
 {
-	/*Select the sensor on the I2C bus with an address as a slave device.*/
-	if (ioctl(*bus,I2C_SLAVE,I2CAddress)<0)
-		return ERROR_I2C_READ_FAILED;
+	struct i2c_msg messages[2] = {
+		{ .addr = I2CAddress, .flags = 0, .len = 1, .buf = &registry },
+		{ .addr = I2CAddress, .flags = I2C_M_RD, .len = size, .buf = buffer }
+	};
+	struct i2c_rdwr_ioctl_data transfer = { messages, 2 };
 
-	/* Place the registry address on I2C bus */
-	if (write(*bus,&registry,1)!=1)
-		return ERROR_I2C_READ_FAILED;
+	/* Register address and data in one transfer, with a repeated START in between. */
+	if (I2CBus_method(*bus) == I2CBUS_METHOD_RDWR)
+	{
+		if (ioctl(*bus,I2C_RDWR,&transfer) == 2)
+			return 0;
+	}
+	/*Select the sensor on the I2C bus with an address as a slave device.*/
+	else if (!I2CBus_selectSlave(*bus,I2CAddress))
+	{
+		/* Place the registry address on I2C bus and read the data from the I2C bus */
+		if (write(*bus,&registry,1)==1 && read(*bus,buffer,size)==size)
+			return 0;
+	}
 
-	/* Read the data from the I2C bus */
-	if (read(*bus,buffer,size)!=size)
+	// The number may have been reused for another file, whose adapter is probed and bound once more.
+	if (I2CBus_validState(*bus))
 		return ERROR_I2C_READ_FAILED;
-
-	return 0;
+	return I2CBus_read(bus,I2CAddress,registry,buffer,size);
 }
 
 /* Sends data to the sensor by writing data on the I2C bus. */
-int I2CSensor_Write(int *bus,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+static int I2CBus_write(int *bus,unsigned char I2CAddress,unsigned char registry,unsigned char value)
 {
 	unsigned char tbuffer[2] = { registry, value };
+	struct i2c_msg message = { .addr = I2CAddress, .flags = 0, .len = 2, .buf = tbuffer };
+	struct i2c_rdwr_ioctl_data transfer = { &message, 1 };
 
+	if (I2CBus_method(*bus) == I2CBUS_METHOD_RDWR)
+	{
+		if (ioctl(*bus,I2C_RDWR,&transfer) == 1)
+			return 0;
+	}
 	/*Select the sensor on the I2C bus with an address as a slave device.*/
-	if (ioctl(*bus,I2C_SLAVE,I2CAddress)<0)
-		return ERROR_I2C_WRITE_FAILED;
+	else if (!I2CBus_selectSlave(*bus,I2CAddress))
+	{
+		/* Place the register address and its value on I2C bus */
+		if (write(*bus,tbuffer,2)==2)
+			return 0;
+	}
 
-	/* Place the register address and its value on I2C bus */
-	if (write(*bus,tbuffer,2)!=2)
+	if (I2CBus_validState(*bus))
 		return ERROR_I2C_WRITE_FAILED;
+	return I2CBus_write(bus,I2CAddress,registry,value);
+}
+
+/* Read data from the sensor via I2C bus and count the transaction. */
+int I2CSensor_Read(int *bus,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+{
+#ifdef BMP085_STATS
+	long long begin = tNow();
+	int result;
+
+	errno = 0;
+	result = I2CBus_read(bus,I2CAddress,registry,buffer,size);
+	I2CBus_count(*bus,0,size,result,begin);
+	return result;
+#else
+	return I2CBus_read(bus,I2CAddress,registry,buffer,size);
+#endif
+}
+
+/* Sends data to the sensor and counts the transaction. */
+int I2CSensor_Write(int *bus,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+{
+#ifdef BMP085_STATS
+	long long begin = tNow();
+	int result;
+
+	errno = 0;
+	result = I2CBus_write(bus,I2CAddress,registry,value);
+	I2CBus_count(*bus,1,2,result,begin);
+	return result;
+#else
+	return I2CBus_write(bus,I2CAddress,registry,value);
+#endif
+}
+
+/* Copies the counters of the bus. */
+int I2CBus_getStats(int bus,BMP085Stats *stats)
+{
+#ifdef BMP085_STATS
+	if (bus < 0 || bus >= I2CBUS_MAX_FD)
+		return 1;
+	*stats = I2CBus_state[bus].stats;
+	return 0;
+#else
+	(void)bus;
+	(void)stats;
+	return 1;
+#endif
+}
 
+/* Clears the counters of the bus. */
+void I2CBus_resetStats(int bus)
+{
+#ifdef BMP085_STATS
+	if (bus >= 0 && bus < I2CBUS_MAX_FD)
+		memset(&(I2CBus_state[bus].stats),0,sizeof(BMP085Stats));
+#else
+	(void)bus;
+#endif
+}
+
+/* Reopens the device of the bus on the same file descriptor. */
+int I2CBus_reopen(int bus)
+{
+	int fd;
+
+	if (bus < 0 || bus >= I2CBUS_MAX_FD || !I2CBus_state[bus].device)
+		return ERROR_OPEN_I2C_BUS;
+
+	fd = open(I2CBus_state[bus].device,O_RDWR);
+	if (fd < 0)
+		return ERROR_OPEN_I2C_BUS;
+	if (dup2(fd,bus) < 0)
+	{
+		close(fd);
+		return ERROR_OPEN_I2C_BUS;
+	}
+	close(fd);
+
+	// The new open file description is not bound to a slave yet.
+	I2CBus_resetState(bus);
+	I2CBus_identify(bus);
 	return 0;
 }
 
-/* A time delay function.*/
+/* i2c-dev transport: the context is a pointer to the bus file descriptor. */
+static int I2CBus_devRead(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+{
+	return I2CSensor_Read((int *)context,I2CAddress,registry,buffer,size);
+}
+
+static int I2CBus_devWrite(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+{
+	return I2CSensor_Write((int *)context,I2CAddress,registry,value);
+}
+
+static int I2CBus_devRecover(void *context)
+{
+	return I2CBus_reopen(*(int *)context);
+}
+
+const I2CBusOps I2CBus_devOps = { .read = I2CBus_devRead, .write = I2CBus_devWrite, .recover = I2CBus_devRecover };
+
+/* Requests rising edge events of a GPIO line, with the v2 uAPI or the v1 uAPI of older kernels. */
+int openEocLine(int *line,const char *chip,unsigned int offset)
+{
+#ifdef GPIO_V2_GET_LINE_IOCTL
+	struct gpio_v2_line_request request;
+#endif
+	struct gpioevent_request legacy;
+	int fd = open(chip,O_RDONLY|O_CLOEXEC);
+
+	*line = -1;
+	if (fd < 0)
+		return ERROR_OPEN_EOC_LINE;
+
+#ifdef GPIO_V2_GET_LINE_IOCTL
+	memset(&request,0,sizeof(request));
+	request.offsets[0] = offset;
+	request.num_lines = 1;
+	strncpy(request.consumer,"libbmp085 EOC",sizeof(request.consumer)-1);
+	request.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING;
+	if (!ioctl(fd,GPIO_V2_GET_LINE_IOCTL,&request))
+		*line = request.fd;
+#endif
+
+	if (*line < 0)
+	{
+		memset(&legacy,0,sizeof(legacy));
+		legacy.lineoffset = offset;
+		legacy.handleflags = GPIOHANDLE_REQUEST_INPUT;
+		legacy.eventflags = GPIOEVENT_REQUEST_RISING_EDGE;
+		strncpy(legacy.consumer_label,"libbmp085 EOC",sizeof(legacy.consumer_label)-1);
+		if (!ioctl(fd,GPIO_GET_LINEEVENT_IOCTL,&legacy))
+			*line = legacy.fd;
+	}
+	close(fd);
+
+	if (*line < 0 || fcntl(*line,F_SETFL,fcntl(*line,F_GETFL) | O_NONBLOCK))
+	{
+		if (*line >= 0)
+			close(*line);
+		*line = -1;
+		return ERROR_OPEN_EOC_LINE;
+	}
+	return 0;
+}
+
+/* Releases the GPIO line. */
+int closeEocLine(int *line)
+{
+	int result;
+
+	if (*line < 0)
+		return 0;
+	result = close(*line);
+	*line = -1;
+	return result;
+}
+
+/* A time delay function, resumed with the remaining time when interrupted by a signal.*/
 void tDelay(long interval)
 {
-    struct timespec timer;
+	struct timespec timer;
+
+	timer.tv_sec = interval/1000000000L;
+	timer.tv_nsec = interval%1000000000L;
+
+	while (nanosleep(&timer,&timer) == -1 && errno == EINTR)
+		;
+}
+
+/* Current time of the monotonic clock in [ns]. */
+long long tNow(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return (long long)now.tv_sec*1000000000LL+now.tv_nsec;
+}
+
+/* Sleeps until an absolute time of the monotonic clock. */
+void tDelayUntil(long long time)
+{
+	struct timespec timer;
 
-    timer.tv_sec = 0;
-    timer.tv_nsec = interval;
+	timer.tv_sec = time/1000000000LL;
+	timer.tv_nsec = time%1000000000LL;
 
-    nanosleep(&timer, NULL);
+	while (clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&timer,NULL) == EINTR)
+		;
 }
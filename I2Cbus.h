@@ -6,6 +6,7 @@
  * Author: Goce Boshkovski
  *
  * Copyright (c) 2016  Goce Boshkovski
+ * Copyright (c) 2026  libBMP085 contributors
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -20,7 +21,8 @@
   * and constants.
   *
   * @author Goce Boshkovski
-  * @date May 9, 2016
+  * @author libBMP085 contributors
+  * @date May 9, 2016, extended in 2026
   * @copyright GNU General Public License v2.
   *
   */
@@ -28,12 +30,60 @@
 #ifndef I2CBUS_H_
 #define I2CBUS_H_
 
+#include <stdint.h>
+#include "bmp085stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** \defgroup I2C_BUS_ERROR_CODES I2C error codes */
 /* @{ */
 #define ERROR_OPEN_I2C_BUS 1
 #define ERROR_CLOSE_I2C_BUS 2
 #define ERROR_I2C_READ_FAILED 3
 #define ERROR_I2C_WRITE_FAILED 4
+#define ERROR_OPEN_EOC_LINE 5
+/* @} */
+
+/** \defgroup I2CBUS_OPS I2C bus transport interface */
+/* @{ */
+
+/**
+ * @brief Table of operations used by the library for accessing the sensor registers.
+ *
+ * The library never talks to the I2C bus directly. Every register access goes
+ * through the operations of the transport assigned to the sensor, which makes it
+ * possible to replace the Linux i2c-dev interface with another backend,
+ * for example the simulated sensor from bmp085sim.h.
+ *
+ * A backend that cannot reach the registers, like a kernel driver bound to the
+ * sensor (bmp085iio.h), provides measure instead: the library then skips the
+ * calibration table and takes every measurement through that operation.
+ *
+ * Define tables with designated initializers, for example
+ * { .read = myRead, .write = myWrite }, so optional operations added later
+ * default to NULL without touching every backend.
+ */
+typedef struct i2cbusops
+{
+	/** Reads \a size bytes starting from \a registry. Returns 0 for success, error code otherwise. */
+	int (*read)(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size);
+	/** Writes \a value in \a registry. Returns 0 for success, error code otherwise. */
+	int (*write)(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char value);
+	/** Optional, restores the transport after repeated failures. Returns 0 for success, error code otherwise. NULL when not supported. */
+	int (*recover)(void *context);
+	/** Optional, measures the temperature in 0.1 degrees Celsius and the pressure in [Pa] with the over sampling mode \a oss. Returns 0 for success, error code otherwise. NULL for register access. */
+	int (*measure)(void *context,unsigned char I2CAddress,int oss,int32_t *temperature,int32_t *pressure);
+} I2CBusOps;
+
+/**
+ * @brief Transport over the Linux i2c-dev interface.
+ *
+ * The context passed to the operations is a pointer to the file descriptor
+ * returned by openI2CBus().
+ */
+extern const I2CBusOps I2CBus_devOps;
 /* @} */
 
 /** \defgroup I2CBUS_FUNC I2C bus functions */
@@ -42,6 +92,14 @@
 /**
  * @brief Opens the device file for accessing the I2C bus.
  *
+ * The library caches the transfer method of the adapter and the selected slave
+ * address per file descriptor. Open and close every bus with openI2CBus() and
+ * closeI2CBus(), the only calls that reset that state, so transfers make no
+ * extra system calls. A descriptor number reused for another device file is
+ * detected after its first failed transfer, which is then retried, but a bus
+ * closed with close() and opened again on the same device file with open()
+ * keeps failing on adapters without I2C_RDWR until it is reopened with openI2CBus().
+ *
  * @param [in,out] bus file descriptor assigned after successful opening of the I2C device file for R/W access.
  * @param [in] device name of the device file that represents the I2C interface on the system.
  * @return 0 for successful access to the I2C interface, error code ERROR_OPEN_I2C_BUS in case of a  failure.
@@ -59,6 +117,11 @@ int closeI2CBus(int *bus);
 /**
  * @brief Reads data from the sensor via I2C bus.
  *
+ * On adapters that support plain I2C transfers the register address and the data
+ * are transferred with a single I2C_RDWR ioctl, using a repeated START instead of
+ * a STOP between the two messages. Other adapters fall back to I2C_SLAVE, write()
+ * and read(), and I2C_SLAVE is skipped when the bus is already bound to the address.
+ *
  * @param [in] bus	file descriptor of the opened I2C device file.
  * @param [in] I2CAddress address of the sensor on the I2C bus.
  * @param [in] registry address of the registry from the sensor.
@@ -71,6 +134,8 @@ int I2CSensor_Read(int *bus,unsigned char I2CAddress,unsigned char registry,unsi
 /**
  * @brief Sends data to the sensor by writing data on the I2C bus.
  *
+ * Uses a single I2C_RDWR ioctl when the adapter supports plain I2C transfers.
+ *
  * @param [in] bus	file descriptor of the opened I2C device file.
  * @param [in] I2CAddress address of the sensor on the I2C bus.
  * @param [in] registry address of the registry from the sensor.
@@ -80,13 +145,88 @@ int I2CSensor_Read(int *bus,unsigned char I2CAddress,unsigned char registry,unsi
 int I2CSensor_Write(int *bus,unsigned char I2CAddress,unsigned char registry,unsigned char value);
 
 /**
- * @brief A time delay function that introduces delays in [ms].
+ * @brief A time delay function that introduces delays in [ns].
  *
- * Used during the temperature/pressure measurement.
+ * Delays of a second or more are supported. When the sleep is interrupted by
+ * a signal it is resumed for the remaining time. For periodic work use
+ * tDelayUntil() or BMP085Scheduler, which do not accumulate drift.
  * @param interval defines the duration of the time delay.
  */
 void tDelay(long interval);
 
+/**
+ * @brief Returns the current time of the CLOCK_MONOTONIC clock in [ns].
+ */
+long long tNow(void);
+
+/**
+ * @brief Sleeps until the CLOCK_MONOTONIC clock reaches \a time.
+ *
+ * @param time absolute time in [ns], as returned by tNow().
+ */
+void tDelayUntil(long long time);
+
+/**
+ * @brief Reopens the device of an I2C bus on the same file descriptor.
+ *
+ * Used for recovering a bus after repeated failures. The device given to
+ * openI2CBus() is opened again and placed on the file descriptor with dup2(),
+ * so sensors holding the descriptor keep working without being reinitialized.
+ *
+ * @param bus file descriptor returned by openI2CBus().
+ * @return int returns 0 for successful operation, ERROR_OPEN_I2C_BUS for failure.
+ */
+int I2CBus_reopen(int bus);
+
+/**
+ * @brief Requests the GPIO line wired to the EOC pin of the sensor.
+ *
+ * The line is requested as an input with rising edge events through the GPIO
+ * character device, with the v2 uAPI and with the v1 uAPI on kernels older
+ * than 5.10. The returned descriptor is non-blocking, becomes readable on
+ * every rising edge and can be watched with poll() or epoll. Pass it to
+ * BMP085_setEndOfConversionLine(). The gpio-sim module provides lines for
+ * testing without the hardware.
+ *
+ * @param [out] line file descriptor of the line events, -1 for failure.
+ * @param [in] chip GPIO character device, for example /dev/gpiochip0.
+ * @param [in] offset offset of the line on the chip.
+ * @return 0 for success, ERROR_OPEN_EOC_LINE for failure.
+ */
+int openEocLine(int *line,const char *chip,unsigned int offset);
+
+/**
+ * @brief Releases the GPIO line requested with openEocLine().
+ *
+ * @param [in,out] line file descriptor of the line events, set to -1.
+ * @return 0 for success, the result of close() otherwise.
+ */
+int closeEocLine(int *line);
+
+/**
+ * @brief Copies the counters and the transaction latency histogram of an i2c-dev bus.
+ *
+ * Every I2CSensor_Read() and I2CSensor_Write() on the bus is counted, whichever
+ * sensor it addresses. The counters are kept only when the library is built
+ * with BMP085_STATS and are cleared by openI2CBus().
+ *
+ * @param bus file descriptor of the I2C bus.
+ * @param[out] stats the counters of the bus.
+ * @return int returns 0 for successful operation, 1 when the library is built without BMP085_STATS.
+ */
+int I2CBus_getStats(int bus,BMP085Stats *stats);
+
+/**
+ * @brief Clears the counters of an i2c-dev bus.
+ *
+ * @param bus file descriptor of the I2C bus.
+ */
+void I2CBus_resetStats(int bus);
+
 /* @} */
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* I2CBUS_H_ */
@@ -0,0 +1,84 @@
+/*
+ * BMP085 library
+ * bench/bench.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bench.h
+  * @brief
+  * Common definitions of the libBMP085 benchmark suites.
+  *
+  * Every suite runs against the simulated sensor from bmp085sim.h,
+  * so the benchmarks do not need a sensor attached to the system.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of samples each suite collects per configuration, set with -n. */
+extern int bench_samples;
+
+/** Set with -x to sweep the whole input space in the exhaustive suite. */
+extern int bench_fullSweep;
+
+/** Names of the over sampling modes, indexed by overSampling. */
+extern const char *bench_ossName[];
+
+/**
+ * @brief Returns the CLOCK_MONOTONIC time in [ns].
+ */
+long long bench_now(void);
+
+/**
+ * @brief Prevents the compiler from optimizing away a computed value.
+ */
+void bench_consume(long value);
+
+/** \defgroup BENCH_SUITES Benchmark suites */
+/* @{ */
+int bench_transport(void);
+int bench_nonblocking(void);
+int bench_latency(void);
+int bench_reuse(void);
+int bench_compensation(void);
+int bench_batch(void);
+int bench_manager(void);
+int bench_group(void);
+int bench_stream(void);
+int bench_scheduler(void);
+int bench_filter(void);
+int bench_altitude(void);
+int bench_log(void);
+int bench_stats(void);
+int bench_retry(void);
+int bench_cpp(void);
+int bench_shm(void);
+int bench_calcache(void);
+int bench_iio(void);
+int bench_adaptive(void);
+int bench_exhaustive(void);
+int bench_arbiter(void);
+int bench_vario(void);
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_H_ */
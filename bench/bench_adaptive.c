@@ -0,0 +1,201 @@
+/*
+ * BMP085 library
+ * bench/bench_adaptive.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Runs a flight profile (still, a fast climb, still again) on a virtual
+ * timeline with the datasheet noise of the simulated sensor, sampling back to
+ * back in every fixed over sampling mode and with the adaptive controller
+ * under several budgets. Reports the sample rate, the noise while the
+ * pressure is steady, the tracking error of the last available reading
+ * during the climb and the mode switches. Also checks over the simulated bus
+ * that a mode change during a pressure conversion does not corrupt it.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085adaptive.h"
+
+#define BENCH_ADAPTIVE_PHASE 10000000000LL	/* Length of every phase in [ns]. */
+#define BENCH_ADAPTIVE_CLIMB 240.0	/* Pressure drop during the climb in [Pa/s], about 20 m/s. */
+#define BENCH_ADAPTIVE_QUERY 1000000LL	/* Period of the tracking error queries in [ns]. */
+#define BENCH_ADAPTIVE_SETTLE 1000000000LL	/* Excluded from the steady noise after a phase change in [ns]. */
+#define BENCH_ADAPTIVE_PRESSURE 100000
+
+typedef struct
+{
+	unsigned long samples;
+	unsigned long steadyCount, climbCount;
+	double steadySquares, climbSquares;
+} bench_adaptiveResult;
+
+/* True pressure of the profile at time t in [Pa]. */
+static double bench_adaptiveTruth(long long t)
+{
+	if (t < BENCH_ADAPTIVE_PHASE)
+		return BENCH_ADAPTIVE_PRESSURE;
+	if (t < 2*BENCH_ADAPTIVE_PHASE)
+		return BENCH_ADAPTIVE_PRESSURE - BENCH_ADAPTIVE_CLIMB*(t - BENCH_ADAPTIVE_PHASE)/1e9;
+	return BENCH_ADAPTIVE_PRESSURE - BENCH_ADAPTIVE_CLIMB*BENCH_ADAPTIVE_PHASE/1e9;
+}
+
+/* Set when t is in a steady phase, away from the climb. */
+static int bench_adaptiveSteady(long long t)
+{
+	return t < BENCH_ADAPTIVE_PHASE || t >= 2*BENCH_ADAPTIVE_PHASE + BENCH_ADAPTIVE_SETTLE;
+}
+
+/*
+ * Samples the profile in a fixed mode, or with the controller when adaptive
+ * is not NULL, one sample every interval or back to back when interval is 0.
+ * A sample measures the pressure at the start of its pressure conversion and
+ * is available at the end of the measurement.
+ */
+static void bench_adaptiveRun(BMP085Sim *sim,const BMP085Calibration *calibration,BMP085Adaptive *adaptive,
+	overSampling fixed,long long interval,bench_adaptiveResult *result)
+{
+	long long t = 0, query = 0, cost, next;
+	double last = 0, error;
+	int32_t pressure, b5;
+	uint16_t ut;
+	uint32_t up;
+	int oss, valid = 0;
+
+	result->samples = result->steadyCount = result->climbCount = 0;
+	result->steadySquares = result->climbSquares = 0;
+	sim->seed = 1;
+	while (t < 3*BENCH_ADAPTIVE_PHASE)
+	{
+		oss = adaptive ? BMP085Adaptive_mode(adaptive) : fixed;
+		cost = BMP085_TemperatureConversionTime + BMP085_PressureConversionTime[oss];
+		BMP085Sim_setEnvironment(sim,250,lround(bench_adaptiveTruth(t + BMP085_TemperatureConversionTime)));
+		BMP085Sim_rawSample(sim,oss,&ut,&up);
+		BMP085_calculateTemperature(calibration,ut,&b5);
+		pressure = BMP085_calculatePressure(calibration,oss,up,b5);
+
+		// Error of the previous reading until this one is available.
+		for (;query<t+cost;query+=BENCH_ADAPTIVE_QUERY)
+		{
+			if (!valid)
+				continue;
+			error = last - bench_adaptiveTruth(query);
+			if (bench_adaptiveSteady(query))
+			{
+				result->steadySquares += error*error;
+				result->steadyCount++;
+			}
+			else if (query >= BENCH_ADAPTIVE_PHASE && query < 2*BENCH_ADAPTIVE_PHASE)
+			{
+				result->climbSquares += error*error;
+				result->climbCount++;
+			}
+		}
+		last = pressure;
+		valid = 1;
+		result->samples++;
+
+		if (adaptive)
+			BMP085Adaptive_record(adaptive,t,pressure,oss,cost);
+		next = t + cost;
+		if (interval && next < t + interval)
+			next = t + interval;
+		t = next;
+	}
+}
+
+static void bench_adaptivePrint(const char *name,const bench_adaptiveResult *result,const BMP085Adaptive *adaptive)
+{
+	printf("%-36s %8.1f %10.2f %10.2f",name,result->samples/(3*BENCH_ADAPTIVE_PHASE/1e9),
+		sqrt(result->steadySquares/result->steadyCount),sqrt(result->climbSquares/result->climbCount));
+	if (adaptive)
+		printf(" %9lu",adaptive->summary.switches);
+	printf("\n");
+}
+
+/* Changes the mode during a pressure conversion of the simulated sensor and checks both measurements. */
+static int bench_adaptiveSwitch(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	int result;
+
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,ultraHighResolution) || BMP085_startMeasurement(&sensor))
+		return 1;
+	while ((result = BMP085_pollMeasurement(&sensor)) == BMP085_MEASUREMENT_PENDING && sensor.state != pressureConversion)
+		;
+	BMP085_setOverSampling(&sensor,ultraLowPower);
+	while (result == BMP085_MEASUREMENT_PENDING)
+		result = BMP085_pollMeasurement(&sensor);
+	if (result || sensor.pressure != 69964 || sensor.conversionOss != ultraHighResolution)
+	{
+		printf("measurement during the mode change: %ld Pa in mode %d\n",(long)sensor.pressure,sensor.conversionOss);
+		return 1;
+	}
+	if (BMP085_takeMeasurement(&sensor) || sensor.pressure != 69964 || sensor.conversionOss != ultraLowPower)
+	{
+		printf("measurement after the mode change: %ld Pa in mode %d\n",(long)sensor.pressure,sensor.conversionOss);
+		return 1;
+	}
+	return 0;
+}
+
+int bench_adaptive(void)
+{
+	adaptivePolicy policy = { 0, 0, BMP085ADAPTIVE_FAST_RATE, BMP085ADAPTIVE_SLOW_RATE, BMP085ADAPTIVE_HOLD_SAMPLES, BMP085ADAPTIVE_WINDOW };
+	BMP085Calibration calibration;
+	bench_adaptiveResult result;
+	BMP085Adaptive adaptive;
+	BMP085Sim sim;
+	char name[64];
+	int oss;
+
+	if (bench_adaptiveSwitch())
+		return 1;
+	puts("mode change during a pressure conversion: compensated in the mode it was started with");
+
+	BMP085Sim_init(&sim,0x77);
+	sim.datasheetNoise = 1;
+	if (BMP085_decodeCalibration(&calibration,&(sim.registers[BMP085_CALIBRATION_TABLE])))
+		return 1;
+
+	printf("\n%.0f s still, %.0f s climb at %.0f Pa/s, %.0f s still, datasheet noise:\n",BENCH_ADAPTIVE_PHASE/1e9,
+		BENCH_ADAPTIVE_PHASE/1e9,BENCH_ADAPTIVE_CLIMB,BENCH_ADAPTIVE_PHASE/1e9);
+	printf("%-36s %8s %10s %10s %9s\n","mode","samples/s","steady Pa","climb Pa","switches");
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		bench_adaptiveRun(&sim,&calibration,NULL,oss,0,&result);
+		snprintf(name,sizeof(name),"fixed %s",bench_ossName[oss]);
+		bench_adaptivePrint(name,&result,NULL);
+	}
+
+	if (BMP085Adaptive_init(&adaptive,NULL,ultraHighResolution))
+		return 1;
+	bench_adaptiveRun(&sim,&calibration,&adaptive,0,0,&result);
+	bench_adaptivePrint("adaptive",&result,&adaptive);
+	BMP085Adaptive_printSummary(&adaptive,stdout);
+
+	policy.latencyBudget = 20000000LL;
+	if (BMP085Adaptive_init(&adaptive,&policy,ultraHighResolution))
+		return 1;
+	bench_adaptiveRun(&sim,&calibration,&adaptive,0,0,&result);
+	bench_adaptivePrint("adaptive, 20 ms latency budget",&result,&adaptive);
+	BMP085Adaptive_printSummary(&adaptive,stdout);
+
+	policy.latencyBudget = 0;
+	policy.dutyBudget = 300;
+	if (BMP085Adaptive_init(&adaptive,&policy,ultraHighResolution))
+		return 1;
+	bench_adaptiveRun(&sim,&calibration,&adaptive,0,50000000LL,&result);
+	bench_adaptivePrint("adaptive, 20 Hz, 30 % duty budget",&result,&adaptive);
+	BMP085Adaptive_printSummary(&adaptive,stdout);
+
+	return 0;
+}
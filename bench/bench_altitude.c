@@ -0,0 +1,115 @@
+/*
+ * BMP085 library
+ * bench/bench_altitude.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Measures the error of BMP085_approximateAltitude against the pow()
+ * formula over pressure ranges and baselines, checks that the batch
+ * variant matches the scalar one and compares the conversion rates.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench.h"
+#include "bmp085batch.h"
+
+#define BENCH_ALTITUDE_COUNT 1000000
+
+/* Largest absolute error in [m] for every whole Pa between the two ratios of the baseline. */
+static double bench_altitudeError(double baseline,double lowRatio,double highRatio)
+{
+	double error, maximum = 0;
+	long pressure;
+
+	for (pressure=(long)ceil(baseline*lowRatio);pressure<=(long)(baseline*highRatio);pressure++)
+	{
+		error = fabs(BMP085_approximateAltitude(pressure,baseline) - BMP085_calculateAltitude(pressure,baseline));
+		if (error > maximum)
+			maximum = error;
+	}
+	return maximum;
+}
+
+int bench_altitude(void)
+{
+	static const double baselines[] = { 95000, 101325, 105000 };
+	static const double ranges[][2] = { { 0.25, 1.25 }, { 0.30, 1.10 }, { 0.10, 2.00 } };
+	int32_t *pressure = malloc(BENCH_ALTITUDE_COUNT*sizeof(int32_t));
+	float *altitude = malloc(BENCH_ALTITUDE_COUNT*sizeof(float));
+	long long begin, elapsed[4];
+	double sum;
+	int i, b, r, rounds = bench_samples / 4 + 1, n;
+
+	if (!pressure || !altitude)
+		return 1;
+
+	printf("largest error of BMP085_approximateAltitude in [mm], every whole Pa:\n");
+	printf("%-16s","ratio range");
+	for (b=0;b<3;b++)
+		printf("  p0=%-8.0f",baselines[b]);
+	printf("\n");
+	for (r=0;r<3;r++)
+	{
+		printf("%4.2f - %-9.2f",ranges[r][0],ranges[r][1]);
+		for (b=0;b<3;b++)
+			printf("  %11.3f",bench_altitudeError(baselines[b],ranges[r][0],ranges[r][1])*1000);
+		printf("\n");
+	}
+
+	for (i=0;i<BENCH_ALTITUDE_COUNT;i++)
+		pressure[i] = 30000 + (i * 7919L) % 80000;
+
+	BMP085_approximateAltitudeBatch(pressure,altitude,BENCH_ALTITUDE_COUNT,101325);
+	for (i=0;i<BENCH_ALTITUDE_COUNT;i++)
+		if (altitude[i] != BMP085_approximateAltitude(pressure[i],101325))
+		{
+			printf("batch mismatch at %d: %f != %f\n",i,altitude[i],BMP085_approximateAltitude(pressure[i],101325));
+			return 1;
+		}
+
+	for (n=0;n<4;n++)
+	{
+		sum = 0;
+		begin = tNow();
+		for (r=0;r<rounds;r++)
+		{
+			switch (n)
+			{
+				case 0:
+					for (i=0;i<BENCH_ALTITUDE_COUNT;i++)
+						sum += BMP085_Altitude(pressure[i],101325);
+					break;
+				case 1:
+					for (i=0;i<BENCH_ALTITUDE_COUNT;i++)
+						sum += BMP085_calculateAltitude(pressure[i],101325);
+					break;
+				case 2:
+					for (i=0;i<BENCH_ALTITUDE_COUNT;i++)
+						sum += BMP085_approximateAltitude(pressure[i],101325);
+					break;
+				default:
+					BMP085_approximateAltitudeBatch(pressure,altitude,BENCH_ALTITUDE_COUNT,101325);
+					sum += altitude[r];
+			}
+		}
+		elapsed[n] = tNow() - begin;
+		bench_consume((long)sum);
+	}
+
+	printf("\nbatch matches scalar approximation for %d pressures (%s)\n",BENCH_ALTITUDE_COUNT,BMP085_batchImplementation());
+	printf("%-36s %12s %10s\n","function","M conv/s","speedup");
+	printf("%-36s %12.1f %9.2fx\n","BMP085_Altitude (int metres)",rounds*(double)BENCH_ALTITUDE_COUNT/elapsed[0]*1e3,1.0);
+	printf("%-36s %12.1f %9.2fx\n","BMP085_calculateAltitude",rounds*(double)BENCH_ALTITUDE_COUNT/elapsed[1]*1e3,(double)elapsed[0]/elapsed[1]);
+	printf("%-36s %12.1f %9.2fx\n","BMP085_approximateAltitude",rounds*(double)BENCH_ALTITUDE_COUNT/elapsed[2]*1e3,(double)elapsed[0]/elapsed[2]);
+	printf("%-36s %12.1f %9.2fx\n","BMP085_approximateAltitudeBatch",rounds*(double)BENCH_ALTITUDE_COUNT/elapsed[3]*1e3,(double)elapsed[0]/elapsed[3]);
+
+	free(pressure);
+	free(altitude);
+	return 0;
+}
@@ -0,0 +1,265 @@
+/*
+ * BMP085 library
+ * bench/bench_arbiter.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Samples four simulated sensors on one simulated 100 kHz bus from four
+ * threads and from four processes. The bus splits every transaction into
+ * the steps of the i2c-dev fallback (I2C_SLAVE, write(), read()) with a
+ * shared slave address, so unarbitrated users reach the wrong sensor.
+ * Reports the measurement rate, the wrong or failed measurements and the
+ * contention counters without arbitration, with one lock held for whole
+ * measurements and with the arbiter, which holds the bus per transaction.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085arbiter.h"
+
+#define BENCH_ARBITER_SENSORS 4
+#define BENCH_ARBITER_BYTE_TIME 90000L
+
+/* State shared by the users, in shared memory for the processes. */
+typedef struct
+{
+	BMP085SimBus bus;
+	BMP085Sim sim[BENCH_ARBITER_SENSORS];
+	long expected[BENCH_ARBITER_SENSORS];	/* Pressure read by a single user in [Pa]. */
+	unsigned long wrong[BENCH_ARBITER_SENSORS];
+	unsigned long transactions[BENCH_ARBITER_SENSORS];
+	unsigned long contended[BENCH_ARBITER_SENSORS];
+	long long waitTime[BENCH_ARBITER_SENSORS];
+	long long maxWait[BENCH_ARBITER_SENSORS];
+} bench_arbiterShared;
+
+typedef struct
+{
+	bench_arbiterShared *shared;
+	int index;
+	const I2CBusOps *busOps;
+	void *busContext;
+	pthread_mutex_t *measurementLock;	/* Held for whole measurements, NULL otherwise. */
+} bench_arbiterUser;
+
+static int bench_arbiterSetup(bench_arbiterShared *shared)
+{
+	BMP085 sensor;
+	int i;
+
+	memset(shared,0,sizeof(bench_arbiterShared));
+	BMP085SimBus_init(&(shared->bus),BENCH_ARBITER_BYTE_TIME);
+	shared->bus.splitTransactions = 1;
+	for (i=0;i<BENCH_ARBITER_SENSORS;i++)
+	{
+		BMP085Sim_init(&(shared->sim[i]),0x70 + i);
+		BMP085Sim_setEnvironment(&(shared->sim[i]),150,69964 + 500*i);
+		BMP085SimBus_attach(&(shared->bus),&(shared->sim[i]));
+		if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&(shared->sim[i]),0x70 + i,ultraLowPower) || BMP085_takeMeasurement(&sensor))
+			return 1;
+		shared->expected[i] = sensor.pressure;
+	}
+	return 0;
+}
+
+/* Initializes the sensor of a user and counts the measurements that fail or return the data of another sensor. */
+static void *bench_arbiterRun(void *context)
+{
+	bench_arbiterUser *user = (bench_arbiterUser *)context;
+	bench_arbiterShared *shared = user->shared;
+	BMP085 sensor;
+	int i, n = bench_samples * 3, result;
+
+	if (BMP085_initSensorOnBus(&sensor,user->busOps,user->busContext,0x70 + user->index,ultraLowPower))
+	{
+		shared->wrong[user->index] = n;
+		return NULL;
+	}
+	for (i=0;i<n;i++)
+	{
+		if (user->measurementLock)
+			pthread_mutex_lock(user->measurementLock);
+		result = BMP085_takeMeasurement(&sensor);
+		if (user->measurementLock)
+			pthread_mutex_unlock(user->measurementLock);
+		if (result || sensor.pressure != shared->expected[user->index])
+			shared->wrong[user->index]++;
+	}
+	return NULL;
+}
+
+static void bench_arbiterCopyCounters(bench_arbiterShared *shared,int index,const BMP085Arbiter *arbiter)
+{
+	shared->transactions[index] = arbiter->transactions;
+	shared->contended[index] = arbiter->contended;
+	shared->waitTime[index] = arbiter->waitTime;
+	shared->maxWait[index] = arbiter->maxWait;
+}
+
+static unsigned long bench_arbiterWrong(const bench_arbiterShared *shared)
+{
+	unsigned long wrong = 0;
+	int i;
+
+	for (i=0;i<BENCH_ARBITER_SENSORS;i++)
+		wrong += shared->wrong[i];
+	return wrong;
+}
+
+static void bench_arbiterPrint(const char *name,const bench_arbiterShared *shared,long long elapsed)
+{
+	unsigned long wrong = 0, transactions = 0, contended = 0;
+	long long waitTime = 0, maxWait = 0;
+	int i;
+
+	for (i=0;i<BENCH_ARBITER_SENSORS;i++)
+	{
+		wrong += shared->wrong[i];
+		transactions += shared->transactions[i];
+		contended += shared->contended[i];
+		waitTime += shared->waitTime[i];
+		if (shared->maxWait[i] > maxWait)
+			maxWait = shared->maxWait[i];
+	}
+	printf("%-36s %9.1f %7lu %10.1f %9.1f %9.1f\n",name,BENCH_ARBITER_SENSORS*bench_samples*3/(elapsed/1e9),wrong,
+		transactions ? 100.0*contended/transactions : 0.0,contended ? waitTime/1e3/contended : 0.0,maxWait/1e3);
+}
+
+/* Runs one user per sensor in threads of this process. */
+static int bench_arbiterThreads(const char *name,bench_arbiterShared *shared,int arbitrated,int wholeMeasurement)
+{
+	pthread_t threads[BENCH_ARBITER_SENSORS];
+	bench_arbiterUser users[BENCH_ARBITER_SENSORS];
+	pthread_mutex_t measurementLock = PTHREAD_MUTEX_INITIALIZER;
+	BMP085Arbiter arbiter;
+	long long begin;
+	int i;
+
+	if (bench_arbiterSetup(shared))
+		return 1;
+	if (arbitrated && BMP085Arbiter_init(&arbiter,&BMP085SimBus_busOps,&(shared->bus),NULL))
+		return 1;
+
+	begin = tNow();
+	for (i=0;i<BENCH_ARBITER_SENSORS;i++)
+	{
+		users[i].shared = shared;
+		users[i].index = i;
+		users[i].busOps = arbitrated ? &BMP085Arbiter_busOps : &BMP085SimBus_busOps;
+		users[i].busContext = arbitrated ? (void *)&arbiter : (void *)&(shared->bus);
+		users[i].measurementLock = wholeMeasurement ? &measurementLock : NULL;
+		if (pthread_create(&threads[i],NULL,bench_arbiterRun,&users[i]))
+			return 1;
+	}
+	for (i=0;i<BENCH_ARBITER_SENSORS;i++)
+		pthread_join(threads[i],NULL);
+
+	if (arbitrated)
+	{
+		bench_arbiterCopyCounters(shared,0,&arbiter);
+		BMP085Arbiter_destroy(&arbiter);
+	}
+	bench_arbiterPrint(name,shared,tNow() - begin);
+	return 0;
+}
+
+/* Runs one user per sensor in child processes, each with its own arbiter on the lock file. */
+static int bench_arbiterProcesses(const char *name,bench_arbiterShared *shared,const char *lockPath)
+{
+	bench_arbiterUser user;
+	BMP085Arbiter arbiter;
+	long long begin;
+	pid_t children[BENCH_ARBITER_SENSORS];
+	int i, status, result = 0;
+
+	if (bench_arbiterSetup(shared))
+		return 1;
+	begin = tNow();
+	for (i=0;i<BENCH_ARBITER_SENSORS;i++)
+	{
+		children[i] = fork();
+		if (children[i] < 0)
+			return 1;
+		if (children[i])
+			continue;
+
+		user.shared = shared;
+		user.index = i;
+		user.measurementLock = NULL;
+		user.busOps = &BMP085SimBus_busOps;
+		user.busContext = &(shared->bus);
+		if (lockPath)
+		{
+			if (BMP085Arbiter_init(&arbiter,&BMP085SimBus_busOps,&(shared->bus),lockPath))
+				_exit(1);
+			user.busOps = &BMP085Arbiter_busOps;
+			user.busContext = &arbiter;
+		}
+		bench_arbiterRun(&user);
+		if (lockPath)
+		{
+			bench_arbiterCopyCounters(shared,i,&arbiter);
+			BMP085Arbiter_destroy(&arbiter);
+		}
+		_exit(0);
+	}
+	for (i=0;i<BENCH_ARBITER_SENSORS;i++)
+		if (waitpid(children[i],&status,0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status))
+			result = 1;
+
+	bench_arbiterPrint(name,shared,tNow() - begin);
+	return result;
+}
+
+int bench_arbiter(void)
+{
+	char lockPath[] = "/tmp/bmp085lockXXXXXX";
+	bench_arbiterShared *shared;
+	unsigned long wrong;
+	int fd, result = 0;
+
+	shared = mmap(NULL,sizeof(bench_arbiterShared),PROT_READ|PROT_WRITE,MAP_SHARED|MAP_ANONYMOUS,-1,0);
+	if (shared == MAP_FAILED)
+		return 1;
+	fd = mkstemp(lockPath);
+	if (fd < 0)
+	{
+		munmap(shared,sizeof(bench_arbiterShared));
+		return 1;
+	}
+	close(fd);
+
+	printf("%d sensors on one bus, %ld ns per bus byte, split i2c-dev transactions, %d measurements per sensor\n",
+		BENCH_ARBITER_SENSORS,BENCH_ARBITER_BYTE_TIME,bench_samples*3);
+	printf("%-36s %9s %7s %10s %9s %9s\n","users","meas/s","wrong","contended%","wait us","max us");
+
+	// Only the arbitrated users must get the data of their own sensor.
+	result |= bench_arbiterThreads("threads, no arbitration",shared,0,0);
+	result |= bench_arbiterThreads("threads, lock per measurement",shared,0,1);
+	wrong = bench_arbiterWrong(shared);
+	result |= bench_arbiterThreads("threads, arbiter",shared,1,0);
+	wrong += bench_arbiterWrong(shared);
+	result |= bench_arbiterProcesses("processes, no arbitration",shared,NULL);
+	result |= bench_arbiterProcesses("processes, arbiter with lock file",shared,lockPath);
+	wrong += bench_arbiterWrong(shared);
+	if (wrong)
+	{
+		printf("%lu wrong measurements with arbitration\n",wrong);
+		result = 1;
+	}
+
+	unlink(lockPath);
+	munmap(shared,sizeof(bench_arbiterShared));
+	return result;
+}
@@ -0,0 +1,112 @@
+/*
+ * BMP085 library
+ * bench/bench_batch.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Compares the throughput of the scalar and the dispatched batch
+ * compensation and checks that both give identical results, both for
+ * realistic raw values and for raw values spread over the whole input range.
+ * Also reports the kernel dispatched in every mode, scalar where the vector
+ * kernel was slower on this processor.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085batch.h"
+
+#define BENCH_BATCH_SIZE 65536
+#define BENCH_BATCH_ROUNDS 64
+
+typedef void (*bench_batchFunction)(const BMP085Calibration *,overSampling,
+	const uint16_t *,const uint32_t *,int32_t *,int32_t *,size_t);
+
+static double bench_batchRate(bench_batchFunction compensate,const BMP085Calibration *calibration,overSampling oss,
+	const uint16_t *ut,const uint32_t *up,int32_t *temperature,int32_t *pressure)
+{
+	long long begin, end;
+	int round;
+
+	begin = tNow();
+	for (round=0;round<BENCH_BATCH_ROUNDS;round++)
+		compensate(calibration,oss,ut,up,temperature,pressure,BENCH_BATCH_SIZE);
+	end = tNow();
+	bench_consume(pressure[BENCH_BATCH_SIZE-1]);
+
+	return (double)BENCH_BATCH_SIZE*BENCH_BATCH_ROUNDS*1e3/(end-begin);
+}
+
+int bench_batch(void)
+{
+	BMP085Sim sim;
+	BMP085Calibration calibration;
+	uint16_t *ut = malloc(BENCH_BATCH_SIZE*sizeof(uint16_t));
+	uint32_t *up = malloc(BENCH_BATCH_SIZE*sizeof(uint32_t));
+	int32_t *temperature = malloc(BENCH_BATCH_SIZE*sizeof(int32_t));
+	int32_t *pressure = malloc(BENCH_BATCH_SIZE*sizeof(int32_t));
+	int32_t *referenceTemperature = malloc(BENCH_BATCH_SIZE*sizeof(int32_t));
+	int32_t *referencePressure = malloc(BENCH_BATCH_SIZE*sizeof(int32_t));
+	unsigned long seed = 1;
+	double scalar, vector;
+	int oss, range, i, result = 1;
+
+	BMP085Sim_init(&sim,0x77);
+	if (!ut || !up || !temperature || !pressure || !referenceTemperature || !referencePressure ||
+		BMP085_decodeCalibration(&calibration,&(sim.registers[BMP085_CALIBRATION_TABLE])))
+		goto out;
+
+	printf("kernel: %s\n",BMP085_batchImplementation());
+	printf("%-20s %-10s %14s %14s %8s %10s\n","mode","inputs","scalar Ms/s","batch Ms/s","speedup","dispatched");
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		for (range=0;range<2;range++)
+		{
+			for (i=0;i<BENCH_BATCH_SIZE;i++)
+			{
+				seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+				if (range == 0)
+				{
+					// Raw values around the datasheet example.
+					ut[i] = 25000 + (seed >> 33) % 6000;
+					up[i] = (20000L << oss) + (seed >> 17) % (20000L << oss);
+				}
+				else
+				{
+					ut[i] = seed >> 48;
+					up[i] = (seed >> 20) & ((0x10000L << oss) - 1);
+				}
+			}
+
+			BMP085_compensateBatchScalar(&calibration,oss,ut,up,referenceTemperature,referencePressure,BENCH_BATCH_SIZE);
+			BMP085_compensateBatch(&calibration,oss,ut,up,temperature,pressure,BENCH_BATCH_SIZE);
+			if (memcmp(temperature,referenceTemperature,BENCH_BATCH_SIZE*sizeof(int32_t)) ||
+				memcmp(pressure,referencePressure,BENCH_BATCH_SIZE*sizeof(int32_t)))
+			{
+				printf("Vectorized results differ from the scalar results (%s).\n",bench_ossName[oss]);
+				goto out;
+			}
+
+			scalar = bench_batchRate(BMP085_compensateBatchScalar,&calibration,oss,ut,up,temperature,pressure);
+			vector = bench_batchRate(BMP085_compensateBatch,&calibration,oss,ut,up,temperature,pressure);
+			printf("%-20s %-10s %14.1f %14.1f %7.2fx %10s\n",bench_ossName[oss],range ? "full" : "realistic",scalar,vector,vector/scalar,
+				BMP085_batchModeImplementation(oss));
+		}
+	}
+	result = 0;
+
+out:
+	free(ut);
+	free(up);
+	free(temperature);
+	free(pressure);
+	free(referenceTemperature);
+	free(referencePressure);
+	return result;
+}
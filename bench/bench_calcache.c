@@ -0,0 +1,104 @@
+/*
+ * BMP085 library
+ * bench/bench_calcache.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Initializes a fleet of simulated sensors on a slow simulated bus with
+ * an empty calibration cache, then again with the saved cache, then with
+ * one sensor replaced and with a damaged cache file, and reports the
+ * startup times, the hits and misses and the time saved by the cache.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085calcache.h"
+
+#define BENCH_CALCACHE_SENSORS 8
+#define BENCH_CALCACHE_BYTE_TIME 900000L	/* 9 clocks per byte at 10 kHz */
+
+/* Initializes every sensor of the bus through the cache loaded from path and saves the cache. */
+static int bench_calcacheStartup(const char *label,const char *path,BMP085SimBus *bus,BMP085 *sensor)
+{
+	BMP085CalCache cache;
+	long long begin, startup;
+	int i, result = 1;
+
+	begin = tNow();
+	if (BMP085CalCache_load(&cache,path))
+		goto done;
+	for (i=0;i<bus->deviceCount;i++)
+		if (BMP085CalCache_initSensorOnBus(&cache,"sim-10k",&sensor[i],&BMP085SimBus_busOps,bus,bus->devices[i]->I2CAddress,standard) ||
+			memcmp(sensor[i].calibrationCoeficients,&(bus->devices[i]->registers[BMP085_CALIBRATION_TABLE]),22))
+			goto done;
+	if (BMP085CalCache_save(&cache,path))
+		goto done;
+	startup = tNow() - begin;
+
+	printf("%-24s %10.1f %6lu %6lu %6lu %8lu %12.1f\n",label,startup/1e6,cache.hits,cache.misses,cache.stale,cache.dropped,cache.savedTime/1e6);
+	result = 0;
+
+done:
+	BMP085CalCache_destroy(&cache);
+	return result;
+}
+
+int bench_calcache(void)
+{
+	char path[] = "/tmp/bmp085calXXXXXX";
+	BMP085Sim sim[BENCH_CALCACHE_SENSORS];
+	BMP085SimBus bus;
+	BMP085 sensor[BENCH_CALCACHE_SENSORS];
+	unsigned char byte;
+	int fd, i, result = 1;
+
+	BMP085SimBus_init(&bus,BENCH_CALCACHE_BYTE_TIME);
+	for (i=0;i<BENCH_CALCACHE_SENSORS;i++)
+	{
+		BMP085Sim_init(&sim[i],0x77 - i);
+		// Every part has its own coefficients.
+		sim[i].registers[BMP085_CALIBRATION_TABLE + 1] += i;
+		BMP085SimBus_attach(&bus,&sim[i]);
+	}
+	fd = mkstemp(path);
+	if (fd < 0)
+		return 1;
+	close(fd);
+	unlink(path);
+
+	printf("%d sensors on one bus, %ld ns per bus byte\n",BENCH_CALCACHE_SENSORS,BENCH_CALCACHE_BYTE_TIME);
+	printf("%-24s %10s %6s %6s %6s %8s %12s\n","startup","ms","hits","misses","stale","dropped","saved ms");
+	if (bench_calcacheStartup("no cache file",path,&bus,sensor) ||
+		bench_calcacheStartup("cached",path,&bus,sensor))
+		goto done;
+
+	// A replaced sensor has other coefficients at the same address.
+	sim[3].registers[BMP085_CALIBRATION_TABLE] ^= 0x10;
+	if (bench_calcacheStartup("one sensor replaced",path,&bus,sensor))
+		goto done;
+
+	// A flipped bit in the table of the first entry.
+	fd = open(path,O_RDWR);
+	if (fd < 0 || pread(fd,&byte,1,sizeof(BMP085CalCacheHeader) + 50) != 1)
+		goto done;
+	byte ^= 0x01;
+	if (pwrite(fd,&byte,1,sizeof(BMP085CalCacheHeader) + 50) != 1 || close(fd))
+		goto done;
+	if (bench_calcacheStartup("damaged cache file",path,&bus,sensor) ||
+		bench_calcacheStartup("cached",path,&bus,sensor))
+		goto done;
+	result = 0;
+
+done:
+	unlink(path);
+	return result;
+}
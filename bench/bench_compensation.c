@@ -0,0 +1,75 @@
+/*
+ * BMP085 library
+ * bench/bench_compensation.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Measures the cost of decoding the calibration table and of the pure
+ * compensation functions, without any bus access.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "bmp085sim.h"
+
+#define BENCH_ITERATIONS 4000000L
+
+int bench_compensation(void)
+{
+	BMP085Sim sim;
+	BMP085Calibration calibration;
+	long long begin, end;
+	char name[64];
+	long i, sum = 0;
+	int32_t b5;
+	int oss;
+
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_decodeCalibration(&calibration,&(sim.registers[BMP085_CALIBRATION_TABLE])))
+		return 1;
+
+	// Datasheet example: UT = 27898, UP = 23843 with oss = 0 gives 15.0 C and 69964 Pa.
+	if (BMP085_calculateTemperature(&calibration,27898,&b5) != 150 ||
+		BMP085_calculatePressure(&calibration,ultraLowPower,23843,b5) != 69964)
+	{
+		printf("Compensation does not match the datasheet example.\n");
+		return 1;
+	}
+
+	begin = tNow();
+	for (i=0;i<BENCH_ITERATIONS;i++)
+	{
+		sim.registers[BMP085_CALIBRATION_TABLE+21] = 0x34 + (i & 1);
+		sum += BMP085_decodeCalibration(&calibration,&(sim.registers[BMP085_CALIBRATION_TABLE]));
+	}
+	end = tNow();
+	bench_consume(sum);
+	printf("%-40s %8.2f ns\n","decode calibration",(double)(end-begin)/BENCH_ITERATIONS);
+
+	begin = tNow();
+	for (i=0;i<BENCH_ITERATIONS;i++)
+		sum += BMP085_calculateTemperature(&calibration,27000 + (i & 0x7FF),&b5);
+	end = tNow();
+	bench_consume(sum);
+	printf("%-40s %8.2f ns\n","temperature",(double)(end-begin)/BENCH_ITERATIONS);
+
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		begin = tNow();
+		for (i=0;i<BENCH_ITERATIONS;i++)
+		{
+			BMP085_calculateTemperature(&calibration,27000 + (i & 0x7FF),&b5);
+			sum += BMP085_calculatePressure(&calibration,oss,(23843L << oss) + (i & 0xFFF),b5);
+		}
+		end = tNow();
+		bench_consume(sum);
+		snprintf(name,sizeof(name),"temperature+pressure %s",bench_ossName[oss]);
+		printf("%-40s %8.2f ns\n",name,(double)(end-begin)/BENCH_ITERATIONS);
+	}
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * BMP085 library
+ * bench/bench_cpp.cpp
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Compares the C++ interface from libbmp085.hpp with the C functions:
+ * the pressure compensation specialized on the over sampling mode against
+ * BMP085_calculatePressure(), checked for identical results, and
+ * Sensor::measure() against BMP085_takeMeasurement() on the simulated
+ * sensor. Heap allocations made while measuring are counted through the
+ * global operator new. Also checks that Sensor::measure() leaves the sample
+ * state of the C structure current for the C helpers.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "libbmp085.hpp"
+
+#define BENCH_CPP_ITERATIONS 4000000L
+
+static unsigned long bench_allocations;
+
+void *operator new(std::size_t size)
+{
+	void *p;
+
+	bench_allocations++;
+	p = std::malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p,std::size_t) noexcept
+{
+	std::free(p);
+}
+
+/* Compensation of one mode, C against the specialized C++ template. */
+template <overSampling OSS>
+static int bench_cppCompensation(const BMP085Calibration *c,const libbmp085::Calibration &cpp,int32_t b5)
+{
+	long long begin, cTime, cppTime;
+	long i, cSum = 0, cppSum = 0;
+	int32_t raw;
+
+	begin = tNow();
+	for (i=0;i<BENCH_CPP_ITERATIONS;i++)
+	{
+		raw = (20000 + (i & 0x3FFF)) << OSS;
+		cSum += BMP085_calculatePressure(c,OSS,raw,b5 + (i & 0xFF));
+	}
+	cTime = tNow() - begin;
+
+	begin = tNow();
+	for (i=0;i<BENCH_CPP_ITERATIONS;i++)
+	{
+		raw = (20000 + (i & 0x3FFF)) << OSS;
+		cppSum += libbmp085::calculatePressure<OSS>(cpp,raw,b5 + (i & 0xFF));
+	}
+	cppTime = tNow() - begin;
+	bench_consume(cSum + cppSum);
+
+	for (i=0;i<0x4000;i++)
+		if (BMP085_calculatePressure(c,OSS,(20000 + i) << OSS,b5 + (i & 0xFF)) !=
+			libbmp085::calculatePressure<OSS>(cpp,(20000 + i) << OSS,b5 + (i & 0xFF)))
+		{
+			std::printf("%s: C++ compensation differs from C at raw %ld\n",bench_ossName[OSS],20000 + i);
+			return 1;
+		}
+
+	std::printf("%-20s %12.2f %12.2f\n",bench_ossName[OSS],(double)cTime/BENCH_CPP_ITERATIONS,(double)cppTime/BENCH_CPP_ITERATIONS);
+	return 0;
+}
+
+extern "C" int bench_cpp(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	long long begin, cTime, cppTime;
+	unsigned long allocations, transactions;
+	int32_t b5;
+	int i;
+
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,ultraLowPower))
+		return 1;
+	const libbmp085::Calibration calibration = libbmp085::Calibration::fromTable(sensor.calibrationCoeficients);
+	BMP085_calculateTemperature(&(sensor.calibration),27898,&b5);
+
+	std::printf("%-20s %12s %12s\n","mode","C ns","C++ ns");
+	if (bench_cppCompensation<ultraLowPower>(&(sensor.calibration),calibration,b5) ||
+		bench_cppCompensation<standard>(&(sensor.calibration),calibration,b5) ||
+		bench_cppCompensation<highResolution>(&(sensor.calibration),calibration,b5) ||
+		bench_cppCompensation<ultraHighResolution>(&(sensor.calibration),calibration,b5))
+		return 1;
+
+	// Whole measurements on the simulated sensor, C state machine against the C++ sensor.
+	BMP085Sim_resetCounters(&sim);
+	begin = tNow();
+	for (i=0;i<bench_samples;i++)
+		if (BMP085_takeMeasurement(&sensor))
+			return 1;
+	cTime = tNow() - begin;
+	transactions = sim.reads + sim.writes;
+
+	try
+	{
+		libbmp085::Sensor<ultraLowPower> cppSensor(BMP085Sim_busOps,&sim,0x77);
+
+		BMP085Sim_resetCounters(&sim);
+		allocations = bench_allocations;
+		begin = tNow();
+		for (i=0;i<bench_samples;i++)
+			if (cppSensor.measure())
+				return 1;
+		cppTime = tNow() - begin;
+		allocations = bench_allocations - allocations;
+
+		if (cppSensor.pressure() != sensor.pressure)
+			return 1;
+		const BMP085 &state = cppSensor.raw();
+		if (!state.temperatureValid || state.conversionOss != ultraLowPower || state.conversionStart < begin ||
+			state.temperatureTime < begin || state.temperatureTime > state.conversionStart)
+		{
+			std::printf("Sensor::measure() left a stale sample state\n");
+			return 1;
+		}
+	}
+	catch (const std::system_error &error)
+	{
+		std::printf("%s\n",error.what());
+		return 1;
+	}
+
+	std::printf("measurement, ultraLowPower: C %.3f ms (%.1f transactions), C++ %.3f ms (%.1f transactions), %lu allocations\n",
+		cTime/1e6/bench_samples,(double)transactions/bench_samples,cppTime/1e6/bench_samples,
+		(double)(sim.reads + sim.writes)/bench_samples,allocations);
+
+	return allocations ? 1 : 0;
+}
@@ -0,0 +1,391 @@
+/*
+ * BMP085 library
+ * bench/bench_exhaustive.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Sweeps the raw input space of the compensation for every over sampling
+ * mode on all processors and compares the library against a reference
+ * implementation of the datasheet algorithm in 128-bit arithmetic:
+ * BMP085_calculateTemperature/BMP085_calculatePressure and the batch
+ * compensation must match it wherever the datasheet result is defined, and
+ * the batch compensation must match the scalar one everywhere. A
+ * transcription with a 32-bit long, as the datasheet code compiles on 32-bit
+ * targets, shows where the integer types of the datasheet overflow. Reports
+ * the CPU time per sample of every implementation.
+ *
+ * Every raw pressure (UP) value is used. By default 65 raw temperature (UT)
+ * values spread over the whole range are used, with -x all 65536 of them
+ * (about an hour of CPU time per calibration table).
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085batch.h"
+
+#define BENCH_EXHAUSTIVE_SAMPLED 65	/* UT values without -x. */
+#define BENCH_EXHAUSTIVE_CHUNK 8192	/* UP values compensated in one pass of every implementation. */
+#define BENCH_EXHAUSTIVE_MAX_THREADS 64
+
+/* Flags of a reference result. */
+#define BENCH_UNDEFINED 1	/* UP below B3, B4 or X1+MD zero, or a pressure outside int32_t. */
+#define BENCH_OVERFLOW32 2	/* An intermediate does not fit the 32-bit long or unsigned long of the datasheet. */
+#define BENCH_OVERFLOW64 4	/* An intermediate does not fit the 64-bit integers of the library. */
+
+/* Implementations in the order of the reported times. */
+enum { benchReference = 0, benchLibrary, benchBatch, benchNarrow, benchImplementations };
+
+static const char *bench_exhaustiveName[] = { "reference (128-bit)", "library", "batch", "32-bit long" };
+
+typedef __int128 bench_wide;
+
+typedef struct
+{
+	unsigned long long samples, undefined, overflow32, overflow64;
+	unsigned long long library, batch, narrow;	/* Mismatches. */
+} bench_exhaustiveCount;
+
+typedef struct
+{
+	const BMP085Calibration *calibration;
+	unsigned int utCount;
+	unsigned int *next;	/* Index of the next UT value, shared by the workers. */
+	bench_exhaustiveCount count[4];
+	long long time[benchImplementations];
+	char example[160];	/* First mismatch of the library or the batch compensation. */
+} bench_exhaustiveWorker;
+
+static const struct
+{
+	const char *name;
+	unsigned char table[22];
+} bench_exhaustiveTables[] = {
+	// Example of the Bosch datasheet, also used by the simulated sensor.
+	{ "datasheet", { 0x01,0x98, 0xFF,0xB8, 0xC7,0xD1, 0x7F,0xE5, 0x7F,0xF5, 0x5A,0x71, 0x18,0x2E, 0x00,0x04, 0x80,0x00, 0xDD,0xF9, 0x0B,0x34 } },
+	// Valid coefficients at the ends of their ranges.
+	{ "extreme", { 0x80,0x01, 0x80,0x01, 0x80,0x01, 0xFF,0xFE, 0xFF,0xFE, 0x00,0x01, 0x7F,0xFF, 0x7F,0xFF, 0x80,0x01, 0x80,0x01, 0x7F,0xFF } },
+};
+
+#define BENCH_EXHAUSTIVE_TABLES (int)(sizeof(bench_exhaustiveTables)/sizeof(bench_exhaustiveTables[0]))
+
+/* Sets the overflow flags for a value that has to fit a signed long. */
+static inline int bench_exhaustiveSigned(bench_wide value)
+{
+	return (value < INT32_MIN || value > INT32_MAX ? BENCH_OVERFLOW32 : 0) | (value < INT64_MIN || value > INT64_MAX ? BENCH_OVERFLOW64 : 0);
+}
+
+/* Sets the overflow flags for a value that has to fit an unsigned long. */
+static inline int bench_exhaustiveUnsigned(bench_wide value)
+{
+	return (value < 0 || value > UINT32_MAX ? BENCH_OVERFLOW32 : 0) | (value < 0 || value > (bench_wide)UINT64_MAX ? BENCH_OVERFLOW64 : 0);
+}
+
+/*
+ * The datasheet algorithm in 128-bit arithmetic, which does not overflow for
+ * any input. The divisions by powers of two are the arithmetic right shifts
+ * of the Bosch driver. Returns the pressure, the temperature and the flags.
+ */
+static int32_t bench_exhaustiveReference(const BMP085Calibration *c,int oss,bench_wide ut,bench_wide up,int32_t *temperature,int *flags)
+{
+	bench_wide x1, x2, x3, b3, b4, b5, b6, b7, p, square;
+	int f;
+
+	x1 = ut - c->ac6;
+	f = bench_exhaustiveSigned(x1 * c->ac5);
+	x1 = (x1 * c->ac5) >> 15;
+	if (x1 + c->md == 0)
+	{
+		*flags = BENCH_UNDEFINED;
+		return 0;
+	}
+	x2 = ((bench_wide)c->mc << 11) / (x1 + c->md);
+	b5 = x1 + x2;
+	f |= bench_exhaustiveSigned(b5 + 8);
+	*temperature = (int32_t)((b5 + 8) >> 4);
+
+	b6 = b5 - 4000;
+	square = b6 * b6;
+	f |= bench_exhaustiveSigned(square) | bench_exhaustiveSigned(c->b2 * (square >> 12)) | bench_exhaustiveSigned(c->ac2 * b6);
+	x1 = (c->b2 * (square >> 12)) >> 11;
+	x2 = (c->ac2 * b6) >> 11;
+	x3 = x1 + x2;
+	f |= bench_exhaustiveSigned(((c->ac1 * 4 + x3) << oss) + 2);
+	b3 = (((c->ac1 * 4 + x3) << oss) + 2) / 4;
+	f |= bench_exhaustiveSigned(c->ac3 * b6) | bench_exhaustiveSigned(c->b1 * (square >> 12));
+	x1 = (c->ac3 * b6) >> 13;
+	x2 = (c->b1 * (square >> 12)) >> 16;
+	x3 = ((x1 + x2) + 2) >> 2;
+	f |= bench_exhaustiveUnsigned(x3 + 32768) | bench_exhaustiveUnsigned(c->ac4 * (x3 + 32768));
+	b4 = (c->ac4 * (x3 + 32768)) >> 15;
+	b7 = (up - b3) * (50000 >> oss);
+	f |= bench_exhaustiveUnsigned(up - b3) | bench_exhaustiveUnsigned(b7);
+	if (x3 + 32768 < 0 || b4 == 0 || b7 < 0)
+	{
+		*flags = f | BENCH_UNDEFINED;
+		return 0;
+	}
+	if (b7 < 0x80000000)
+	{
+		f |= bench_exhaustiveUnsigned(b7 * 2);
+		p = (b7 * 2) / b4;
+	}
+	else
+		p = (b7 / b4) * 2;
+	f |= bench_exhaustiveSigned(p) | bench_exhaustiveSigned((p >> 8) * (p >> 8)) | bench_exhaustiveSigned(((p >> 8) * (p >> 8)) * 3038) |
+		bench_exhaustiveSigned(-7357 * p);
+	x1 = (p >> 8) * (p >> 8);
+	x1 = (x1 * 3038) >> 16;
+	x2 = (-7357 * p) >> 16;
+	p += (x1 + x2 + 3791) >> 4;
+	if (p < INT32_MIN || p > INT32_MAX)
+		f |= BENCH_UNDEFINED;
+	*flags = f;
+	return (int32_t)p;
+}
+
+/* Wrapping 32-bit arithmetic; the conversion to int32_t keeps the low 32 bits with gcc. */
+#define BENCH_WRAP(value) ((int32_t)(uint32_t)(value))
+
+/* Signed 32-bit division that wraps instead of trapping, and gives 0 for a zero divisor. */
+static inline int32_t bench_exhaustiveDivide(int32_t dividend,int32_t divisor)
+{
+	if (divisor == 0)
+		return 0;
+	if (divisor == -1)
+		return BENCH_WRAP(0u - (uint32_t)dividend);
+	return dividend / divisor;
+}
+
+/* The datasheet code with a 32-bit long and unsigned long, as it behaves on 32-bit targets. */
+static int32_t bench_exhaustiveNarrow(const BMP085Calibration *c,int oss,int32_t ut,int32_t up,int32_t *temperature)
+{
+	int32_t x1, x2, x3, b3, b5, b6, p;
+	uint32_t b4, b7;
+
+	x1 = BENCH_WRAP((uint32_t)(ut - c->ac6) * c->ac5) >> 15;
+	x2 = bench_exhaustiveDivide(BENCH_WRAP((uint32_t)c->mc << 11),BENCH_WRAP((uint32_t)x1 + (uint32_t)c->md));
+	b5 = BENCH_WRAP((uint32_t)x1 + (uint32_t)x2);
+	*temperature = BENCH_WRAP((uint32_t)b5 + 8) >> 4;
+
+	b6 = BENCH_WRAP((uint32_t)b5 - 4000);
+	x1 = BENCH_WRAP((uint32_t)c->b2 * (uint32_t)(BENCH_WRAP((uint32_t)b6 * (uint32_t)b6) >> 12)) >> 11;
+	x2 = BENCH_WRAP((uint32_t)c->ac2 * (uint32_t)b6) >> 11;
+	x3 = BENCH_WRAP((uint32_t)x1 + (uint32_t)x2);
+	b3 = BENCH_WRAP((((uint32_t)c->ac1 * 4 + (uint32_t)x3) << oss) + 2) / 4;
+	x1 = BENCH_WRAP((uint32_t)c->ac3 * (uint32_t)b6) >> 13;
+	x2 = BENCH_WRAP((uint32_t)c->b1 * (uint32_t)(BENCH_WRAP((uint32_t)b6 * (uint32_t)b6) >> 12)) >> 16;
+	x3 = BENCH_WRAP((uint32_t)x1 + (uint32_t)x2 + 2) >> 2;
+	b4 = (c->ac4 * (uint32_t)(x3 + 32768)) >> 15;
+	b7 = ((uint32_t)up - (uint32_t)b3) * (uint32_t)(50000 >> oss);
+	if (b4 == 0)
+		return 0;
+	if (b7 < 0x80000000)
+		p = BENCH_WRAP((b7 * 2) / b4);
+	else
+		p = BENCH_WRAP((b7 / b4) * 2);
+	x1 = BENCH_WRAP((uint32_t)(p >> 8) * (uint32_t)(p >> 8));
+	x1 = BENCH_WRAP((uint32_t)x1 * 3038) >> 16;
+	x2 = BENCH_WRAP((uint32_t)p * (uint32_t)-7357) >> 16;
+	return BENCH_WRAP((uint32_t)p + (uint32_t)(BENCH_WRAP((uint32_t)x1 + (uint32_t)x2 + 3791) >> 4));
+}
+
+/* CPU time of the calling thread in [ns]. */
+static long long bench_exhaustiveCpu(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID,&now);
+	return (long long)now.tv_sec*1000000000LL+now.tv_nsec;
+}
+
+static void bench_exhaustiveMismatch(bench_exhaustiveWorker *worker,const char *name,int oss,long ut,long up,long expected,long value)
+{
+	if (!worker->example[0])
+		snprintf(worker->example,sizeof(worker->example),"%s, %s: UT %ld UP %ld gives %ld instead of %ld",
+			name,bench_ossName[oss],ut,up,value,expected);
+}
+
+/* Compensates UP values [first, first + count) of one UT in every implementation and compares the results. */
+static void bench_exhaustiveChunk(bench_exhaustiveWorker *worker,int oss,uint16_t ut,uint32_t first,int count)
+{
+	static __thread uint16_t rawTemperature[BENCH_EXHAUSTIVE_CHUNK];
+	static __thread uint32_t rawPressure[BENCH_EXHAUSTIVE_CHUNK];
+	static __thread int32_t reference[BENCH_EXHAUSTIVE_CHUNK], library[BENCH_EXHAUSTIVE_CHUNK], narrow[BENCH_EXHAUSTIVE_CHUNK];
+	static __thread int32_t batchTemperature[BENCH_EXHAUSTIVE_CHUNK], batch[BENCH_EXHAUSTIVE_CHUNK];
+	static __thread unsigned char flags[BENCH_EXHAUSTIVE_CHUNK];
+	const BMP085Calibration *calibration = worker->calibration;
+	bench_exhaustiveCount *counter = &(worker->count[oss]);
+	int32_t referenceTemperature = 0, libraryTemperature = 0, narrowTemperature = 0, b5;
+	long long begin;
+	int i, f;
+
+	for (i=0;i<count;i++)
+	{
+		rawTemperature[i] = ut;
+		rawPressure[i] = first + i;
+	}
+
+	begin = bench_exhaustiveCpu();
+	for (i=0;i<count;i++)
+	{
+		reference[i] = bench_exhaustiveReference(calibration,oss,ut,rawPressure[i],&referenceTemperature,&f);
+		flags[i] = f;
+	}
+	worker->time[benchReference] += bench_exhaustiveCpu() - begin;
+
+	begin = bench_exhaustiveCpu();
+	for (i=0;i<count;i++)
+	{
+		libraryTemperature = BMP085_calculateTemperature(calibration,rawTemperature[i],&b5);
+		library[i] = BMP085_calculatePressure(calibration,oss,rawPressure[i],b5);
+	}
+	worker->time[benchLibrary] += bench_exhaustiveCpu() - begin;
+
+	begin = bench_exhaustiveCpu();
+	BMP085_compensateBatch(calibration,oss,rawTemperature,rawPressure,batchTemperature,batch,count);
+	worker->time[benchBatch] += bench_exhaustiveCpu() - begin;
+
+	begin = bench_exhaustiveCpu();
+	for (i=0;i<count;i++)
+		narrow[i] = bench_exhaustiveNarrow(calibration,oss,rawTemperature[i],rawPressure[i],&narrowTemperature);
+	worker->time[benchNarrow] += bench_exhaustiveCpu() - begin;
+
+	counter->samples += count;
+	for (i=0;i<count;i++)
+	{
+		if (batch[i] != library[i] || batchTemperature[i] != libraryTemperature)
+		{
+			counter->batch++;
+			bench_exhaustiveMismatch(worker,"batch",oss,ut,rawPressure[i],library[i],batch[i]);
+		}
+		if (flags[i] & BENCH_UNDEFINED)
+		{
+			counter->undefined++;
+			continue;
+		}
+		if (flags[i] & BENCH_OVERFLOW32)
+			counter->overflow32++;
+		if (flags[i] & BENCH_OVERFLOW64)
+			counter->overflow64++;
+		if (library[i] != reference[i] || libraryTemperature != referenceTemperature)
+		{
+			counter->library++;
+			bench_exhaustiveMismatch(worker,"library",oss,ut,rawPressure[i],reference[i],library[i]);
+		}
+		if (narrow[i] != reference[i] || narrowTemperature != referenceTemperature)
+			counter->narrow++;
+	}
+}
+
+static void *bench_exhaustiveWork(void *context)
+{
+	bench_exhaustiveWorker *worker = (bench_exhaustiveWorker *)context;
+	unsigned int index;
+	uint32_t first, size;
+	uint16_t ut;
+	int oss;
+
+	while ((index = __atomic_fetch_add(worker->next,1,__ATOMIC_RELAXED)) < worker->utCount)
+	{
+		ut = worker->utCount > 1 ? (uint16_t)((index * 65535UL) / (worker->utCount - 1)) : 0;
+		for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+			for (size=1u<<(16+oss),first=0;first<size;first+=BENCH_EXHAUSTIVE_CHUNK)
+				bench_exhaustiveChunk(worker,oss,ut,first,size - first < BENCH_EXHAUSTIVE_CHUNK ? size - first : BENCH_EXHAUSTIVE_CHUNK);
+	}
+	return NULL;
+}
+
+/* Sweeps the input space with one calibration table on every processor. */
+static int bench_exhaustiveTable(const char *name,const unsigned char *table,int threads)
+{
+	static bench_exhaustiveWorker workers[BENCH_EXHAUSTIVE_MAX_THREADS];
+	pthread_t ids[BENCH_EXHAUSTIVE_MAX_THREADS];
+	BMP085Calibration calibration;
+	bench_exhaustiveCount total[4];
+	long long time[benchImplementations], begin, elapsed;
+	unsigned long long samples = 0;
+	unsigned int next = 0;
+	int i, t, oss, result = 0;
+
+	if (BMP085_decodeCalibration(&calibration,table))
+		return 1;
+
+	begin = tNow();
+	for (t=0;t<threads;t++)
+	{
+		memset(&workers[t],0,sizeof(bench_exhaustiveWorker));
+		workers[t].calibration = &calibration;
+		workers[t].utCount = bench_fullSweep ? 65536 : BENCH_EXHAUSTIVE_SAMPLED;
+		workers[t].next = &next;
+		if (pthread_create(&ids[t],NULL,bench_exhaustiveWork,&workers[t]))
+			return 1;
+	}
+	for (t=0;t<threads;t++)
+		pthread_join(ids[t],NULL);
+	elapsed = tNow() - begin;
+
+	memset(total,0,sizeof(total));
+	memset(time,0,sizeof(time));
+	for (t=0;t<threads;t++)
+	{
+		for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+		{
+			total[oss].samples += workers[t].count[oss].samples;
+			total[oss].undefined += workers[t].count[oss].undefined;
+			total[oss].overflow32 += workers[t].count[oss].overflow32;
+			total[oss].overflow64 += workers[t].count[oss].overflow64;
+			total[oss].library += workers[t].count[oss].library;
+			total[oss].batch += workers[t].count[oss].batch;
+			total[oss].narrow += workers[t].count[oss].narrow;
+		}
+		for (i=0;i<benchImplementations;i++)
+			time[i] += workers[t].time[i];
+		if (workers[t].example[0] && !result)
+		{
+			printf("mismatch: %s\n",workers[t].example);
+			result = 1;
+		}
+	}
+
+	printf("calibration \"%s\", %u UT values, every UP value, %d threads, %.1f s:\n",name,workers[0].utCount,threads,elapsed/1e9);
+	printf("%-20s %12s %12s %12s %10s %10s %10s %12s\n","mode","samples","undefined","ovf 32-bit","ovf 64-bit","library","batch","32-bit long");
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		printf("%-20s %12llu %12llu %12llu %10llu %10llu %10llu %12llu\n",bench_ossName[oss],total[oss].samples,total[oss].undefined,
+			total[oss].overflow32,total[oss].overflow64,total[oss].library,total[oss].batch,total[oss].narrow);
+		samples += total[oss].samples;
+		if (total[oss].library || total[oss].batch || total[oss].overflow64)
+			result = 1;
+	}
+	printf("ns/sample:");
+	for (i=0;i<benchImplementations;i++)
+		printf(" %s %.2f%s",bench_exhaustiveName[i],(double)time[i]/samples,i < benchImplementations - 1 ? "," : "\n");
+
+	return result;
+}
+
+int bench_exhaustive(void)
+{
+	int threads = (int)sysconf(_SC_NPROCESSORS_ONLN), t, result = 0;
+
+	if (threads < 1)
+		threads = 1;
+	if (threads > BENCH_EXHAUSTIVE_MAX_THREADS)
+		threads = BENCH_EXHAUSTIVE_MAX_THREADS;
+
+	puts("mismatches of the library and the 32-bit long code against the reference where the datasheet result is defined,");
+	puts("of the batch compensation against the library for every input; overflows are counted where the result is defined");
+	for (t=0;t<BENCH_EXHAUSTIVE_TABLES;t++)
+		result |= bench_exhaustiveTable(bench_exhaustiveTables[t].name,bench_exhaustiveTables[t].table,threads);
+	return result;
+}
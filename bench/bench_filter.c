@@ -0,0 +1,150 @@
+/*
+ * BMP085 library
+ * bench/bench_filter.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Filters ultraLowPower pressure samples of the simulated sensor, with the
+ * datasheet noise of every mode, through several filter configurations.
+ * Reports the output noise against the raw noise of every hardware mode,
+ * the output rate, the theoretical and measured (50 % step response)
+ * latency and the processing cost per sample.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085filter.h"
+
+#define BENCH_SETTLE 200
+#define BENCH_STEP 100
+
+typedef struct
+{
+	const char *name;
+	unsigned int decimation;
+	filterType types[BMP085FILTER_MAX_STAGES];
+	unsigned int lengths[BMP085FILTER_MAX_STAGES];
+	unsigned int stageCount;
+} bench_filterConfig;
+
+static const bench_filterConfig bench_filterConfigs[] = {
+	{ "none", 1, {0}, {0}, 0 },
+	{ "average 4", 1, { filterMovingAverage }, { 4 }, 1 },
+	{ "average 8", 1, { filterMovingAverage }, { 8 }, 1 },
+	{ "average 16 / 4", 4, { filterMovingAverage }, { 16 }, 1 },
+	{ "IIR 1/4", 1, { filterIIR }, { 2 }, 1 },
+	{ "IIR 1/8", 1, { filterIIR }, { 3 }, 1 },
+	{ "median 5", 1, { filterMedian }, { 5 }, 1 },
+	{ "median 5 + avg 4", 1, { filterMedian, filterMovingAverage }, { 5, 4 }, 2 },
+	{ "avg 4 + IIR 1/4", 1, { filterMovingAverage, filterIIR }, { 4, 2 }, 2 },
+};
+
+#define BENCH_FILTER_CONFIGS (int)(sizeof(bench_filterConfigs)/sizeof(bench_filterConfigs[0]))
+
+static int bench_filterSetup(BMP085Filter *filter,const bench_filterConfig *config)
+{
+	unsigned int i;
+	int result = BMP085Filter_init(filter,config->decimation);
+
+	for (i=0;i<config->stageCount;i++)
+	{
+		if (config->types[i] == filterMovingAverage)
+			result |= BMP085Filter_addMovingAverage(filter,config->lengths[i]);
+		else if (config->types[i] == filterIIR)
+			result |= BMP085Filter_addIIR(filter,config->lengths[i]);
+		else
+			result |= BMP085Filter_addMedian(filter,config->lengths[i]);
+	}
+	return result;
+}
+
+/* Standard deviation of the samples after the settling period. */
+static double bench_filterDeviation(const double *values,int count)
+{
+	double sum = 0, sumSquares = 0, mean;
+	int i;
+
+	for (i=0;i<count;i++)
+	{
+		sum += values[i];
+		sumSquares += values[i]*values[i];
+	}
+	mean = sum/count;
+	return sqrt(sumSquares/count - mean*mean);
+}
+
+int bench_filter(void)
+{
+	int count = bench_samples * 500, c, i, n, step;
+	int32_t pressure[count], output, b5;
+	double values[count];
+	BMP085Calibration calibration;
+	BMP085Filter filter;
+	BMP085Sim sim;
+	uint16_t ut;
+	uint32_t up;
+	long long begin, elapsed;
+	double period = BMP085_PressureConversionTime[ultraLowPower]/1e6, noise[ultraHighResolution + 1];
+
+	BMP085Sim_init(&sim,0x77);
+	sim.datasheetNoise = 1;
+	if (BMP085_decodeCalibration(&calibration,&(sim.registers[BMP085_CALIBRATION_TABLE])))
+		return 1;
+
+	printf("raw noise of the simulated sensor, %d samples per mode:\n",count);
+	for (c=ultraLowPower;c<=ultraHighResolution;c++)
+	{
+		for (i=0;i<count;i++)
+		{
+			BMP085Sim_rawSample(&sim,c,&ut,&up);
+			BMP085_calculateTemperature(&calibration,ut,&b5);
+			values[i] = pressure[i] = BMP085_calculatePressure(&calibration,c,up,b5);
+		}
+		noise[c] = bench_filterDeviation(values,count);
+		printf("  %-20s %6.2f Pa every %4.1f ms\n",bench_ossName[c],noise[c],BMP085_PressureConversionTime[c]/1e6);
+	}
+
+	// The last generated stream is ultraHighResolution, regenerate the ultraLowPower one.
+	for (i=0;i<count;i++)
+	{
+		BMP085Sim_rawSample(&sim,ultraLowPower,&ut,&up);
+		BMP085_calculateTemperature(&calibration,ut,&b5);
+		pressure[i] = BMP085_calculatePressure(&calibration,ultraLowPower,up,b5);
+	}
+
+	printf("\n%s input with temperature reuse, one sample every %.1f ms:\n",bench_ossName[ultraLowPower],period);
+	printf("%-20s %9s %10s %9s %9s %9s %8s\n","filter","noise Pa","output Hz","delay ms","step ms","ns/sample","gain");
+	for (c=0;c<BENCH_FILTER_CONFIGS;c++)
+	{
+		if (bench_filterSetup(&filter,&bench_filterConfigs[c]))
+			return 1;
+
+		n = 0;
+		begin = tNow();
+		for (i=0;i<count;i++)
+			if (BMP085Filter_process(&filter,pressure[i],&output) && i >= BENCH_SETTLE)
+				values[n++] = output / (double)(1 << BMP085FILTER_FRACTION_BITS);
+		elapsed = tNow() - begin;
+		bench_consume(output);
+
+		// Step response on a noise-free input: samples until the output covers half of the step.
+		BMP085Filter_reset(&filter);
+		for (i=0;i<BENCH_SETTLE;i++)
+			BMP085Filter_process(&filter,100000,&output);
+		for (step=1;step<BENCH_SETTLE;step++)
+			if (BMP085Filter_process(&filter,100000 + BENCH_STEP,&output) && output >= (100000 + BENCH_STEP/2) << BMP085FILTER_FRACTION_BITS)
+				break;
+
+		printf("%-20s %9.2f %10.1f %9.1f %9.1f %9.1f %7.2fx\n",bench_filterConfigs[c].name,bench_filterDeviation(values,n),
+			1000.0/(period*bench_filterConfigs[c].decimation),BMP085Filter_delay(&filter)*period,(step - 1)*period,
+			(double)elapsed/count,noise[ultraLowPower]/bench_filterDeviation(values,n));
+	}
+
+	return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * BMP085 library
+ * bench/bench_group.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Compares sampling several simulated sensors on one simulated bus in
+ * turn with BMP085_takeMeasurement against one BMP085_takeGroupMeasurement
+ * call that overlaps their conversions.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "bmp085sim.h"
+
+#define BENCH_SENSORS 4
+#define BENCH_BYTE_TIME 90000L	/* 9 clocks per byte at 100 kHz */
+
+int bench_group(void)
+{
+	BMP085Sim sim[BENCH_SENSORS];
+	BMP085SimBus bus;
+	BMP085 sensor[BENCH_SENSORS];
+	BMP085 *group[BENCH_SENSORS];
+	long long begin, sequential, grouped;
+	int oss, i, n;
+
+	printf("%d sensors on one bus, %ld ns per bus byte, %d cycles\n",BENCH_SENSORS,BENCH_BYTE_TIME,bench_samples);
+	printf("%-20s %16s %16s %8s\n","mode","sequential ms","grouped ms","speedup");
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		BMP085SimBus_init(&bus,BENCH_BYTE_TIME);
+		for (i=0;i<BENCH_SENSORS;i++)
+		{
+			BMP085Sim_init(&sim[i],0x77 - i);
+			BMP085SimBus_attach(&bus,&sim[i]);
+			if (BMP085_initSensorOnBus(&sensor[i],&BMP085SimBus_busOps,&bus,sim[i].I2CAddress,oss))
+				return 1;
+			group[i] = &sensor[i];
+		}
+
+		begin = tNow();
+		for (n=0;n<bench_samples;n++)
+			for (i=0;i<BENCH_SENSORS;i++)
+				if (BMP085_takeMeasurement(&sensor[i]))
+					return 1;
+		sequential = tNow() - begin;
+
+		begin = tNow();
+		for (n=0;n<bench_samples;n++)
+			if (BMP085_takeGroupMeasurement(group,BENCH_SENSORS,NULL))
+				return 1;
+		grouped = tNow() - begin;
+
+		printf("%-20s %16.2f %16.2f %7.2fx\n",bench_ossName[oss],sequential/1e6/bench_samples,grouped/1e6/bench_samples,(double)sequential/grouped);
+	}
+	puts("(times per cycle over all sensors)");
+
+	return 0;
+}
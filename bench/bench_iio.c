@@ -0,0 +1,231 @@
+/*
+ * BMP085 library
+ * bench/bench_iio.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Builds a fake IIO device of the kernel bmp280 driver in a temporary
+ * directory and checks the IIO backend against it: BMP085_takeMeasurement
+ * through sysfs, the over sampling ratio set in the driver, and the buffered
+ * character device with a trigger. Reports the cost of a one-shot measurement
+ * next to the register path over the simulated sensor, and the rate of
+ * reading the buffer.
+ */
+
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <ftw.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085iio.h"
+
+#define BENCH_IIO_READS 20000L
+#define BENCH_IIO_SCANS 200000L
+#define BENCH_IIO_CHUNK 256
+
+/* One scan of the fake buffer: pressure, temperature and timestamp. */
+typedef struct
+{
+	uint32_t pressure;	/* [Pa], scale 0.001 to [kPa]. */
+	int32_t temperature;	/* 0.1 degrees Celsius, scale 100 to milli degrees Celsius. */
+	int64_t timestamp;
+} benchIioScan;
+
+static int bench_iioFile(const char *directory,const char *name,const char *content)
+{
+	char path[1024];
+	FILE *file;
+
+	snprintf(path,sizeof(path),"%s/%s",directory,name);
+	file = fopen(path,"w");
+	if (!file)
+		return 1;
+	fputs(content,file);
+	return fclose(file) != 0;
+}
+
+/* CPU time of the calling thread in [ns]. */
+static long long bench_iioCpu(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID,&now);
+	return (long long)now.tv_sec*1000000000LL+now.tv_nsec;
+}
+
+static int bench_iioRemove(const char *path,const struct stat *status,int flag,struct FTW *ftw)
+{
+	return remove(path);
+}
+
+/* Creates the sysfs directory and the character device of a fake iio:device0. */
+static int bench_iioTree(const char *root,char *sysfs,char *device,size_t size)
+{
+	static const char *files[][2] = {
+		{ "name", "bmp180\n" },
+		{ "in_temp_input", "15000\n" },
+		{ "in_pressure_input", "69.964000\n" },
+		{ "in_pressure_oversampling_ratio", "1\n" },
+		{ "in_temp_scale", "100\n" },
+		{ "in_pressure_scale", "0.001000\n" },
+		{ "current_timestamp_clock", "realtime\n" },
+		{ "scan_elements/in_pressure_en", "0\n" },
+		{ "scan_elements/in_pressure_type", "le:u32/32>>0\n" },
+		{ "scan_elements/in_pressure_index", "0\n" },
+		{ "scan_elements/in_temp_en", "0\n" },
+		{ "scan_elements/in_temp_type", "le:s32/32>>0\n" },
+		{ "scan_elements/in_temp_index", "1\n" },
+		{ "scan_elements/in_timestamp_en", "0\n" },
+		{ "scan_elements/in_timestamp_type", "le:s64/64>>0\n" },
+		{ "scan_elements/in_timestamp_index", "2\n" },
+		{ "buffer/enable", "0\n" },
+		{ "buffer/length", "2\n" },
+		{ "trigger/current_trigger", "\n" },
+	};
+	char path[512];
+	benchIioScan *scans;
+	FILE *file;
+	long i;
+	int result;
+
+	snprintf(path,sizeof(path),"%s/sys",root);
+	snprintf(sysfs,size,"%s/sys/iio:device0",root);
+	snprintf(device,size,"%s/iio:device0",root);
+	if (mkdir(path,0755) || mkdir(sysfs,0755))
+		return 1;
+	// A device of another driver, skipped by BMP085Iio_find().
+	snprintf(path,sizeof(path),"%s/sys/iio:device1",root);
+	if (mkdir(path,0755) || bench_iioFile(path,"name","ads1015\n"))
+		return 1;
+	snprintf(path,sizeof(path),"%s/scan_elements",sysfs);
+	if (mkdir(path,0755))
+		return 1;
+	snprintf(path,sizeof(path),"%s/buffer",sysfs);
+	if (mkdir(path,0755))
+		return 1;
+	snprintf(path,sizeof(path),"%s/trigger",sysfs);
+	if (mkdir(path,0755))
+		return 1;
+	for (i=0;i<(long)(sizeof(files)/sizeof(files[0]));i++)
+		if (bench_iioFile(sysfs,files[i][0],files[i][1]))
+			return 1;
+
+	// The buffered samples: a pressure ramp at 100 Hz.
+	scans = malloc(BENCH_IIO_SCANS*sizeof(benchIioScan));
+	file = fopen(device,"w");
+	if (!scans || !file)
+	{
+		free(scans);
+		if (file)
+			fclose(file);
+		return 1;
+	}
+	for (i=0;i<BENCH_IIO_SCANS;i++)
+	{
+		scans[i].pressure = 69964 + i % 1000;
+		scans[i].temperature = 150 + i % 10;
+		scans[i].timestamp = i * 10000000LL;
+	}
+	result = fwrite(scans,sizeof(benchIioScan),BENCH_IIO_SCANS,file) != BENCH_IIO_SCANS;
+	free(scans);
+	if (fclose(file))
+		result = 1;
+	return result;
+}
+
+int bench_iio(void)
+{
+	char root[] = "/tmp/bmp085iioXXXXXX", sysfs[256], device[256], devices[256], found[256], value[32];
+	BMP085Sample *samples = NULL;
+	BMP085Iio iio;
+	BMP085Sim sim;
+	BMP085 sensor;
+	FILE *file;
+	long long begin, cpu, oneShot, oneShotCpu, registers, registersCpu, buffered;
+	size_t n, total;
+	long i;
+	int result = 1, opened = 0;
+
+	if (!mkdtemp(root))
+		return 1;
+	if (bench_iioTree(root,sysfs,device,sizeof(sysfs)))
+		goto done;
+
+	snprintf(devices,sizeof(devices),"%s/sys",root);
+	if (BMP085Iio_find(devices,found,sizeof(found)) || strcmp(found,sysfs) || BMP085Iio_open(&iio,sysfs,device))
+		goto done;
+	opened = 1;
+
+	// One-shot measurements through the measurement API; the fake device does not wait for conversions.
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Iio_busOps,&iio,0x77,highResolution))
+		goto done;
+	begin = tNow();
+	cpu = bench_iioCpu();
+	for (i=0;i<BENCH_IIO_READS;i++)
+		if (BMP085_takeMeasurement(&sensor))
+			goto done;
+	oneShotCpu = bench_iioCpu() - cpu;
+	oneShot = tNow() - begin;
+	file = fopen(strcat(strcpy(found,sysfs),"/in_pressure_oversampling_ratio"),"r");
+	if (!file || !fgets(value,sizeof(value),file) || atoi(value) != 4 || sensor.pressure != 69964 || (long)(sensor.temperature*10 + 0.5) != 150)
+	{
+		if (file)
+			fclose(file);
+		printf("one-shot measurement mismatch\n");
+		goto done;
+	}
+	fclose(file);
+
+	// The same measurement over the register path of the simulated sensor, with the datasheet waits.
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,highResolution))
+		goto done;
+	begin = tNow();
+	cpu = bench_iioCpu();
+	for (i=0;i<bench_samples;i++)
+		if (BMP085_takeMeasurement(&sensor))
+			goto done;
+	registersCpu = bench_iioCpu() - cpu;
+	registers = tNow() - begin;
+
+	// The buffered character device, read in chunks.
+	samples = malloc(BENCH_IIO_CHUNK*sizeof(BMP085Sample));
+	if (!samples || BMP085Iio_startBuffer(&iio,"bmp180-dev0",128,highResolution))
+		goto done;
+	begin = tNow();
+	for (total=0;(n = BMP085Iio_readBuffer(&iio,samples,BENCH_IIO_CHUNK));total+=n)
+		for (i=0;i<(long)n;i++)
+			if (samples[i].pressure != 69964 + (long)(total + i) % 1000 || samples[i].temperature != 150 + (long)(total + i) % 10 ||
+				samples[i].timestamp != (long long)(total + i) * 10000000LL || samples[i].sequence != total + i)
+			{
+				printf("buffered sample %zu mismatch\n",total + i);
+				goto done;
+			}
+	buffered = tNow() - begin;
+	if (total != BENCH_IIO_SCANS)
+		goto done;
+	BMP085Iio_stopBuffer(&iio);
+
+	printf("%-56s %12s %12s\n","one-shot measurement","us","cpu us");
+	printf("%-56s %12.2f %12.2f\n","IIO sysfs, fake device",oneShot/1e3/BENCH_IIO_READS,oneShotCpu/1e3/BENCH_IIO_READS);
+	printf("%-56s %12.2f %12.2f\n","register path, simulated sensor (model cost included)",registers/1e3/bench_samples,registersCpu/1e3/bench_samples);
+	printf("IIO buffer, fake character device: %.1f M samples/s\n",total/(buffered/1e3));
+	puts("(a real IIO one-shot read also blocks in the kernel for the conversion time)");
+	result = 0;
+
+done:
+	if (opened)
+		BMP085Iio_close(&iio);
+	free(samples);
+	nftw(root,bench_iioRemove,16,FTW_DEPTH|FTW_PHYS);
+	return result;
+}
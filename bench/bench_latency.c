@@ -0,0 +1,95 @@
+/*
+ * BMP085 library
+ * bench/bench_latency.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Reports the latency of BMP085_takeMeasurement for every over sampling
+ * mode with the timed end of conversion, with Sco polling and with the EOC
+ * line of the simulated sensor (a timerfd that fires when the conversion
+ * ends). "EOC lost" uses a line that never fires, so every conversion falls
+ * back to the maximum time. "late us" is the time from the end of the
+ * pressure conversion to the return of BMP085_takeMeasurement.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "bench.h"
+#include "bmp085sim.h"
+
+#define BENCH_EOC_LOST 3
+
+static const char *bench_eocName[] = { "timed", "poll Sco", "EOC line", "EOC lost" };
+
+int bench_latency(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	long long begin, latency, total, minimum, maximum, late;
+	double timed = 0;
+	int oss, eocMode, i, lost[2];
+
+	if (pipe2(lost,O_NONBLOCK))
+		return 1;
+	printf("%-20s %-9s %9s %9s %9s %8s %8s %8s\n","mode","eoc","mean ms","min ms","max ms","late us","trans","gain");
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		for (eocMode=eocTimed;eocMode<=BENCH_EOC_LOST;eocMode++)
+		{
+			BMP085Sim_init(&sim,0x77);
+			if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,oss))
+				return 1;
+			if (eocMode == eocLine)
+			{
+				if (BMP085Sim_openEocLine(&sim) < 0)
+					return 1;
+				BMP085_setEndOfConversionLine(&sensor,sim.eocLine);
+			}
+			else if (eocMode == BENCH_EOC_LOST)
+				BMP085_setEndOfConversionLine(&sensor,lost[0]);
+			else
+				BMP085_setEndOfConversionMode(&sensor,eocMode);
+			BMP085Sim_resetCounters(&sim);
+
+			total = maximum = late = 0;
+			minimum = -1;
+			for (i=0;i<bench_samples;i++)
+			{
+				begin = tNow();
+				if (BMP085_takeMeasurement(&sensor))
+					return 1;
+				latency = tNow() - begin;
+				late += begin + latency - sim.conversionEnd;
+				total += latency;
+				if (latency > maximum)
+					maximum = latency;
+				if (minimum < 0 || latency < minimum)
+					minimum = latency;
+			}
+
+			BMP085Sim_closeEocLine(&sim);
+			if ((eocMode == eocLine && sensor.eocMissed) || (eocMode == BENCH_EOC_LOST && sensor.eocMissed != 2UL*bench_samples))
+			{
+				printf("%s: %lu conversions without an edge\n",bench_eocName[eocMode],sensor.eocMissed);
+				return 1;
+			}
+
+			if (eocMode == eocTimed)
+				timed = (double)total/bench_samples;
+			printf("%-20s %-9s %9.2f %9.2f %9.2f %8.1f %8.1f %7.2fx\n",bench_ossName[oss],bench_eocName[eocMode],
+				total/1e6/bench_samples,minimum/1e6,maximum/1e6,late/1e3/bench_samples,
+				(double)(sim.reads+sim.writes)/bench_samples,timed*bench_samples/total);
+		}
+	}
+
+	close(lost[0]);
+	close(lost[1]);
+
+	return 0;
+}
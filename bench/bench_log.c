@@ -0,0 +1,198 @@
+/*
+ * BMP085 library
+ * bench/bench_log.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Records a day of 100 Hz raw samples into a temporary log, reopens it
+ * for appending, then maps it and replays every record through the
+ * batch compensation. Reports the append cost, the file size and the
+ * replay time, and checks the replayed values against the scalar functions.
+ * Also fills the file system, emulated with a file size limit, in the middle
+ * of a record and checks the status of the appends and that the log stays
+ * aligned after the retry, and replays a log with a corrupt record.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085batch.h"
+#include "bmp085log.h"
+
+#define BENCH_LOG_RECORDS (24L*3600*100)
+#define BENCH_LOG_PERIOD 10000000LL
+
+/* Fails a flush with a partial record on disk, then retries it and checks every record of the log. */
+static int bench_logFull(const char *path,const BMP085 *sensor)
+{
+	struct rlimit original, limit;
+	BMP085LogWriter writer;
+	BMP085LogReader reader;
+	void (*handler)(int);
+	int i, status, pending = 0, rejected = 0, result = 1;
+
+	unlink(path);
+	if (BMP085LogWriter_open(&writer,path,sensor) || getrlimit(RLIMIT_FSIZE,&original))
+		return 1;
+	limit = original;
+	limit.rlim_cur = sizeof(BMP085LogHeader) + (BMP085LOG_BUFFER_RECORDS + 40) * sizeof(BMP085LogRecord) + 8;
+	handler = signal(SIGXFSZ,SIG_IGN);
+	setrlimit(RLIMIT_FSIZE,&limit);
+	// The last record fills the buffer and is kept, the one after it finds the buffer still full.
+	for (i=0;i<=2*BMP085LOG_BUFFER_RECORDS;i++)
+	{
+		status = BMP085LogWriter_append(&writer,i,27000,23000,standard);
+		pending += status == BMP085LOG_FLUSH_PENDING;
+		rejected += status == BMP085LOG_REJECTED;
+	}
+	setrlimit(RLIMIT_FSIZE,&original);
+	signal(SIGXFSZ,handler);
+
+	if (pending != 1 || rejected != 1 || writer.records != 2*BMP085LOG_BUFFER_RECORDS || writer.committed != BMP085LOG_BUFFER_RECORDS ||
+		BMP085LogWriter_close(&writer) || BMP085LogReader_open(&reader,path))
+	{
+		printf("full file system: %d pending and %d rejected appends, %lu committed records\n",pending,rejected,writer.committed);
+		return 1;
+	}
+	if (reader.count == 2*BMP085LOG_BUFFER_RECORDS)
+	{
+		for (i=0;i<2*BMP085LOG_BUFFER_RECORDS && reader.records[i].timestamp == i && reader.records[i].rawPressure == 23000;i++)
+			;
+		result = i != 2*BMP085LOG_BUFFER_RECORDS;
+	}
+	if (result)
+		printf("full file system: the log is misaligned after the retry\n");
+	BMP085LogReader_close(&reader);
+	return result;
+}
+
+/* Replays a log whose middle record has an invalid mode. */
+static int bench_logCorrupt(const char *path,const BMP085 *sensor)
+{
+	BMP085LogWriter writer;
+	BMP085LogReader reader;
+	int32_t temperature[3], pressure[3];
+	uint8_t oss = 7;
+	int i, fd, result;
+
+	unlink(path);
+	if (BMP085LogWriter_open(&writer,path,sensor))
+		return 1;
+	for (i=0;i<3;i++)
+		BMP085LogWriter_append(&writer,i,27000,23000,standard);
+	if (BMP085LogWriter_close(&writer))
+		return 1;
+	fd = open(path,O_WRONLY);
+	if (fd < 0 || pwrite(fd,&oss,1,sizeof(BMP085LogHeader) + sizeof(BMP085LogRecord) + offsetof(BMP085LogRecord,oss)) != 1)
+		result = 1;
+	else
+		result = 0;
+	if (fd >= 0)
+		close(fd);
+	if (result || BMP085LogReader_open(&reader,path))
+		return 1;
+
+	result = BMP085LogReader_replay(&reader,0,3,temperature,pressure) != 3 || reader.corrupt != 1 ||
+		pressure[1] || !pressure[0] || pressure[0] != pressure[2];
+	if (result)
+		printf("corrupt record: %lu counted, pressures %d %d %d\n",(unsigned long)reader.corrupt,pressure[0],pressure[1],pressure[2]);
+	BMP085LogReader_close(&reader);
+	return result;
+}
+
+int bench_log(void)
+{
+	char path[] = "/tmp/bmp085logXXXXXX";
+	BMP085Sim sim;
+	BMP085 sensor;
+	BMP085LogWriter writer;
+	BMP085LogReader reader;
+	int32_t *temperature, *pressure, b5;
+	unsigned long seed = 1;
+	long long begin, append, mapping, replay;
+	long i;
+	int fd, oss, result = 1;
+
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,standard))
+		return 1;
+	fd = mkstemp(path);
+	if (fd < 0)
+		return 1;
+	close(fd);
+	unlink(path);
+
+	temperature = malloc(BENCH_LOG_RECORDS*sizeof(int32_t));
+	pressure = malloc(BENCH_LOG_RECORDS*sizeof(int32_t));
+	if (!temperature || !pressure || BMP085LogWriter_open(&writer,path,&sensor))
+		goto done;
+
+	// A day of samples, with the mode switched every hour and the last 10 samples appended after a reopen.
+	begin = tNow();
+	for (i=0;i<BENCH_LOG_RECORDS-10;i++)
+	{
+		seed = seed * 1103515245UL + 12345UL;
+		oss = (i / 360000) & 3;
+		if (BMP085LogWriter_append(&writer,i*BENCH_LOG_PERIOD,27000 + (seed >> 20) % 200,(22000 + (seed >> 16) % 4000) << oss,oss))
+			goto done;
+	}
+	if (BMP085LogWriter_close(&writer))
+		goto done;
+	append = tNow() - begin;
+
+	if (BMP085LogWriter_open(&writer,path,&sensor) || writer.records != BENCH_LOG_RECORDS-10)
+		goto done;
+	for (;i<BENCH_LOG_RECORDS;i++)
+		if (BMP085LogWriter_append(&writer,i*BENCH_LOG_PERIOD,27000,23000,standard))
+			goto done;
+	if (BMP085LogWriter_close(&writer))
+		goto done;
+
+	begin = tNow();
+	if (BMP085LogReader_open(&reader,path))
+		goto done;
+	mapping = tNow() - begin;
+	begin = tNow();
+	if (BMP085LogReader_replay(&reader,0,reader.count,temperature,pressure) != BENCH_LOG_RECORDS)
+		goto done;
+	replay = tNow() - begin;
+
+	for (i=0;i<BENCH_LOG_RECORDS;i+=997)
+	{
+		if (temperature[i] != BMP085_calculateTemperature(&(reader.calibration),reader.records[i].rawTemperature,&b5) ||
+			pressure[i] != BMP085_calculatePressure(&(reader.calibration),reader.records[i].oss,reader.records[i].rawPressure,b5))
+		{
+			printf("replay mismatch at record %ld\n",i);
+			goto done;
+		}
+	}
+
+	printf("%ld records (one day at 100 Hz), %.1f MB log\n",BENCH_LOG_RECORDS,reader.mapSize/1e6);
+	printf("%-28s %10.1f ns/record\n","append",(double)append/(BENCH_LOG_RECORDS-10));
+	printf("%-28s %10.3f ms\n","open and map",mapping/1e6);
+	printf("%-28s %10.1f ms (%.1f M records/s, %s)\n","replay with compensation",replay/1e6,BENCH_LOG_RECORDS/(replay/1e3),BMP085_batchImplementation());
+	BMP085LogReader_close(&reader);
+
+	if (bench_logFull(path,&sensor))
+		goto done;
+	printf("flush failing within a record: cut back to the last record, all records written by the retry\n");
+	if (bench_logCorrupt(path,&sensor))
+		goto done;
+	printf("record with an invalid mode: not compensated and counted as corrupt\n");
+	result = 0;
+
+done:
+	unlink(path);
+	free(temperature);
+	free(pressure);
+	return result;
+}
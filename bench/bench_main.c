@@ -0,0 +1,134 @@
+/*
+ * BMP085 library
+ * bench/bench_main.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Runs the libBMP085 benchmark suites. Without arguments all of the
+ * suites are executed, otherwise only the suites named on the command line.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench.h"
+
+int bench_samples = 20;
+int bench_fullSweep = 0;
+
+const char *bench_ossName[] = { "ultraLowPower", "standard", "highResolution", "ultraHighResolution" };
+
+static volatile long bench_sink;
+
+static const struct
+{
+	const char *name;
+	int (*run)(void);
+	const char *description;
+} bench_suites[] = {
+	{ "transport", bench_transport, "throughput, per-phase latency and transactions per BMP085_takeMeasurement" },
+	{ "nonblocking", bench_nonblocking, "several sensors driven from one thread with the split measurement API" },
+	{ "latency", bench_latency, "per-mode latency with timed waits, with Sco polling and with the EOC line" },
+	{ "reuse", bench_reuse, "pressure sample rate with temperature reuse policies" },
+	{ "compensation", bench_compensation, "cost of calibration decoding and of the pure compensation functions" },
+	{ "batch", bench_batch, "scalar and vectorized batch compensation throughput and bit-exactness" },
+	{ "manager", bench_manager, "reading rate of the sensor manager with the sensors spread over several buses" },
+	{ "group", bench_group, "sensors on one bus sampled in turn and with overlapping conversions" },
+	{ "stream", bench_stream, "continuous sampling engine with fast and slow consumers" },
+	{ "scheduler", bench_scheduler, "drift, jitter and missed deadlines of relative sleeps and of the fixed-rate scheduler" },
+	{ "filter", bench_filter, "noise reduction, latency and cost of software oversampling filters" },
+	{ "altitude", bench_altitude, "accuracy and rate of the exact, approximate and batch altitude functions" },
+	{ "log", bench_log, "append cost and replay time of a day of raw samples in the binary log" },
+	{ "stats", bench_stats, "cost of the performance counters and the latency profile of a simulated sensor" },
+	{ "retry", bench_retry, "completed measurements and tail latency with injected NACKs, with and without retries" },
+	{ "cpp", bench_cpp, "C++ interface with the mode fixed at compile time against the C functions" },
+	{ "shm", bench_shm, "reads of the shared memory segment with a publisher running and the bus traffic of a daemon with readers" },
+	{ "calcache", bench_calcache, "fleet startup on a slow bus with an empty, a valid, a stale and a damaged calibration cache" },
+	{ "iio", bench_iio, "kernel IIO backend against a fake device tree: one-shot reads next to the register path, and the buffer" },
+	{ "adaptive", bench_adaptive, "flight profile sampled in every fixed mode and with the adaptive over sampling controller under latency and duty budgets" },
+	{ "exhaustive", bench_exhaustive, "compensation against a 128-bit datasheet reference over the raw input space of every mode, on all processors" },
+	{ "arbiter", bench_arbiter, "four sensors on one bus with split i2c-dev transactions, from threads and processes, without and with bus arbitration" },
+	{ "vario", bench_vario, "vertical speed from a replayed climb by differencing altitudes and with the estimator: noise, error, lag and update cost" },
+};
+
+#define BENCH_SUITE_COUNT (int)(sizeof(bench_suites)/sizeof(bench_suites[0]))
+
+long long bench_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return (long long)now.tv_sec*1000000000LL+now.tv_nsec;
+}
+
+void bench_consume(long value)
+{
+	bench_sink += value;
+}
+
+static void print_usage(const char *prog)
+{
+	int i;
+
+	printf("Usage: %s [-n samples] [-x] [suite...]\n", prog);
+	puts("  -n\t\t number of samples per configuration (default 20);\n"
+	     "  -x\t\t sweep every raw temperature in the exhaustive suite (about an hour of CPU time per table);\n"
+	     "Available suites:");
+	for (i=0;i<BENCH_SUITE_COUNT;i++)
+		printf("  %-16s %s\n",bench_suites[i].name,bench_suites[i].description);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	int c, i, found, result = 0;
+
+	while ((c = getopt(argc, argv, "n:xh")) != -1)
+	{
+		switch (c)
+		{
+			case 'n':
+				bench_samples = atoi(optarg);
+				if (bench_samples < 1)
+					print_usage(argv[0]);
+				break;
+			case 'x':
+				bench_fullSweep = 1;
+				break;
+			default:
+				print_usage(argv[0]);
+		}
+	}
+
+	for (c=optind;c<argc;c++)
+	{
+		for (i=0;i<BENCH_SUITE_COUNT && strcmp(argv[c],bench_suites[i].name);i++)
+			;
+		if (i == BENCH_SUITE_COUNT)
+			print_usage(argv[0]);
+	}
+
+	for (i=0;i<BENCH_SUITE_COUNT;i++)
+	{
+		found = (optind == argc);
+		for (c=optind;c<argc && !found;c++)
+			found = !strcmp(argv[c],bench_suites[i].name);
+		if (!found)
+			continue;
+		printf("== %s ==\n",bench_suites[i].name);
+		if (bench_suites[i].run())
+		{
+			printf("Suite %s failed.\n",bench_suites[i].name);
+			result = 1;
+		}
+		printf("\n");
+	}
+
+	return result;
+}
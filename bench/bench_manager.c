@@ -0,0 +1,160 @@
+/*
+ * BMP085 library
+ * bench/bench_manager.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Spreads the same number of simulated sensors over a growing number of
+ * simulated buses served by BMP085Manager and reports the aggregate
+ * reading rate collected by a single consumer. Also runs a healthy bus next
+ * to an empty bus and an unplugged one and checks the reading rate of the
+ * failing bus, the dropped readings and the processor time of the workers.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "bench.h"
+#include "I2Cbus.h"
+#include "bmp085sim.h"
+#include "bmp085manager.h"
+
+#define BENCH_SENSORS 8
+#define BENCH_BYTE_TIME 90000L	/* 9 clocks per byte at 100 kHz */
+#define BENCH_UNPLUGGED_TIME 500000000LL
+
+/* Simulated sensor whose adapter can be unplugged. */
+typedef struct
+{
+	BMP085Sim sim;
+	int unplugged;
+} bench_unpluggable;
+
+static int bench_unpluggableRead(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+{
+	bench_unpluggable *adapter = (bench_unpluggable *)context;
+
+	if (__atomic_load_n(&(adapter->unplugged),__ATOMIC_RELAXED))
+		return ERROR_I2C_READ_FAILED;
+	return BMP085Sim_busOps.read(&(adapter->sim),I2CAddress,registry,buffer,size);
+}
+
+static int bench_unpluggableWrite(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+{
+	bench_unpluggable *adapter = (bench_unpluggable *)context;
+
+	if (__atomic_load_n(&(adapter->unplugged),__ATOMIC_RELAXED))
+		return ERROR_I2C_WRITE_FAILED;
+	return BMP085Sim_busOps.write(&(adapter->sim),I2CAddress,registry,value);
+}
+
+static const I2CBusOps bench_unpluggableOps = { .read = bench_unpluggableRead, .write = bench_unpluggableWrite };
+
+/* Samples a healthy bus next to an empty and an unplugged bus for BENCH_UNPLUGGED_TIME. */
+static int bench_managerUnplugged(void)
+{
+	bench_unpluggable healthy, unplugged;
+	BMP085Manager *manager = BMP085Manager_create();
+	BMP085Reading reading;
+	struct timespec cpu;
+	long long begin, cpuBegin, end;
+	unsigned long readings[2] = { 0, 0 };
+
+	if (!manager)
+		return 1;
+	BMP085Sim_init(&(healthy.sim),0x77);
+	BMP085Sim_init(&(unplugged.sim),0x77);
+	healthy.unplugged = unplugged.unplugged = 0;
+	if (BMP085Manager_addBusOps(manager,&bench_unpluggableOps,&healthy) != 0 ||
+		BMP085Manager_addBusOps(manager,&bench_unpluggableOps,&unplugged) != 1 ||
+		BMP085Manager_addBusOps(manager,&bench_unpluggableOps,NULL) != 2 ||
+		BMP085Manager_addSensor(manager,0,0x77,ultraLowPower) != 0 || BMP085Manager_addSensor(manager,1,0x77,ultraLowPower) != 1)
+	{
+		BMP085Manager_destroy(manager);
+		return 1;
+	}
+	__atomic_store_n(&(unplugged.unplugged),1,__ATOMIC_RELAXED);
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID,&cpu);
+	cpuBegin = cpu.tv_sec*1000000000LL + cpu.tv_nsec;
+	begin = tNow();
+	if (BMP085Manager_start(manager,0))
+	{
+		BMP085Manager_destroy(manager);
+		return 1;
+	}
+	while (tNow() - begin < BENCH_UNPLUGGED_TIME)
+		if (!BMP085Manager_read(manager,&reading,10000000LL))
+			readings[reading.sensor]++;
+	BMP085Manager_stop(manager);
+	end = tNow();
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID,&cpu);
+
+	printf("healthy, empty and unplugged bus: %.1f and %.1f readings/s, %lu dropped, %.1f %% of a processor\n",
+		readings[0]/((end - begin)/1e9),readings[1]/((end - begin)/1e9),BMP085Manager_dropped(manager),
+		100.0*(cpu.tv_sec*1000000000LL + cpu.tv_nsec - cpuBegin)/(end - begin));
+	BMP085Manager_destroy(manager);
+
+	// The unplugged bus backs off for a maximum conversion time after every failed round.
+	return !readings[0] || readings[1] > BENCH_UNPLUGGED_TIME / BMP085_PressureConversionTime[ultraHighResolution] + 2;
+}
+
+int bench_manager(void)
+{
+	static const int busCounts[] = { 1, 2, 4, 8 };
+	BMP085Sim sim[BENCH_SENSORS];
+	BMP085SimBus bus[BENCH_SENSORS];
+	BMP085Manager *manager;
+	BMP085Reading reading;
+	long long begin, elapsed, single = 0;
+	int c, i, buses, received, failed;
+
+	printf("%d sensors, %s mode, %d readings each, %ld ns per bus byte\n",BENCH_SENSORS,bench_ossName[standard],bench_samples,BENCH_BYTE_TIME);
+	printf("%-8s %14s %12s %8s %8s\n","buses","readings/s","elapsed ms","speedup","dropped");
+	for (c=0;c<(int)(sizeof(busCounts)/sizeof(busCounts[0]));c++)
+	{
+		buses = busCounts[c];
+		manager = BMP085Manager_create();
+		if (!manager)
+			return 1;
+
+		for (i=0;i<buses;i++)
+		{
+			BMP085SimBus_init(&bus[i],BENCH_BYTE_TIME);
+			if (BMP085Manager_addBusOps(manager,&BMP085SimBus_busOps,&bus[i]) != i)
+				return 1;
+		}
+		for (i=0;i<BENCH_SENSORS;i++)
+		{
+			BMP085Sim_init(&sim[i],0x77 - i / buses);
+			BMP085SimBus_attach(&bus[i % buses],&sim[i]);
+			if (BMP085Manager_addSensor(manager,i % buses,sim[i].I2CAddress,standard) != i)
+				return 1;
+		}
+
+		received = 0;
+		failed = 0;
+		begin = tNow();
+		if (BMP085Manager_start(manager,0))
+			return 1;
+		while (received < BENCH_SENSORS * bench_samples && !BMP085Manager_read(manager,&reading,-1))
+		{
+			received++;
+			failed += reading.status;
+		}
+		elapsed = tNow() - begin;
+		BMP085Manager_stop(manager);
+		if (!single)
+			single = elapsed;
+
+		printf("%-8d %14.1f %12.1f %7.2fx %8lu\n",buses,received/(elapsed/1e9),elapsed/1e6,(double)single/elapsed,BMP085Manager_dropped(manager));
+		BMP085Manager_destroy(manager);
+		if (failed)
+			return 1;
+	}
+
+	return bench_managerUnplugged();
+}
@@ -0,0 +1,82 @@
+/*
+ * BMP085 library
+ * bench/bench_nonblocking.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Compares sampling several simulated sensors with the blocking
+ * BMP085_takeMeasurement against a single-threaded loop that drives
+ * all of them through BMP085_startMeasurement/BMP085_pollMeasurement.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "bmp085sim.h"
+
+#define BENCH_SENSORS 4
+
+int bench_nonblocking(void)
+{
+	BMP085Sim sim[BENCH_SENSORS];
+	BMP085 sensor[BENCH_SENSORS];
+	long long begin, blocking, nonBlocking, next;
+	int oss, i, n, done, result;
+
+	printf("%d sensors, %d samples each\n",BENCH_SENSORS,bench_samples);
+	printf("%-20s %14s %14s %8s\n","mode","blocking ms","event loop ms","speedup");
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		for (i=0;i<BENCH_SENSORS;i++)
+		{
+			BMP085Sim_init(&sim[i],0x77);
+			if (BMP085_initSensorOnBus(&sensor[i],&BMP085Sim_busOps,&sim[i],0x77,oss))
+				return 1;
+		}
+
+		begin = tNow();
+		for (n=0;n<bench_samples;n++)
+			for (i=0;i<BENCH_SENSORS;i++)
+				if (BMP085_takeMeasurement(&sensor[i]))
+					return 1;
+		blocking = tNow() - begin;
+
+		begin = tNow();
+		for (n=0;n<bench_samples;n++)
+		{
+			for (i=0;i<BENCH_SENSORS;i++)
+				if (BMP085_startMeasurement(&sensor[i]))
+					return 1;
+			done = 0;
+			while (done < BENCH_SENSORS)
+			{
+				next = 0;
+				for (i=0;i<BENCH_SENSORS;i++)
+				{
+					if (sensor[i].state == measurementIdle)
+						continue;
+					result = BMP085_pollMeasurement(&sensor[i]);
+					if (result == 0)
+						done++;
+					else if (result == BMP085_MEASUREMENT_PENDING)
+					{
+						if (!next || BMP085_readyTime(&sensor[i]) < next)
+							next = BMP085_readyTime(&sensor[i]);
+					}
+					else
+						return 1;
+				}
+				if (next)
+					tDelayUntil(next);
+			}
+		}
+		nonBlocking = tNow() - begin;
+
+		printf("%-20s %14.1f %14.1f %7.2fx\n",bench_ossName[oss],blocking/1e6,nonBlocking/1e6,(double)blocking/nonBlocking);
+	}
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * BMP085 library
+ * bench/bench_retry.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Injects random NACKs into the simulated sensor and compares the share
+ * of completed measurements and the latency distribution without retries
+ * and with a retry policy bounded by a latency budget. A second run wedges
+ * the simulated bus and checks that the sensor gets back to work through
+ * the recover operation of the transport.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "bmp085sim.h"
+
+static const double bench_failureRates[] = { 0.0, 0.01, 0.05, 0.2 };
+
+#define BENCH_FAILURE_RATES (int)(sizeof(bench_failureRates)/sizeof(bench_failureRates[0]))
+
+static const struct
+{
+	const char *name;
+	retryPolicy policy;
+} bench_retryPolicies[] = {
+	{ "no retry", { 0, 0, 0, 0 } },
+	{ "3x200us/40ms", { 3, 200000L, 40000000LL, 0 } },
+};
+
+#define BENCH_RETRY_POLICIES (int)(sizeof(bench_retryPolicies)/sizeof(bench_retryPolicies[0]))
+
+static int bench_compareLatency(const void *a,const void *b)
+{
+	long long x = *(const long long *)a, y = *(const long long *)b;
+
+	return (x > y) - (x < y);
+}
+
+int bench_retry(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	long long *latency, begin;
+	int r, p, i, done, samples = bench_samples*5;
+
+	latency = malloc(samples*sizeof(long long));
+	if (!latency)
+		return 1;
+
+	printf("%-8s %-14s %8s %9s %9s %9s %8s %9s %11s\n","nack","policy","done %","mean ms","p99 ms","max ms","retries","exhausted","retry ms");
+	for (r=0;r<BENCH_FAILURE_RATES;r++)
+	{
+		for (p=0;p<BENCH_RETRY_POLICIES;p++)
+		{
+			BMP085Sim_init(&sim,0x77);
+			if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,ultraLowPower))
+				goto failed;
+			BMP085_setRetryPolicy(&sensor,&bench_retryPolicies[p].policy);
+			sim.failureRate = bench_failureRates[r];
+
+			for (i=0,done=0;i<samples;i++)
+			{
+				begin = tNow();
+				done += !BMP085_takeMeasurement(&sensor);
+				latency[i] = tNow() - begin;
+			}
+			qsort(latency,samples,sizeof(long long),bench_compareLatency);
+			for (i=0,begin=0;i<samples;i++)
+				begin += latency[i];
+
+			printf("%-8.2f %-14s %8.1f %9.2f %9.2f %9.2f %8lu %9lu %11.3f\n",bench_failureRates[r],bench_retryPolicies[p].name,
+				100.0*done/samples,begin/1e6/samples,latency[samples*99/100]/1e6,latency[samples-1]/1e6,
+				sensor.retryStats.retries,sensor.retryStats.exhausted,sensor.retryStats.maxRetryTime/1e6);
+		}
+	}
+
+	// A wedged bus recovers only through the recover operation of the transport.
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,ultraLowPower))
+		goto failed;
+	sim.wedged = 1;
+	if (!BMP085_takeMeasurement(&sensor))
+		goto failed;
+
+	BMP085_setRetryPolicy(&sensor,&(retryPolicy){ 3, 200000L, 40000000LL, 2 });
+	begin = tNow();
+	if (BMP085_takeMeasurement(&sensor) || sensor.retryStats.recoveries != 1)
+		goto failed;
+	printf("wedged bus: recovered after %lu failures, measurement %.2f ms, retrying %.3f ms\n",
+		sensor.retryStats.failures,(tNow() - begin)/1e6,sensor.retryStats.maxRetryTime/1e6);
+
+	free(latency);
+	return 0;
+
+failed:
+	free(latency);
+	return 1;
+}
@@ -0,0 +1,73 @@
+/*
+ * BMP085 library
+ * bench/bench_reuse.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Measures the pressure sample rate with different temperature reuse
+ * policies. The simulated temperature rises by 0.1 degrees Celsius every
+ * 10 samples, so the drift threshold is exercised as well. A drift limit
+ * alone must still refresh the temperature every BMP085_DEFAULT_MAX_AGE.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "bmp085sim.h"
+
+static const struct
+{
+	const char *name;
+	temperaturePolicy policy;
+} bench_policies[] = {
+	{ "every sample", { 0, 0, 0 } },
+	{ "10 samples", { 10, 0, 0 } },
+	{ "100ms", { 0, 100, 0 } },
+	{ "100 samples/100ms", { 100, 100, 0 } },
+	{ "20 samples/drift", { 20, 0, 1 } },
+	{ "drift", { 0, 0, 1 } },
+};
+
+#define BENCH_POLICY_COUNT (int)(sizeof(bench_policies)/sizeof(bench_policies[0]))
+
+int bench_reuse(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	long long begin, end;
+	int oss, p, i, samples = bench_samples*2;
+
+	printf("%-20s %-18s %10s %8s %8s %10s\n","mode","policy","samples/s","trans","bytes","refreshes");
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss+=ultraHighResolution)
+	{
+		for (p=0;p<BENCH_POLICY_COUNT;p++)
+		{
+			BMP085Sim_init(&sim,0x77);
+			if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,oss))
+				return 1;
+			BMP085_setTemperaturePolicy(&sensor,&bench_policies[p].policy);
+			BMP085Sim_resetCounters(&sim);
+
+			begin = tNow();
+			for (i=0;i<samples;i++)
+			{
+				BMP085Sim_setEnvironment(&sim,150+i/10,69964);
+				if (BMP085_takeMeasurement(&sensor))
+					return 1;
+			}
+			end = tNow();
+
+			printf("%-20s %-18s %10.1f %8.1f %8.1f %10lu\n",bench_ossName[oss],bench_policies[p].name,
+				samples*1e9/(end-begin),(double)(sim.reads+sim.writes)/samples,
+				(double)(sim.bytesRead+sim.bytesWritten)/samples,sim.writes-samples);
+			if (!bench_policies[p].policy.maxSamples && !bench_policies[p].policy.maxAge &&
+				sim.writes-samples < (unsigned long)((end-begin)/(BMP085_DEFAULT_MAX_AGE*1000000LL)))
+				return 1;
+		}
+	}
+
+	return 0;
+}
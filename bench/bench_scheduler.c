@@ -0,0 +1,122 @@
+/*
+ * BMP085 library
+ * bench/bench_scheduler.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Compares a sampling loop that sleeps a relative period after every
+ * measurement with BMP085Scheduler driven from an epoll loop. Reports the
+ * achieved period, the accumulated drift, the jitter of the intervals
+ * between sample starts and the missed deadlines when the period is shorter than a measurement.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085scheduler.h"
+
+static void bench_schedulerReport(const char *name,long long period,long long *starts,int count,unsigned long missed,long long maxLateness)
+{
+	double interval, sum = 0, sumSquares = 0, mean;
+	int i, first = 0, last = count - 1, intervals = 0;
+
+	// Slots of missed deadlines are left at 0 and only consecutive samples give an interval.
+	while (!starts[last])
+		last--;
+	for (i=1;i<=last;i++)
+	{
+		if (!starts[i] || !starts[i-1])
+			continue;
+		interval = (starts[i] - starts[i-1])/1e6;
+		sum += interval;
+		sumSquares += interval*interval;
+		intervals++;
+	}
+	mean = sum/intervals;
+
+	printf("%-18s %9.1f %9.3f %9.2f %9.3f %7lu %9.3f\n",name,period/1e6,(starts[last] - starts[first])/1e6/(last - first),
+		(starts[last] - starts[first] - (long long)(last - first)*period)/1e6,sqrt(sumSquares/intervals - mean*mean),missed,maxLateness/1e6);
+}
+
+static int bench_schedulerRun(BMP085 *sensor,long long period,long long *starts,int count,const char *name)
+{
+	BMP085Scheduler scheduler;
+	struct epoll_event event, ready;
+	int epoll, n = 0;
+
+	if (BMP085Scheduler_init(&scheduler,period,0))
+		return 1;
+	epoll = epoll_create1(0);
+	event.events = EPOLLIN;
+	event.data.fd = BMP085Scheduler_fd(&scheduler);
+	if (epoll < 0 || epoll_ctl(epoll,EPOLL_CTL_ADD,event.data.fd,&event))
+		return 1;
+
+	while (n < count)
+	{
+		if (epoll_wait(epoll,&ready,1,-1) != 1)
+			continue;
+		if (BMP085Scheduler_acknowledge(&scheduler) != 1)
+			continue;
+		// Index the start time by deadline, so the missed deadlines do not distort the grid.
+		n = scheduler.expirations - 1;
+		if (n >= count)
+			break;
+		starts[n] = tNow();
+		if (BMP085_takeMeasurement(sensor))
+			return 1;
+		n++;
+	}
+
+	bench_schedulerReport(name,period,starts,count,scheduler.missed,scheduler.maxLateness);
+	BMP085Scheduler_destroy(&scheduler);
+	close(epoll);
+
+	return 0;
+}
+
+int bench_scheduler(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	int count = bench_samples * 5, i;
+	long long starts[count];
+	long long period = 20000000LL;
+
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,standard))
+		return 1;
+
+	printf("%s mode, %d periods\n",bench_ossName[standard],count);
+	printf("%-18s %9s %9s %9s %9s %7s %9s\n","loop","period ms","mean ms","drift ms","jitter ms","missed","late ms");
+
+	// Relative sleep after each measurement: the bus and conversion time adds to every period.
+	for (i=0;i<count;i++)
+	{
+		starts[i] = tNow();
+		if (BMP085_takeMeasurement(&sensor))
+			return 1;
+		tDelay(period);
+	}
+	bench_schedulerReport("relative tDelay",period,starts,count,0,0);
+
+	for (i=0;i<count;i++)
+		starts[i] = 0;
+	if (bench_schedulerRun(&sensor,period,starts,count,"scheduler + epoll"))
+		return 1;
+
+	// A period shorter than one measurement: deadlines are missed and reported.
+	for (i=0;i<count;i++)
+		starts[i] = 0;
+	if (bench_schedulerRun(&sensor,period/2,starts,count,"scheduler overload"))
+		return 1;
+
+	return 0;
+}
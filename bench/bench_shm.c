@@ -0,0 +1,184 @@
+/*
+ * BMP085 library
+ * bench/bench_shm.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Measures the cost of reading the latest sample from the shared memory
+ * segment, alone and while a publisher updates the segment as fast as it
+ * can, checking every copy for torn samples. Then samples the simulated
+ * sensor at 100 Hz into the segment while reader threads poll it, and
+ * reports the poll rate and the bus transactions per sample.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085shm.h"
+
+#define BENCH_SHM_READS 2000000L
+#define BENCH_SHM_READERS 4
+#define BENCH_SHM_PERIOD 10000000LL
+
+typedef struct
+{
+	BMP085ShmClient client;
+	volatile int *running;
+	int check;
+	unsigned long reads;
+	unsigned long torn;
+	unsigned long failed;
+} benchReader;
+
+/* Fills every member of a sample from its sequence number, so torn copies can be detected. */
+static void bench_shmSample(BMP085Sample *sample,unsigned long sequence)
+{
+	sample->sequence = sequence;
+	sample->timestamp = (long long)sequence * 3;
+	sample->temperatureTimestamp = (long long)sequence * 5;
+	sample->rawTemperature = sequence & 0xFFFF;
+	sample->rawPressure = sequence & 0x7FFFF;
+	sample->temperature = (int32_t)(sequence * 7);
+	sample->pressure = (int32_t)(sequence * 11);
+	sample->oss = sequence & 3;
+}
+
+static int bench_shmConsistent(const BMP085Sample *sample)
+{
+	BMP085Sample expected;
+
+	bench_shmSample(&expected,sample->sequence);
+	return sample->timestamp == expected.timestamp && sample->temperatureTimestamp == expected.temperatureTimestamp &&
+		sample->rawTemperature == expected.rawTemperature && sample->rawPressure == expected.rawPressure &&
+		sample->temperature == expected.temperature && sample->pressure == expected.pressure && sample->oss == expected.oss;
+}
+
+static void *bench_shmReader(void *argument)
+{
+	benchReader *reader = (benchReader *)argument;
+	BMP085Sample sample;
+
+	while (*(reader->running))
+	{
+		if (BMP085ShmClient_latest(&(reader->client),&sample))
+			reader->failed++;
+		else if (reader->check && !bench_shmConsistent(&sample))
+			reader->torn++;
+		reader->reads++;
+	}
+	return NULL;
+}
+
+int bench_shm(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	BMP085ShmPublisher publisher;
+	benchReader readers[BENCH_SHM_READERS];
+	pthread_t threads[BENCH_SHM_READERS];
+	BMP085Sample sample;
+	volatile int running;
+	char name[64];
+	long long begin, end;
+	unsigned long reads, failed, published;
+	long i;
+	int r, result = 1;
+
+	memset(readers,0,sizeof(readers));
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,standard))
+		return 1;
+	snprintf(name,sizeof(name),"/bmp085bench-%d",(int)getpid());
+	if (BMP085ShmPublisher_open(&publisher,name,&sensor,BENCH_SHM_PERIOD))
+		return 1;
+	for (r=0;r<BENCH_SHM_READERS;r++)
+		if (BMP085ShmClient_open(&(readers[r].client),name))
+			goto done;
+
+	// Uncontended reads of the latest sample.
+	bench_shmSample(&sample,1);
+	BMP085ShmPublisher_publish(&publisher,&sample);
+	begin = tNow();
+	for (i=0;i<BENCH_SHM_READS;i++)
+		if (BMP085ShmClient_latest(&(readers[0].client),&sample))
+			goto done;
+	end = tNow();
+	printf("latest sample, no publisher: %.1f ns per read\n",(double)(end-begin)/BENCH_SHM_READS);
+
+	// A publisher updating the segment back to back, one reader thread checking every copy.
+	running = 1;
+	readers[0].running = &running;
+	readers[0].check = 1;
+	readers[0].reads = readers[0].torn = readers[0].failed = 0;
+	if (pthread_create(&threads[0],NULL,bench_shmReader,&readers[0]))
+		goto done;
+	begin = tNow();
+	for (published=2;tNow() - begin < 500000000LL;published++)
+	{
+		bench_shmSample(&sample,published);
+		BMP085ShmPublisher_publish(&publisher,&sample);
+	}
+	end = tNow();
+	running = 0;
+	pthread_join(threads[0],NULL);
+	printf("publisher at full speed: %.1f M updates/s, reader %.1f M reads/s, %lu torn, %lu failed\n",
+		published/((end-begin)/1e3),readers[0].reads/((end-begin)/1e3),readers[0].torn,readers[0].failed);
+	if (readers[0].torn)
+		goto done;
+
+	// The simulated sensor sampled at 100 Hz into the segment while readers poll it, the copies are not checked.
+	BMP085Sim_resetCounters(&sim);
+	running = 1;
+	for (r=0;r<BENCH_SHM_READERS;r++)
+	{
+		readers[r].running = &running;
+		readers[r].check = 0;
+		readers[r].reads = readers[r].torn = readers[r].failed = 0;
+		if (pthread_create(&threads[r],NULL,bench_shmReader,&readers[r]))
+		{
+			running = 0;
+			while (r--)
+				pthread_join(threads[r],NULL);
+			goto done;
+		}
+	}
+	begin = tNow();
+	for (i=0;i<bench_samples;i++)
+	{
+		tDelayUntil(begin + i*BENCH_SHM_PERIOD);
+		if (BMP085_takeMeasurement(&sensor))
+			BMP085ShmPublisher_failed(&publisher);
+		else
+		{
+			BMP085Stream_sample(&sensor,&sample);
+			sample.sequence = i;
+			BMP085ShmPublisher_publish(&publisher,&sample);
+		}
+	}
+	end = tNow();
+	running = 0;
+	for (r=0,reads=0,failed=0;r<BENCH_SHM_READERS;r++)
+	{
+		pthread_join(threads[r],NULL);
+		reads += readers[r].reads;
+		failed += readers[r].failed;
+	}
+	if (BMP085ShmClient_history(&(readers[0].client),&sample,1) != 1 || sample.sequence != (unsigned long)bench_samples - 1)
+		goto done;
+	printf("100 Hz daemon, %d readers: %.1f M polls/s in total, %.1f bus transactions per sample, %lu failed reads\n",
+		BENCH_SHM_READERS,reads/((end-begin)/1e3),(double)(sim.reads + sim.writes)/bench_samples,failed);
+	result = 0;
+
+done:
+	for (r=0;r<BENCH_SHM_READERS;r++)
+		BMP085ShmClient_close(&(readers[r].client));
+	BMP085ShmPublisher_close(&publisher);
+	return result;
+}
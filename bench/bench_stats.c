@@ -0,0 +1,81 @@
+/*
+ * BMP085 library
+ * bench/bench_stats.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Measures the cost of one histogram update and of one timed
+ * instrumentation point (clock read plus update). When the library is
+ * built with BMP085_STATS it also samples a simulated sensor in every
+ * mode with Sco polling and prints the counters and latency profile
+ * collected by the library.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "libbmp085.h"
+
+#define BENCH_STATS_EVENTS 10000000L
+
+int bench_stats(void)
+{
+	BMP085Histogram histogram;
+	BMP085Stats stats;
+	long long begin, record, lap;
+	long i;
+#ifdef BMP085_STATS
+	BMP085Sim sim;
+	BMP085 sensor;
+	char name[64];
+	int oss, n;
+#endif
+
+	memset(&histogram,0,sizeof(histogram));
+	begin = tNow();
+	for (i=0;i<BENCH_STATS_EVENTS;i++)
+		BMP085Stats_record(&histogram,(i * 2654435761UL) & 0xFFFFFF);
+	record = tNow() - begin;
+	bench_consume(histogram.buckets[BMP085STATS_BUCKETS/2] + histogram.maximum);
+
+	memset(&stats,0,sizeof(stats));
+	stats.mark = tNow();
+	begin = stats.mark;
+	for (i=0;i<BENCH_STATS_EVENTS;i++)
+		BMP085Stats_lap(&stats,statsDataRead,tNow());
+	lap = tNow() - begin;
+	bench_consume(stats.latency[statsDataRead].count);
+
+	printf("histogram update: %.2f ns, timed instrumentation point: %.2f ns\n",
+		(double)record/BENCH_STATS_EVENTS,(double)lap/BENCH_STATS_EVENTS);
+
+#ifndef BMP085_STATS
+	printf("library built without BMP085_STATS, run make clean && make bench STATS=1 for the latency profile\n");
+	return 0;
+#else
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		BMP085Sim_init(&sim,0x77);
+		if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,oss))
+			return 1;
+		BMP085_setEndOfConversionMode(&sensor,eocPollSco);
+		BMP085_resetStats(&sensor);
+
+		for (n=0;n<bench_samples;n++)
+			if (BMP085_takeMeasurement(&sensor))
+				return 1;
+
+		if (BMP085_getStats(&sensor,&stats) || stats.measurements != (unsigned long)bench_samples)
+			return 1;
+		snprintf(name,sizeof(name),"%s, Sco polling",bench_ossName[oss]);
+		BMP085Stats_print(&stats,name,stdout);
+	}
+
+	return 0;
+#endif
+}
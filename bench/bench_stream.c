@@ -0,0 +1,141 @@
+/*
+ * BMP085 library
+ * bench/bench_stream.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Runs the continuous sampling engine on a simulated sensor with a fast
+ * and with a slow consumer. Reports the sample rate, the spacing of the
+ * sample timestamps, the cost of the non-blocking reads and the overruns
+ * seen by the consumer as gaps in the sequence numbers. Also runs the engine
+ * on a sensor that fails every transaction and checks that it backs off.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085stream.h"
+
+#define BENCH_BATCH 64
+#define BENCH_WEDGED_TIME 1000000000LL
+
+static int bench_streamRun(const char *name,size_t capacity,long long consumerPeriod,int samples)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	BMP085Stream stream;
+	BMP085Sample batch[BENCH_BATCH];
+	long long begin, elapsed, call, readTime = 0, readMax = 0, lastTimestamp = 0;
+	unsigned long expected = 0, gaps = 0, received = 0, reads = 0, intervals = 0;
+	double interval, sum = 0, sumSquares = 0;
+	size_t n, i;
+
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,ultraLowPower))
+		return 1;
+	BMP085_setEndOfConversionMode(&sensor,eocPollSco);
+	if (BMP085Stream_init(&stream,&sensor,capacity,0) || BMP085Stream_start(&stream))
+		return 1;
+
+	begin = tNow();
+	while (received < (unsigned long)samples)
+	{
+		tDelayUntil(tNow() + consumerPeriod);
+		call = tNow();
+		n = BMP085Stream_readBatch(&stream,batch,BENCH_BATCH);
+		call = tNow() - call;
+		readTime += call;
+		if (call > readMax)
+			readMax = call;
+		reads++;
+
+		for (i=0;i<n;i++)
+		{
+			// Only consecutive samples contribute to the timestamp spacing.
+			if (lastTimestamp && batch[i].sequence == expected)
+			{
+				interval = (batch[i].timestamp - lastTimestamp)/1e6;
+				sum += interval;
+				sumSquares += interval*interval;
+				intervals++;
+			}
+			gaps += batch[i].sequence - expected;
+			expected = batch[i].sequence + 1;
+			lastTimestamp = batch[i].timestamp;
+			received++;
+		}
+	}
+	elapsed = tNow() - begin;
+	BMP085Stream_stop(&stream);
+
+	interval = sum/intervals;
+	printf("%-14s %6lu %11.1f %10.3f %8.3f %8.0f %8.0f %8lu %6lu %6lu\n",name,(unsigned long)capacity,received/(elapsed/1e9),
+		interval,sqrt(sumSquares/intervals - interval*interval),(double)readTime/reads,(double)readMax,
+		BMP085Stream_overruns(&stream),gaps,BMP085Stream_failures(&stream));
+	BMP085Stream_destroy(&stream);
+
+	// Every gap seen by the consumer must have been counted as an overrun.
+	return gaps > BMP085Stream_overruns(&stream) ? 1 : 0;
+}
+
+/* Runs continuous sampling on a sensor whose transport fails every transaction for BENCH_WEDGED_TIME. */
+static int bench_streamWedged(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	BMP085Stream stream;
+	BMP085Sample sample;
+	struct timespec cpu;
+	long long begin, cpuBegin, elapsed;
+	unsigned long failures, delivered = 0;
+
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,ultraLowPower) || BMP085Stream_init(&stream,&sensor,16,0))
+		return 1;
+	sim.wedged = 1;
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID,&cpu);
+	cpuBegin = cpu.tv_sec*1000000000LL + cpu.tv_nsec;
+	begin = tNow();
+	if (BMP085Stream_start(&stream))
+	{
+		BMP085Stream_destroy(&stream);
+		return 1;
+	}
+	tDelayUntil(begin + BENCH_WEDGED_TIME);
+	BMP085Stream_stop(&stream);
+	elapsed = tNow() - begin;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID,&cpu);
+	while (!BMP085Stream_read(&stream,&sample))
+		delivered++;
+	failures = BMP085Stream_failures(&stream);
+
+	printf("wedged sensor: %.1f failed measurements/s, %lu delivered, %.1f %% of a processor\n",failures/(elapsed/1e9),delivered,
+		100.0*(cpu.tv_sec*1000000000LL + cpu.tv_nsec - cpuBegin)/elapsed);
+	BMP085Stream_destroy(&stream);
+
+	// Every failed measurement delays the next one by a conversion time.
+	return delivered || failures > BENCH_WEDGED_TIME / BMP085_PressureConversionTime[ultraLowPower] + 2;
+}
+
+int bench_stream(void)
+{
+	int samples = bench_samples * 10;
+
+	printf("%s mode with Sco polling, %d samples per consumer\n",bench_ossName[ultraLowPower],samples);
+	printf("%-14s %6s %11s %10s %8s %8s %8s %8s %6s %6s\n","consumer","ring","delivered/s","dt ms","dt sd","read ns","max ns","overruns","gaps","failed");
+	if (bench_streamRun("fast (1 ms)",64,1000000LL,samples))
+		return 1;
+	if (bench_streamRun("slow (200 ms)",16,200000000LL,samples))
+		return 1;
+	if (bench_streamWedged())
+		return 1;
+
+	return 0;
+}
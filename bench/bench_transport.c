@@ -0,0 +1,110 @@
+/*
+ * BMP085 library
+ * bench/bench_transport.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Measures BMP085_takeMeasurement against the simulated sensor. A tracing
+ * transport sits between the library and the simulator and splits every
+ * measurement in phases:
+ *  - start: writing a conversion command in the CONTROL register;
+ *  - wait:  time between the end of a command and the next data read;
+ *  - read:  reading the conversion result;
+ *  - compensation: time between the last bus transaction and the return
+ *    from BMP085_takeMeasurement.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "bmp085sim.h"
+
+typedef struct traceBus
+{
+	BMP085Sim *sim;
+	long long lastEnd;	/* End of the last transaction. */
+	int pendingWait;	/* A conversion command was issued and no data was read yet. */
+	long long start, wait, read;	/* Accumulated phase durations in [ns]. */
+	unsigned long transactions;
+} TraceBus;
+
+static int trace_read(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+{
+	TraceBus *bus = (TraceBus *)context;
+	long long begin = bench_now();
+	int result;
+
+	if (bus->pendingWait)
+	{
+		bus->wait += begin - bus->lastEnd;
+		bus->pendingWait = 0;
+	}
+	result = BMP085Sim_busOps.read(bus->sim,I2CAddress,registry,buffer,size);
+	bus->lastEnd = bench_now();
+	bus->read += bus->lastEnd - begin;
+	bus->transactions++;
+
+	return result;
+}
+
+static int trace_write(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+{
+	TraceBus *bus = (TraceBus *)context;
+	long long begin = bench_now();
+	int result;
+
+	result = BMP085Sim_busOps.write(bus->sim,I2CAddress,registry,value);
+	bus->lastEnd = bench_now();
+	bus->start += bus->lastEnd - begin;
+	bus->pendingWait = 1;
+	bus->transactions++;
+
+	return result;
+}
+
+static const I2CBusOps trace_busOps = { .read = trace_read, .write = trace_write };
+
+int bench_transport(void)
+{
+	BMP085Sim sim;
+	BMP085 sensor;
+	TraceBus bus;
+	long long begin, end, compensation;
+	int oss, i;
+
+	printf("%-20s %10s %10s %10s %10s %10s %8s %8s\n","mode","samples/s","start us","wait us","read us","comp ns","trans","bytes");
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		BMP085Sim_init(&sim,0x77);
+		bus = (TraceBus) { .sim = &sim };
+		if (BMP085_initSensorOnBus(&sensor,&trace_busOps,&bus,0x77,oss))
+			return 1;
+
+		bus = (TraceBus) { .sim = &sim };
+		BMP085Sim_resetCounters(&sim);
+		compensation = 0;
+		begin = bench_now();
+		for (i=0;i<bench_samples;i++)
+		{
+			if (BMP085_takeMeasurement(&sensor))
+				return 1;
+			compensation += bench_now() - bus.lastEnd;
+		}
+		end = bench_now();
+
+		printf("%-20s %10.1f %10.2f %10.2f %10.2f %10.1f %8.1f %8.1f\n",bench_ossName[oss],
+			bench_samples*1e9/(end-begin),
+			bus.start/1e3/bench_samples,bus.wait/1e3/bench_samples,bus.read/1e3/bench_samples,
+			(double)compensation/bench_samples,
+			(double)bus.transactions/bench_samples,
+			(double)(sim.bytesRead+sim.bytesWritten)/bench_samples);
+		if (sim.earlyReads)
+			printf("  %lu reads before the end of the conversion\n",sim.earlyReads);
+	}
+	printf("Last sample: %.1f C, %ld Pa\n",sensor.temperature,sensor.pressure);
+
+	return 0;
+}
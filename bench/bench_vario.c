@@ -0,0 +1,266 @@
+/*
+ * BMP085 library
+ * bench/bench_vario.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ *
+ * Records a flight profile (still, a climb at 3 m/s, still again) sampled
+ * back to back on a virtual timeline into a raw sample log, in every over
+ * sampling mode, and replays it through differencing of successive altitudes
+ * and through the vertical speed estimator with several accelerations.
+ * Reports the speed noise while still, the speed error during the climb,
+ * both with the datasheet noise, and the time to reach 90 % of the climb
+ * rate on a replay without noise. Also measures the cost of an update.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
+#include "bench.h"
+#include "bmp085sim.h"
+#include "bmp085log.h"
+#include "bmp085batch.h"
+#include "bmp085vario.h"
+
+#define BENCH_VARIO_PHASE 10000000000LL	/* Length of every phase in [ns]. */
+#define BENCH_VARIO_CLIMB 3.0	/* Vertical speed during the climb in [m/s]. */
+#define BENCH_VARIO_SETTLE 2000000000LL	/* Excluded from the still noise at the start and after the climb in [ns]. */
+#define BENCH_VARIO_BASELINE 100000.0
+#define BENCH_VARIO_ESTIMATORS 5
+#define BENCH_VARIO_UPDATES 1000000
+
+static const char *bench_varioName[BENCH_VARIO_ESTIMATORS] = { "BMP085_Altitude difference", "calculateAltitude difference",
+	"estimator, 0.1 m^2/s^3", "estimator, 1 m^2/s^3", "estimator, 10 m^2/s^3" };
+static const double bench_varioAcceleration[BENCH_VARIO_ESTIMATORS] = { 0, 0, 0.1, 1, 10 };
+
+typedef struct
+{
+	unsigned long stillCount, climbCount;
+	double stillSquares, climbSquares;
+	long long rise;	/* Time from the start of the climb to 90 % of the climb rate in [ns], -1 when not reached. */
+} bench_varioResult;
+
+/* True altitude of the profile at time t in [m]. */
+static double bench_varioTruth(long long t)
+{
+	if (t < BENCH_VARIO_PHASE)
+		return 0;
+	if (t < 2*BENCH_VARIO_PHASE)
+		return BENCH_VARIO_CLIMB*(t - BENCH_VARIO_PHASE)/1e9;
+	return BENCH_VARIO_CLIMB*BENCH_VARIO_PHASE/1e9;
+}
+
+/* Records the profile sampled back to back in one mode. */
+static int bench_varioRecord(const char *path,BMP085Sim *sim,const BMP085 *sensor,overSampling oss)
+{
+	BMP085LogWriter writer;
+	long long t = 0, start;
+	uint16_t ut;
+	uint32_t up;
+
+	unlink(path);
+	if (BMP085LogWriter_open(&writer,path,sensor))
+		return 1;
+	while (t < 3*BENCH_VARIO_PHASE)
+	{
+		start = t + BMP085_TemperatureConversionTime;
+		BMP085Sim_setEnvironment(sim,250,lround(BENCH_VARIO_BASELINE*pow(1 - bench_varioTruth(start)/44330,5.255)));
+		BMP085Sim_rawSample(sim,oss,&ut,&up);
+		if (BMP085LogWriter_append(&writer,start,ut,up,oss))
+		{
+			BMP085LogWriter_close(&writer);
+			return 1;
+		}
+		t = start + BMP085_PressureConversionTime[oss];
+	}
+	return BMP085LogWriter_close(&writer);
+}
+
+/* Replays the log through one estimator. */
+static void bench_varioReplay(const BMP085LogReader *reader,const int32_t *pressure,int estimator,bench_varioResult *result)
+{
+	BMP085Vario vario;
+	varioPolicy policy = { bench_varioAcceleration[estimator], { 6, 5, 4, 3 } };
+	double speed, last = 0, altitude, error;
+	long long t, previous = 0;
+	size_t i;
+
+	result->stillCount = result->climbCount = 0;
+	result->stillSquares = result->climbSquares = 0;
+	result->rise = -1;
+	BMP085Vario_init(&vario,&policy,BENCH_VARIO_BASELINE);
+	for (i=0;i<reader->count;i++)
+	{
+		t = reader->records[i].timestamp;
+		if (estimator >= 2)
+		{
+			BMP085Vario_update(&vario,t,pressure[i],reader->records[i].oss);
+			speed = vario.speed;
+		}
+		else
+		{
+			altitude = estimator ? BMP085_calculateAltitude(pressure[i],BENCH_VARIO_BASELINE) : BMP085_Altitude(pressure[i],BENCH_VARIO_BASELINE);
+			speed = i ? (altitude - last)/((t - previous)/1e9) : 0;
+			last = altitude;
+			previous = t;
+		}
+
+		error = speed - (bench_varioTruth(t + 1) - bench_varioTruth(t - 1))/2e-9;
+		if ((t >= BENCH_VARIO_SETTLE && t < BENCH_VARIO_PHASE) || t >= 2*BENCH_VARIO_PHASE + BENCH_VARIO_SETTLE)
+		{
+			result->stillSquares += error*error;
+			result->stillCount++;
+		}
+		else if (t >= BENCH_VARIO_PHASE && t < 2*BENCH_VARIO_PHASE)
+		{
+			result->climbSquares += error*error;
+			result->climbCount++;
+			if (result->rise < 0 && speed >= 0.9*BENCH_VARIO_CLIMB)
+				result->rise = t - BENCH_VARIO_PHASE;
+		}
+	}
+}
+
+/* Records and replays the profile in one mode, with and without noise, into one result per estimator. */
+static int bench_varioMode(const char *path,BMP085Sim *sim,const BMP085 *sensor,overSampling oss,bench_varioResult *results,
+	int32_t **pressure,size_t *count)
+{
+	bench_varioResult clean;
+	BMP085LogReader reader;
+	long long rise[BENCH_VARIO_ESTIMATORS];
+	int32_t *temperature;
+	int noisy, e;
+
+	for (noisy=0;noisy<2;noisy++)
+	{
+		sim->datasheetNoise = noisy;
+		sim->seed = 1;
+		if (bench_varioRecord(path,sim,sensor,oss) || BMP085LogReader_open(&reader,path))
+			return 1;
+		temperature = malloc(reader.count*sizeof(int32_t));
+		*pressure = realloc(*pressure,reader.count*sizeof(int32_t));
+		if (!temperature || !*pressure || BMP085LogReader_replay(&reader,0,reader.count,temperature,*pressure) != reader.count)
+		{
+			free(temperature);
+			BMP085LogReader_close(&reader);
+			return 1;
+		}
+		for (e=0;e<BENCH_VARIO_ESTIMATORS;e++)
+		{
+			if (noisy)
+			{
+				bench_varioReplay(&reader,*pressure,e,&results[e]);
+				results[e].rise = rise[e];
+			}
+			else
+			{
+				bench_varioReplay(&reader,*pressure,e,&clean);
+				rise[e] = clean.rise;
+			}
+		}
+		*count = reader.count;
+		free(temperature);
+		BMP085LogReader_close(&reader);
+	}
+	return 0;
+}
+
+/* Cost of converting and processing one sample in [ns]. */
+static double bench_varioCost(const int32_t *pressure,size_t count,int estimator)
+{
+	BMP085Vario vario;
+	volatile double sink;
+	double sum = 0, altitude, last = 0;
+	long long begin;
+	size_t i, n = 0;
+
+	BMP085Vario_init(&vario,NULL,BENCH_VARIO_BASELINE);
+	begin = tNow();
+	while (n < BENCH_VARIO_UPDATES)
+	{
+		for (i=0;i<count;i++)
+		{
+			switch (estimator)
+			{
+				case 0:
+					altitude = BMP085_Altitude(pressure[i],BENCH_VARIO_BASELINE);
+					break;
+				case 1:
+					altitude = BMP085_calculateAltitude(pressure[i],BENCH_VARIO_BASELINE);
+					break;
+				case 2:
+					altitude = BMP085_approximateAltitude(pressure[i],BENCH_VARIO_BASELINE);
+					break;
+				default:
+					BMP085Vario_update(&vario,(n + i)*9000000LL,pressure[i],ultraLowPower);
+					sum += vario.speed;
+					continue;
+			}
+			sum += altitude - last;
+			last = altitude;
+		}
+		n += count;
+	}
+	sink = sum;
+	(void)sink;
+	return (tNow() - begin)/(double)n;
+}
+
+int bench_vario(void)
+{
+	static const char *costName[] = { "BMP085_Altitude difference", "calculateAltitude difference",
+		"approximateAltitude difference", "BMP085Vario_update" };
+	bench_varioResult results[BENCH_VARIO_ESTIMATORS];
+	char path[] = "/tmp/bmp085varioXXXXXX";
+	int32_t *pressure = NULL;
+	size_t count = 0;
+	BMP085Sim sim;
+	BMP085 sensor;
+	int fd, oss, e, result = 0;
+
+	fd = mkstemp(path);
+	if (fd < 0)
+		return 1;
+	close(fd);
+
+	BMP085Sim_init(&sim,0x77);
+	if (BMP085_initSensorOnBus(&sensor,&BMP085Sim_busOps,&sim,0x77,ultraLowPower))
+		result = 1;
+
+	printf("%.0f s still, %.0f s climb at %.1f m/s, %.0f s still, back to back, replayed from a raw sample log:\n",
+		BENCH_VARIO_PHASE/1e9,BENCH_VARIO_PHASE/1e9,BENCH_VARIO_CLIMB,BENCH_VARIO_PHASE/1e9);
+	printf("%-20s %-32s %12s %12s %10s\n","mode","vertical speed","still m/s","climb m/s","90 % ms");
+	for (oss=ultraLowPower;!result && oss<=ultraHighResolution;oss++)
+	{
+		if (bench_varioMode(path,&sim,&sensor,oss,results,&pressure,&count))
+		{
+			result = 1;
+			break;
+		}
+		for (e=0;e<BENCH_VARIO_ESTIMATORS;e++)
+		{
+			printf("%-20s %-32s %12.3f %12.3f ",bench_ossName[oss],bench_varioName[e],
+				sqrt(results[e].stillSquares/results[e].stillCount),sqrt(results[e].climbSquares/results[e].climbCount));
+			if (results[e].rise < 0)
+				printf("%10s\n","-");
+			else
+				printf("%10.1f\n",results[e].rise/1e6);
+		}
+	}
+
+	if (!result)
+	{
+		printf("\ncost of one sample, %d samples:\n",BENCH_VARIO_UPDATES);
+		for (e=0;e<4;e++)
+			printf("%-32s %8.1f ns\n",costName[e],bench_varioCost(pressure,count,e));
+	}
+
+	free(pressure);
+	unlink(path);
+	return result;
+}
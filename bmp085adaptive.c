@@ -0,0 +1,173 @@
+/*
+ * BMP085 library
+ * bmp085adaptive.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085adaptive.c
+ *  @brief Implements the functions defined in the header file bmp085adaptive.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085adaptive.h"
+
+#include <string.h>
+#include <math.h>
+
+static const char *BMP085Adaptive_modeName[] = { "ultraLowPower", "standard", "highResolution", "ultraHighResolution" };
+
+/* Longest measurement of a mode in [ns]. */
+static long long BMP085Adaptive_cost(int oss)
+{
+	return BMP085_TemperatureConversionTime + BMP085_PressureConversionTime[oss];
+}
+
+/* Most precise mode within the latency and duty budgets; ultraLowPower is always allowed. */
+static overSampling BMP085Adaptive_allowed(const BMP085Adaptive *adaptive)
+{
+	const adaptivePolicy *policy = &(adaptive->policy);
+	int oss;
+
+	for (oss=ultraHighResolution;oss>ultraLowPower;oss--)
+	{
+		if (policy->latencyBudget && BMP085Adaptive_cost(oss) > policy->latencyBudget)
+			continue;
+		if (policy->dutyBudget && adaptive->interval && BMP085Adaptive_cost(oss) * 1000 > (long long)policy->dutyBudget * adaptive->interval)
+			continue;
+		break;
+	}
+	return oss;
+}
+
+/* Least squares slope of the recent samples within the window, in [Pa/s]. */
+static double BMP085Adaptive_slope(const BMP085Adaptive *adaptive)
+{
+	unsigned int i, slot, last = (adaptive->position + BMP085ADAPTIVE_HISTORY - 1) % BMP085ADAPTIVE_HISTORY;
+	double x, y, n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0, denominator;
+
+	for (i=0;i<adaptive->count;i++)
+	{
+		slot = (last + BMP085ADAPTIVE_HISTORY - i) % BMP085ADAPTIVE_HISTORY;
+		if (adaptive->timestamps[last] - adaptive->timestamps[slot] > adaptive->policy.window)
+			break;
+		// Relative to the last sample, so the sums stay small.
+		x = (adaptive->timestamps[slot] - adaptive->timestamps[last]) / 1e9;
+		y = adaptive->pressures[slot] - adaptive->pressures[last];
+		n++;
+		sx += x;
+		sy += y;
+		sxx += x * x;
+		sxy += x * y;
+	}
+
+	denominator = n * sxx - sx * sx;
+	if (n < 3 || denominator <= 0)
+		return 0;
+	return (n * sxy - sx * sy) / denominator;
+}
+
+/* Initializes the controller. */
+int BMP085Adaptive_init(BMP085Adaptive *adaptive,const adaptivePolicy *policy,overSampling initial)
+{
+	memset(adaptive,0,sizeof(BMP085Adaptive));
+	if (policy)
+		adaptive->policy = *policy;
+	else
+	{
+		adaptive->policy.fastRate = BMP085ADAPTIVE_FAST_RATE;
+		adaptive->policy.slowRate = BMP085ADAPTIVE_SLOW_RATE;
+		adaptive->policy.holdSamples = BMP085ADAPTIVE_HOLD_SAMPLES;
+		adaptive->policy.window = BMP085ADAPTIVE_WINDOW;
+	}
+	if (adaptive->policy.slowRate >= adaptive->policy.fastRate)
+		return 1;
+
+	adaptive->mode = initial;
+	if (adaptive->mode > BMP085Adaptive_allowed(adaptive))
+		adaptive->mode = BMP085Adaptive_allowed(adaptive);
+	return 0;
+}
+
+/* Mode of the next sample. */
+overSampling BMP085Adaptive_mode(const BMP085Adaptive *adaptive)
+{
+	return adaptive->mode;
+}
+
+/* Feeds a completed sample and selects the next mode. */
+void BMP085Adaptive_record(BMP085Adaptive *adaptive,long long timestamp,int32_t pressure,overSampling oss,long long duration)
+{
+	const adaptivePolicy *policy = &(adaptive->policy);
+	unsigned int last = (adaptive->position + BMP085ADAPTIVE_HISTORY - 1) % BMP085ADAPTIVE_HISTORY;
+	long long interval;
+	double rate;
+	int desired, allowed;
+
+	adaptive->summary.samples[oss]++;
+	adaptive->summary.time[oss] += duration;
+	if (adaptive->count)
+	{
+		interval = timestamp - adaptive->timestamps[last];
+		adaptive->interval = adaptive->interval ? adaptive->interval + (interval - adaptive->interval) / 4 : interval;
+	}
+
+	adaptive->timestamps[adaptive->position] = timestamp;
+	adaptive->pressures[adaptive->position] = pressure;
+	adaptive->position = (adaptive->position + 1) % BMP085ADAPTIVE_HISTORY;
+	if (adaptive->count < BMP085ADAPTIVE_HISTORY)
+		adaptive->count++;
+	adaptive->held++;
+
+	// Map the rate linearly from the most precise mode at slowRate to the fastest at fastRate.
+	adaptive->rate = BMP085Adaptive_slope(adaptive);
+	rate = fabs(adaptive->rate);
+	if (rate >= policy->fastRate)
+		desired = ultraLowPower;
+	else if (rate <= policy->slowRate)
+		desired = ultraHighResolution;
+	else
+		desired = (int)lround(ultraHighResolution * (policy->fastRate - rate) / (policy->fastRate - policy->slowRate));
+	allowed = BMP085Adaptive_allowed(adaptive);
+	if (desired > allowed)
+		desired = allowed;
+
+	if (desired == (int)adaptive->mode || (desired > (int)adaptive->mode && adaptive->held < policy->holdSamples))
+		return;
+	adaptive->mode = desired;
+	adaptive->held = 0;
+	adaptive->summary.switches++;
+}
+
+/* Measures in the selected mode and records the sample. */
+int BMP085Adaptive_takeMeasurement(BMP085Adaptive *adaptive,BMP085 *sensor)
+{
+	long long begin = tNow();
+
+	BMP085_setOverSampling(sensor,adaptive->mode);
+	if (BMP085_takeMeasurement(sensor))
+		return 1;
+
+	BMP085Adaptive_record(adaptive,sensor->conversionStart,sensor->pressure,sensor->conversionOss,tNow() - begin);
+	return 0;
+}
+
+/* Prints the samples and the time per mode. */
+void BMP085Adaptive_printSummary(const BMP085Adaptive *adaptive,FILE *output)
+{
+	const adaptiveSummary *summary = &(adaptive->summary);
+	long long total = 0;
+	int oss;
+
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+		total += summary->time[oss];
+
+	fprintf(output,"Adaptive over sampling: %lu mode switches, last rate of change %.1f Pa/s\n",summary->switches,adaptive->rate);
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+		fprintf(output,"  %-20s %8lu samples %12.1f ms (%5.1f%%)\n",BMP085Adaptive_modeName[oss],summary->samples[oss],
+			summary->time[oss]/1e6,total ? 100.0*summary->time[oss]/total : 0.0);
+}
@@ -0,0 +1,148 @@
+/*
+ * BMP085 library
+ * bmp085adaptive.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085adaptive.h
+  * @brief
+  * Header file part of libBMP085 library. It defines a controller that selects
+  * the over sampling mode of every sample from the rate of change of the pressure.
+  *
+  * While the pressure is steady the most precise mode allowed by the budgets is
+  * used. When the pressure changes quickly, for example during a fast climb, the
+  * controller switches to faster modes, which give more samples per second and
+  * less lag. The rate of change is the least squares slope of the recent samples.
+  * A faster mode is selected at once, a slower one only after the current mode
+  * was kept for holdSamples samples.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085ADAPTIVE_H_
+#define BMP085ADAPTIVE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085ADAPTIVE_DEF Adaptive over sampling definitions */
+/* @{ */
+#define BMP085ADAPTIVE_HISTORY 64	/**< Samples kept for estimating the rate of change. */
+#define BMP085ADAPTIVE_FAST_RATE 320	/**< Default fastRate in [Pa/s], about 27 m/s near sea level. */
+#define BMP085ADAPTIVE_SLOW_RATE 40	/**< Default slowRate in [Pa/s], about 3 m/s near sea level. */
+#define BMP085ADAPTIVE_HOLD_SAMPLES 8	/**< Default holdSamples. */
+#define BMP085ADAPTIVE_WINDOW 500000000LL	/**< Default window in [ns]. */
+/* @} */
+
+/**
+ * @brief Budgets and thresholds of the adaptive over sampling controller.
+ */
+typedef struct adaptivepolicy
+{
+	long long latencyBudget;	/**< Longest allowed measurement in [ns], the maximum temperature and pressure conversion times of a mode; 0 disables the limit. */
+	unsigned int dutyBudget;	/**< Permille of the time between two samples the sensor may spend converting, a measure of the supply current; 0 disables the limit. */
+	long fastRate;	/**< Rate of change in [Pa/s] at and above which the fastest allowed mode is used. */
+	long slowRate;	/**< Rate of change in [Pa/s] at and below which the most precise allowed mode is used. */
+	unsigned int holdSamples;	/**< Samples a mode is kept before a slower, more precise mode is selected. */
+	long long window;	/**< Time span in [ns] of the samples used for the rate of change. */
+} adaptivePolicy;
+
+/**
+ * @brief Samples and measurement time spent in every mode.
+ */
+typedef struct adaptivesummary
+{
+	unsigned long samples[4];	/**< Samples taken in each mode, indexed by overSampling. */
+	long long time[4];	/**< Measurement time in [ns] spent in each mode, indexed by overSampling. */
+	unsigned long switches;	/**< Changes of the mode. */
+} adaptiveSummary;
+
+/**
+ * @brief State of the adaptive over sampling controller.
+ */
+typedef struct bmp085adaptive
+{
+	adaptivePolicy policy;	/**< Budgets and thresholds. */
+	overSampling mode;	/**< Mode of the next sample. */
+	unsigned int held;	/**< Samples taken in the current mode. */
+	double rate;	/**< Last estimate of the rate of change in [Pa/s]. */
+	long long interval;	/**< Average time between two samples in [ns], 0 before the second sample. */
+	long long timestamps[BMP085ADAPTIVE_HISTORY];	/**< Times of the recent samples. */
+	int32_t pressures[BMP085ADAPTIVE_HISTORY];	/**< Pressures of the recent samples in [Pa]. */
+	unsigned int count;	/**< Number of recent samples. */
+	unsigned int position;	/**< Next slot of the recent samples. */
+	adaptiveSummary summary;	/**< Samples and time per mode. */
+} BMP085Adaptive;
+
+/** \defgroup BMP085ADAPTIVE_FUNC Adaptive over sampling functions */
+/* @{ */
+
+/**
+ * @brief Initializes the controller.
+ *
+ * @param[in,out] adaptive pointer to the controller.
+ * @param[in] policy budgets and thresholds, NULL for the defaults without budgets.
+ * @param[in] initial mode of the first sample, lowered to the budgets.
+ * @return int returns 0 for successful operation, 1 when slowRate is not below fastRate.
+ */
+int BMP085Adaptive_init(BMP085Adaptive *adaptive,const adaptivePolicy *policy,overSampling initial);
+
+/**
+ * @brief Returns the mode selected for the next sample.
+ *
+ * @param[in] adaptive pointer to the controller.
+ */
+overSampling BMP085Adaptive_mode(const BMP085Adaptive *adaptive);
+
+/**
+ * @brief Feeds a completed sample to the controller and selects the mode of the next one.
+ *
+ * @param[in,out] adaptive pointer to the controller.
+ * @param[in] timestamp CLOCK_MONOTONIC time in [ns] of the sample.
+ * @param[in] pressure pressure in [Pa].
+ * @param[in] oss mode the sample was taken in.
+ * @param[in] duration time in [ns] the measurement took.
+ */
+void BMP085Adaptive_record(BMP085Adaptive *adaptive,long long timestamp,int32_t pressure,overSampling oss,long long duration);
+
+/**
+ * @brief Measures in the selected mode and feeds the result to the controller.
+ *
+ * Sets the mode of the sensor with BMP085_setOverSampling(), calls
+ * BMP085_takeMeasurement() and records the sample. The mode of the sample is
+ * in conversionOss of the sensor.
+ *
+ * @param[in,out] adaptive pointer to the controller.
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Adaptive_takeMeasurement(BMP085Adaptive *adaptive,BMP085 *sensor);
+
+/**
+ * @brief Prints the samples and the time spent in every mode.
+ *
+ * @param[in] adaptive pointer to the controller.
+ * @param[in] output stream for the summary.
+ */
+void BMP085Adaptive_printSummary(const BMP085Adaptive *adaptive,FILE *output);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085ADAPTIVE_H_ */
@@ -0,0 +1,149 @@
+/*
+ * BMP085 library
+ * bmp085arbiter.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085arbiter.c
+ *  @brief Implements the functions defined in the header file bmp085arbiter.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085arbiter.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include "I2Cbus.h"
+
+/* Takes the mutex and the lock file, counting the transactions that had to wait. */
+static int BMP085Arbiter_acquire(BMP085Arbiter *arbiter)
+{
+	long long begin = 0, wait;
+	int result;
+
+	if (pthread_mutex_trylock(&(arbiter->mutex)))
+	{
+		begin = tNow();
+		pthread_mutex_lock(&(arbiter->mutex));
+	}
+
+	if (arbiter->lockFd >= 0 && flock(arbiter->lockFd,LOCK_EX|LOCK_NB))
+	{
+		if (errno != EWOULDBLOCK)
+		{
+			pthread_mutex_unlock(&(arbiter->mutex));
+			return 1;
+		}
+		if (!begin)
+			begin = tNow();
+		while ((result = flock(arbiter->lockFd,LOCK_EX)) && errno == EINTR)
+			;
+		if (result)
+		{
+			pthread_mutex_unlock(&(arbiter->mutex));
+			return 1;
+		}
+	}
+
+	arbiter->transactions++;
+	if (begin)
+	{
+		wait = tNow() - begin;
+		arbiter->contended++;
+		arbiter->waitTime += wait;
+		if (wait > arbiter->maxWait)
+			arbiter->maxWait = wait;
+	}
+	return 0;
+}
+
+static void BMP085Arbiter_release(BMP085Arbiter *arbiter)
+{
+	if (arbiter->lockFd >= 0)
+		flock(arbiter->lockFd,LOCK_UN);
+	pthread_mutex_unlock(&(arbiter->mutex));
+}
+
+static int BMP085Arbiter_read(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+{
+	BMP085Arbiter *arbiter = (BMP085Arbiter *)context;
+	int result;
+
+	if (BMP085Arbiter_acquire(arbiter))
+		return ERROR_I2C_READ_FAILED;
+	result = arbiter->busOps->read(arbiter->busContext,I2CAddress,registry,buffer,size);
+	BMP085Arbiter_release(arbiter);
+	return result;
+}
+
+static int BMP085Arbiter_write(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+{
+	BMP085Arbiter *arbiter = (BMP085Arbiter *)context;
+	int result;
+
+	if (BMP085Arbiter_acquire(arbiter))
+		return ERROR_I2C_WRITE_FAILED;
+	result = arbiter->busOps->write(arbiter->busContext,I2CAddress,registry,value);
+	BMP085Arbiter_release(arbiter);
+	return result;
+}
+
+static int BMP085Arbiter_recover(void *context)
+{
+	BMP085Arbiter *arbiter = (BMP085Arbiter *)context;
+	int result;
+
+	if (!arbiter->busOps->recover || BMP085Arbiter_acquire(arbiter))
+		return ERROR_OPEN_I2C_BUS;
+	result = arbiter->busOps->recover(arbiter->busContext);
+	BMP085Arbiter_release(arbiter);
+	return result;
+}
+
+const I2CBusOps BMP085Arbiter_busOps = { .read = BMP085Arbiter_read, .write = BMP085Arbiter_write, .recover = BMP085Arbiter_recover };
+
+/* Initializes an arbiter. */
+int BMP085Arbiter_init(BMP085Arbiter *arbiter,const I2CBusOps *busOps,void *busContext,const char *lockPath)
+{
+	if (busOps->measure)
+		return 1;
+
+	arbiter->busOps = busOps;
+	arbiter->busContext = busContext;
+	arbiter->lockFd = -1;
+	if (lockPath && (arbiter->lockFd = open(lockPath,O_RDONLY|O_CREAT|O_CLOEXEC,0666)) < 0)
+		return 1;
+	if (pthread_mutex_init(&(arbiter->mutex),NULL))
+	{
+		if (arbiter->lockFd >= 0)
+			close(arbiter->lockFd);
+		return 1;
+	}
+	BMP085Arbiter_resetCounters(arbiter);
+	return 0;
+}
+
+/* Clears the contention counters. */
+void BMP085Arbiter_resetCounters(BMP085Arbiter *arbiter)
+{
+	arbiter->transactions = 0;
+	arbiter->contended = 0;
+	arbiter->waitTime = 0;
+	arbiter->maxWait = 0;
+}
+
+/* Releases the mutex and the lock file. */
+void BMP085Arbiter_destroy(BMP085Arbiter *arbiter)
+{
+	pthread_mutex_destroy(&(arbiter->mutex));
+	if (arbiter->lockFd >= 0)
+		close(arbiter->lockFd);
+	arbiter->lockFd = -1;
+}
@@ -0,0 +1,112 @@
+/*
+ * BMP085 library
+ * bmp085arbiter.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085arbiter.h
+  * @brief
+  * Header file part of libBMP085 library. It defines a transport that
+  * arbitrates the access of several threads and processes to one I2C adapter.
+  *
+  * On adapters without plain I2C transfers a register read over i2c-dev is an
+  * I2C_SLAVE ioctl, a write() and a read(). Two threads sharing the bus
+  * descriptor, or two processes using different devices on the same adapter,
+  * can interleave these steps and read the registers of another device. The
+  * arbiter wraps another transport and holds an in-process mutex, and optionally
+  * an flock() on the adapter, for every transaction. The lock is never held
+  * across a conversion wait, so concurrent users keep overlapping their conversions.
+  *
+  * The arbiter does not protect a sensor from a second user. A conversion started
+  * by another thread or process between the start of a measurement and the read
+  * of its result overwrites that result, so every sensor must have a single owner.
+  *
+  * Every user of the adapter in a process shares one arbiter. Every process
+  * initializes its own; a lock descriptor inherited across fork() does not
+  * exclude the parent.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085ARBITER_H_
+#define BMP085ARBITER_H_
+
+#include <pthread.h>
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Arbitrated transport and its contention counters.
+ *
+ * The counters are updated under the lock.
+ */
+typedef struct bmp085arbiter
+{
+	const I2CBusOps *busOps;	/**< Arbitrated transport. */
+	void *busContext;	/**< Context of the arbitrated transport. */
+	pthread_mutex_t mutex;	/**< Excludes the threads of the process. */
+	int lockFd;	/**< Descriptor locked with flock() to exclude other processes, -1 for threads only. */
+	unsigned long transactions;	/**< Transactions made through the arbiter. */
+	unsigned long contended;	/**< Transactions that found the bus held by another thread or process. */
+	long long waitTime;	/**< Total time in [ns] spent waiting for the bus. */
+	long long maxWait;	/**< Longest wait for the bus in [ns]. */
+} BMP085Arbiter;
+
+/** \defgroup BMP085ARBITER_FUNC Bus arbitration functions */
+/* @{ */
+
+/**
+ * @brief Transport operations of an arbiter.
+ *
+ * The context passed to the operations is a pointer to BMP085Arbiter. Read,
+ * write and recover of the arbitrated transport are called under the lock.
+ */
+extern const I2CBusOps BMP085Arbiter_busOps;
+
+/**
+ * @brief Initializes an arbiter.
+ *
+ * For cross-process arbitration every process passes the same \a lockPath,
+ * normally the i2c-dev device of the adapter, for example /dev/i2c-1. Any
+ * file works, and it is created when it does not exist.
+ *
+ * @param[in,out] arbiter pointer to the arbiter.
+ * @param[in] busOps arbitrated transport, for example I2CBus_devOps; transports with a measure operation are not supported.
+ * @param[in] busContext context of the arbitrated transport.
+ * @param[in] lockPath file locked for every transaction, NULL to arbitrate only the threads of the process.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Arbiter_init(BMP085Arbiter *arbiter,const I2CBusOps *busOps,void *busContext,const char *lockPath);
+
+/**
+ * @brief Clears the contention counters.
+ *
+ * @param[in,out] arbiter pointer to the arbiter.
+ */
+void BMP085Arbiter_resetCounters(BMP085Arbiter *arbiter);
+
+/**
+ * @brief Releases the mutex and the lock file of an arbiter.
+ *
+ * @param[in,out] arbiter pointer to the arbiter no longer in use.
+ */
+void BMP085Arbiter_destroy(BMP085Arbiter *arbiter);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085ARBITER_H_ */
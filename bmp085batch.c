@@ -0,0 +1,341 @@
+/*
+ * BMP085 library
+ * bmp085batch.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085batch.c
+ *  @brief Implements the functions defined in the header file bmp085batch.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085batch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BMP085_BATCH_X86
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define BMP085_BATCH_NEON
+#endif
+
+typedef void (*BMP085_batchKernel)(const BMP085Calibration *,overSampling,
+	const uint16_t *,const uint32_t *,int32_t *,int32_t *,size_t);
+typedef void (*BMP085_altitudeKernel)(const int32_t *,float *,size_t,float);
+
+/* Scalar implementation, also used for the tail of the vectorized kernels. */
+void BMP085_compensateBatchScalar(const BMP085Calibration *calibration,overSampling oss,
+	const uint16_t *rawTemperature,const uint32_t *rawPressure,
+	int32_t *temperature,int32_t *pressure,size_t count)
+{
+	int32_t b5;
+	size_t i;
+
+	for (i=0;i<count;i++)
+	{
+		temperature[i] = BMP085_calculateTemperature(calibration,rawTemperature[i],&b5);
+		pressure[i] = BMP085_calculatePressure(calibration,oss,rawPressure[i],b5);
+	}
+}
+
+#ifdef BMP085_BATCH_X86
+
+/* AVX2: four samples per iteration. */
+#define KERNEL_NAME BMP085_compensateBatchAVX2
+#define KERNEL_TARGET __attribute__((target("avx2")))
+#define V_LANES 4
+#define VEC __m256d
+#define VMASK __m256d
+#define V_SET1(x) _mm256_set1_pd(x)
+#define V_ADD(a,b) _mm256_add_pd(a,b)
+#define V_SUB(a,b) _mm256_sub_pd(a,b)
+#define V_MUL(a,b) _mm256_mul_pd(a,b)
+#define V_DIV(a,b) _mm256_div_pd(a,b)
+#define V_FLOOR(a) _mm256_floor_pd(a)
+#define V_TRUNC(a) _mm256_round_pd(a,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC)
+#define V_LT(a,b) _mm256_cmp_pd(a,b,_CMP_LT_OQ)
+#define V_GE(a,b) _mm256_cmp_pd(a,b,_CMP_GE_OQ)
+#define V_NE(a,b) _mm256_cmp_pd(a,b,_CMP_NEQ_OQ)
+#define V_AND(a,b) _mm256_and_pd(a,b)
+#define V_BLEND(m,a,b) _mm256_blendv_pd(b,a,m)
+#define V_MASK_BITS(m) _mm256_movemask_pd(m)
+#define V_LOAD_U16(p) _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)(p))))
+#define V_LOAD_I32(p) _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(p)))
+#define V_STORE_I32(p,a) _mm_storeu_si128((__m128i *)(p),_mm256_cvttpd_epi32(a))
+#include "bmp085batch_kernel.h"
+#undef KERNEL_NAME
+#undef KERNEL_TARGET
+#undef V_LANES
+#undef VEC
+#undef VMASK
+#undef V_SET1
+#undef V_ADD
+#undef V_SUB
+#undef V_MUL
+#undef V_DIV
+#undef V_FLOOR
+#undef V_TRUNC
+#undef V_LT
+#undef V_GE
+#undef V_NE
+#undef V_AND
+#undef V_BLEND
+#undef V_MASK_BITS
+#undef V_LOAD_U16
+#undef V_LOAD_I32
+#undef V_STORE_I32
+
+/* SSE4.1: two samples per iteration. */
+#define KERNEL_NAME BMP085_compensateBatchSSE41
+#define KERNEL_TARGET __attribute__((target("sse4.1")))
+#define V_LANES 2
+#define VEC __m128d
+#define VMASK __m128d
+#define V_SET1(x) _mm_set1_pd(x)
+#define V_ADD(a,b) _mm_add_pd(a,b)
+#define V_SUB(a,b) _mm_sub_pd(a,b)
+#define V_MUL(a,b) _mm_mul_pd(a,b)
+#define V_DIV(a,b) _mm_div_pd(a,b)
+#define V_FLOOR(a) _mm_floor_pd(a)
+#define V_TRUNC(a) _mm_round_pd(a,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC)
+#define V_LT(a,b) _mm_cmplt_pd(a,b)
+#define V_GE(a,b) _mm_cmpge_pd(a,b)
+#define V_NE(a,b) _mm_cmpneq_pd(a,b)
+#define V_AND(a,b) _mm_and_pd(a,b)
+#define V_BLEND(m,a,b) _mm_blendv_pd(b,a,m)
+#define V_MASK_BITS(m) _mm_movemask_pd(m)
+#define V_LOAD_U16(p) _mm_set_pd((p)[1],(p)[0])
+#define V_LOAD_I32(p) _mm_set_pd((int32_t)(p)[1],(int32_t)(p)[0])
+#define V_STORE_I32(p,a) _mm_storel_epi64((__m128i *)(p),_mm_cvttpd_epi32(a))
+#include "bmp085batch_kernel.h"
+#undef KERNEL_NAME
+#undef KERNEL_TARGET
+#undef V_LANES
+#undef VEC
+#undef VMASK
+#undef V_SET1
+#undef V_ADD
+#undef V_SUB
+#undef V_MUL
+#undef V_DIV
+#undef V_FLOOR
+#undef V_TRUNC
+#undef V_LT
+#undef V_GE
+#undef V_NE
+#undef V_AND
+#undef V_BLEND
+#undef V_MASK_BITS
+#undef V_LOAD_U16
+#undef V_LOAD_I32
+#undef V_STORE_I32
+
+#endif /* BMP085_BATCH_X86 */
+
+#ifdef BMP085_BATCH_NEON
+
+/* NEON: two samples per iteration. */
+#define KERNEL_NAME BMP085_compensateBatchNEON
+#define KERNEL_TARGET
+#define V_LANES 2
+#define VEC float64x2_t
+#define VMASK uint64x2_t
+#define V_SET1(x) vdupq_n_f64(x)
+#define V_ADD(a,b) vaddq_f64(a,b)
+#define V_SUB(a,b) vsubq_f64(a,b)
+#define V_MUL(a,b) vmulq_f64(a,b)
+#define V_DIV(a,b) vdivq_f64(a,b)
+#define V_FLOOR(a) vrndmq_f64(a)
+#define V_TRUNC(a) vrndq_f64(a)
+#define V_LT(a,b) vcltq_f64(a,b)
+#define V_GE(a,b) vcgeq_f64(a,b)
+#define V_NE(a,b) vmvnq_u32_u64(vceqq_f64(a,b))
+#define V_AND(a,b) vandq_u64(a,b)
+#define V_BLEND(m,a,b) vbslq_f64(m,a,b)
+#define V_MASK_BITS(m) (int)((vgetq_lane_u64(m,0) & 1) | ((vgetq_lane_u64(m,1) & 1) << 1))
+#define V_LOAD_U16(p) vcombine_f64(vdup_n_f64((p)[0]),vdup_n_f64((p)[1]))
+#define V_LOAD_I32(p) vcombine_f64(vdup_n_f64((int32_t)(p)[0]),vdup_n_f64((int32_t)(p)[1]))
+#define V_STORE_I32(p,a) vst1_s32(p,vmovn_s64(vcvtq_s64_f64(a)))
+#define vmvnq_u32_u64(m) vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(m)))
+#include "bmp085batch_kernel.h"
+
+#endif /* BMP085_BATCH_NEON */
+
+/*
+ * Altitude from the ratio of the pressure to the baseline pressure, 44330*(1-ratio^(1/5.255)).
+ * The ratio is split into m*2^e with m in [sqrt(0.5),sqrt(2)), ln(m) is the atanh series
+ * of u=(m-1)/(m+1) with |u| < 0.172 and 1-ratio^(1/5.255) is evaluated as -expm1(ln(ratio)/5.255)
+ * with a Taylor polynomial, which avoids the cancellation of 1-pow(). Branch free, so the
+ * loops below are vectorized by the compiler.
+ */
+static inline float BMP085_altitudeFromRatio(float ratio)
+{
+	union { float f; int32_t i; } bits = { ratio };
+	float m, u, u2, z;
+	int32_t exponent;
+
+	exponent = (bits.i - 0x3F3504F3) >> 23;
+	bits.i -= exponent * (1 << 23);
+	m = bits.f;
+	u = (m - 1.0f) / (m + 1.0f);
+	u2 = u*u;
+	z = (exponent * 0.693147182f + 2.0f*u*(1.0f + u2*(1.0f/3 + u2*(1.0f/5 + u2*(1.0f/7))))) * (1.0f/5.255f);
+	return -44330.0f * z*(1.0f + z*(1.0f/2 + z*(1.0f/6 + z*(1.0f/24 + z*(1.0f/120 + z*(1.0f/720 + z*(1.0f/5040)))))));
+}
+
+#define BMP085_ALTITUDE_LOOP \
+	float scale = 1.0f / baseLinePressure; \
+	size_t i; \
+	for (i=0;i<count;i++) \
+		altitude[i] = BMP085_altitudeFromRatio(pressure[i] * scale);
+
+static void BMP085_approximateAltitudeDefault(const int32_t *pressure,float *altitude,size_t count,float baseLinePressure)
+{
+	BMP085_ALTITUDE_LOOP
+}
+
+#ifdef BMP085_BATCH_X86
+static __attribute__((target("avx2"))) void BMP085_approximateAltitudeAVX2(const int32_t *pressure,float *altitude,size_t count,float baseLinePressure)
+{
+	BMP085_ALTITUDE_LOOP
+}
+#endif
+
+/* Fast altitude approximation, identical to one element of BMP085_approximateAltitudeBatch(). */
+float BMP085_approximateAltitude(float pressure,float baseLinePressure)
+{
+	return BMP085_altitudeFromRatio(pressure * (1.0f / baseLinePressure));
+}
+
+/* Calibration example from the Bosch datasheet, used for timing the kernels. */
+static const unsigned char BMP085_trialTable[22] = {
+	0x01, 0x98, 0xFF, 0xB8, 0xC7, 0xD1, 0x7F, 0xE5, 0x7F, 0xF5, 0x5A, 0x71,
+	0x18, 0x2E, 0x00, 0x04, 0x80, 0x00, 0xDD, 0xF9, 0x0B, 0x34 };
+#define BMP085_TRIAL_SAMPLES 512
+#define BMP085_TRIAL_ROUNDS 5
+
+/* Shortest time of a kernel on a batch of realistic raw values in one mode. */
+static long long BMP085_timeKernel(BMP085_batchKernel kernel,const BMP085Calibration *calibration,overSampling oss)
+{
+	uint16_t rawTemperature[BMP085_TRIAL_SAMPLES];
+	uint32_t rawPressure[BMP085_TRIAL_SAMPLES];
+	int32_t temperature[BMP085_TRIAL_SAMPLES], pressure[BMP085_TRIAL_SAMPLES];
+	unsigned long seed = 1;
+	long long begin, elapsed, best = 0;
+	int i;
+
+	for (i=0;i<BMP085_TRIAL_SAMPLES;i++)
+	{
+		seed = seed * 1103515245UL + 12345UL;
+		rawTemperature[i] = 25000 + (seed >> 16) % 6000;
+		rawPressure[i] = (20000UL << oss) + (seed >> 8) % (20000UL << oss);
+	}
+	// The first round only warms up the caches and the branch predictors.
+	for (i=-1;i<BMP085_TRIAL_ROUNDS;i++)
+	{
+		begin = tNow();
+		kernel(calibration,oss,rawTemperature,rawPressure,temperature,pressure,BMP085_TRIAL_SAMPLES);
+		elapsed = tNow() - begin;
+		if (!i || (i > 0 && elapsed < best))
+			best = elapsed;
+	}
+	return best;
+}
+
+static BMP085_batchKernel BMP085_selectedKernel[4];
+static const char *BMP085_selectedKernelName[4];
+static BMP085_altitudeKernel BMP085_selectedAltitudeKernel;
+static const char *BMP085_vectorKernelName;
+
+/*
+ * Selects the kernel supported by the processor, then keeps it only for the modes
+ * where it beats the scalar functions. The divisions of the double precision lanes
+ * are slow on some processors, where the vector kernel loses to the scalar one.
+ */
+static void BMP085_selectKernel(void)
+{
+	BMP085_batchKernel kernel = BMP085_compensateBatchScalar;
+	BMP085_altitudeKernel altitudeKernel = BMP085_approximateAltitudeDefault;
+	BMP085Calibration calibration;
+	const char *name = "scalar";
+	int oss, vector;
+
+#ifdef BMP085_BATCH_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		kernel = BMP085_compensateBatchAVX2;
+		altitudeKernel = BMP085_approximateAltitudeAVX2;
+		name = "avx2";
+	}
+	else if (__builtin_cpu_supports("sse4.1"))
+	{
+		kernel = BMP085_compensateBatchSSE41;
+		name = "sse4.1";
+	}
+#endif
+#ifdef BMP085_BATCH_NEON
+	kernel = BMP085_compensateBatchNEON;
+	name = "neon";
+#endif
+
+	BMP085_decodeCalibration(&calibration,BMP085_trialTable);
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		vector = kernel != BMP085_compensateBatchScalar &&
+			BMP085_timeKernel(kernel,&calibration,oss) < BMP085_timeKernel(BMP085_compensateBatchScalar,&calibration,oss);
+		BMP085_selectedKernelName[oss] = vector ? name : "scalar";
+		__atomic_store_n(&BMP085_selectedKernel[oss],vector ? kernel : BMP085_compensateBatchScalar,__ATOMIC_RELEASE);
+	}
+	BMP085_vectorKernelName = name;
+	__atomic_store_n(&BMP085_selectedAltitudeKernel,altitudeKernel,__ATOMIC_RELEASE);
+}
+
+/* Compensates arrays of raw samples with the selected kernel. */
+void BMP085_compensateBatch(const BMP085Calibration *calibration,overSampling oss,
+	const uint16_t *rawTemperature,const uint32_t *rawPressure,
+	int32_t *temperature,int32_t *pressure,size_t count)
+{
+	BMP085_batchKernel kernel = __atomic_load_n(&BMP085_selectedKernel[oss],__ATOMIC_ACQUIRE);
+
+	if (!kernel)
+	{
+		BMP085_selectKernel();
+		kernel = BMP085_selectedKernel[oss];
+	}
+	kernel(calibration,oss,rawTemperature,rawPressure,temperature,pressure,count);
+}
+
+/* Converts an array of pressures to altitudes with the selected kernel. */
+void BMP085_approximateAltitudeBatch(const int32_t *pressure,float *altitude,size_t count,float baseLinePressure)
+{
+	BMP085_altitudeKernel kernel = __atomic_load_n(&BMP085_selectedAltitudeKernel,__ATOMIC_ACQUIRE);
+
+	if (!kernel)
+	{
+		BMP085_selectKernel();
+		kernel = BMP085_selectedAltitudeKernel;
+	}
+	kernel(pressure,altitude,count,baseLinePressure);
+}
+
+/* Name of the kernel supported by the processor. */
+const char *BMP085_batchImplementation(void)
+{
+	if (!__atomic_load_n(&BMP085_selectedAltitudeKernel,__ATOMIC_ACQUIRE))
+		BMP085_selectKernel();
+	return BMP085_vectorKernelName;
+}
+
+/* Name of the kernel used for one mode. */
+const char *BMP085_batchModeImplementation(overSampling oss)
+{
+	if (!__atomic_load_n(&BMP085_selectedAltitudeKernel,__ATOMIC_ACQUIRE))
+		BMP085_selectKernel();
+	return BMP085_selectedKernelName[oss];
+}
@@ -0,0 +1,125 @@
+/*
+ * BMP085 library
+ * bmp085batch.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085batch.h
+  * @brief
+  * Header file part of libBMP085 library. It contains the prototypes of
+  * the functions for compensating arrays of raw temperature and pressure
+  * samples, for example when reprocessing archived raw data.
+  *
+  * The samples are passed as separate arrays (structure of arrays). The kernel
+  * is vectorized with AVX2 or SSE4.1 on x86 and with NEON on AArch64, selected
+  * at run time, and produces the same results as BMP085_calculateTemperature()
+  * and BMP085_calculatePressure() for every input. On first use both the vector
+  * and the scalar kernel are timed on a short batch in every mode, and the
+  * modes where the vector kernel is slower use the scalar one.
+  *
+  * It also contains a fast approximation of the barometric altitude formula
+  * for converting streams of pressure readings to altitude.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085BATCH_H_
+#define BMP085BATCH_H_
+
+#include <stddef.h>
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085BATCH_FUNC Batch compensation functions */
+/* @{ */
+
+/**
+ * @brief Compensates arrays of raw temperature and pressure samples.
+ *
+ * Element i of the output arrays is calculated from element i of the input arrays,
+ * exactly as BMP085_calculateTemperature() and BMP085_calculatePressure() would do.
+ *
+ * @param[in] calibration decoded calibration table.
+ * @param[in] oss over sampling mode used for the pressure conversions.
+ * @param[in] rawTemperature raw temperature values (UT).
+ * @param[in] rawPressure raw pressure values (UP), already shifted right by 8-oss.
+ * @param[out] temperature temperatures in 0.1 degrees Celsius.
+ * @param[out] pressure pressures in [Pa].
+ * @param[in] count number of samples.
+ */
+void BMP085_compensateBatch(const BMP085Calibration *calibration,overSampling oss,
+	const uint16_t *rawTemperature,const uint32_t *rawPressure,
+	int32_t *temperature,int32_t *pressure,size_t count);
+
+/**
+ * @brief Scalar implementation of BMP085_compensateBatch().
+ *
+ * Calls BMP085_calculateTemperature() and BMP085_calculatePressure() for every sample.
+ * Used as a reference for the vectorized kernels.
+ */
+void BMP085_compensateBatchScalar(const BMP085Calibration *calibration,overSampling oss,
+	const uint16_t *rawTemperature,const uint32_t *rawPressure,
+	int32_t *temperature,int32_t *pressure,size_t count);
+
+/**
+ * @brief Fast approximation of BMP085_calculateAltitude() in single precision.
+ *
+ * Evaluates 44330*(1-(pressure/baseLinePressure)^(1/5.255)) with polynomials
+ * instead of pow(). For pressures between 0.25 and 1.25 times the baseline the
+ * absolute error against BMP085_calculateAltitude() is below 2.5 mm, and below
+ * 4 mm between 0.1 and 2 times the baseline (measured for every whole Pa by the
+ * altitude benchmark suite). The error grows outside that range.
+ *
+ * @param[in] pressure pressure at the measurement point.
+ * @param[in] baseLinePressure reference pressure, in the same unit as \a pressure.
+ * @return float the relative altitude change in [m].
+ */
+float BMP085_approximateAltitude(float pressure,float baseLinePressure);
+
+/**
+ * @brief Converts an array of pressures in [Pa] to altitudes relative to a baseline.
+ *
+ * Element i of \a altitude is BMP085_approximateAltitude(pressure[i],baseLinePressure).
+ * The conversion is vectorized, with AVX2 when the processor supports it.
+ *
+ * @param[in] pressure pressures in [Pa], for example the output of BMP085_compensateBatch().
+ * @param[out] altitude altitudes in [m].
+ * @param[in] count number of pressures.
+ * @param[in] baseLinePressure reference pressure in [Pa].
+ */
+void BMP085_approximateAltitudeBatch(const int32_t *pressure,float *altitude,size_t count,float baseLinePressure);
+
+/**
+ * @brief Returns the name of the vector kernel supported by the processor.
+ *
+ * @return const char* "avx2", "sse4.1", "neon" or "scalar".
+ */
+const char *BMP085_batchImplementation(void);
+
+/**
+ * @brief Returns the name of the kernel used by BMP085_compensateBatch() in one mode.
+ *
+ * @param[in] oss over sampling mode.
+ * @return const char* the name returned by BMP085_batchImplementation(), or "scalar"
+ * when the vector kernel was slower in this mode.
+ */
+const char *BMP085_batchModeImplementation(overSampling oss);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085BATCH_H_ */
@@ -0,0 +1,110 @@
+/*
+ * BMP085 library
+ * bmp085batch_kernel.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/**
+ * @file bmp085batch_kernel.h
+ * @brief Vectorized compensation kernel, included by bmp085batch.c once per instruction set.
+ *
+ * The includer defines KERNEL_NAME, KERNEL_TARGET, V_LANES, the vector types VEC and VMASK
+ * and the V_* primitives before including this file. V_LOAD_I32 reinterprets the raw
+ * pressure as int32_t, the same conversion BMP085_calculatePressure() applies to it.
+ *
+ * The datasheet algorithm is evaluated in double precision. Every intermediate value is an
+ * integer below 2^53, so products and sums are exact, a right shift is a floor of a product
+ * with a power of two and an integer division is a trunc of the correctly rounded quotient.
+ * Scaling a coefficient by the power of two of the following shift keeps the products exact.
+ * Lanes that leave the range where this holds (unsigned wrap-around of B4 or B7, division by
+ * zero, very large B6 or pressure) are recalculated with the scalar functions, which keeps
+ * the kernel bit-exact with BMP085_calculateTemperature() and BMP085_calculatePressure().
+ *
+ * @author libBMP085 contributors
+ */
+
+static KERNEL_TARGET void KERNEL_NAME(const BMP085Calibration *calibration,overSampling oss,
+	const uint16_t *rawTemperature,const uint32_t *rawPressure,
+	int32_t *temperature,int32_t *pressure,size_t count)
+{
+	/* Coefficients are pre-scaled by the power of two of the following right shift. */
+	const VEC zero = V_SET1(0.0), one = V_SET1(1.0), two = V_SET1(2.0), half = V_SET1(0.5);
+	const VEC b3Scale = V_SET1((double)(1 << oss)/4), b3Offset = V_SET1(((double)calibration->ac1x4[oss] + 2)/4);
+	const VEC ac2 = V_SET1(calibration->ac2/2048.0), ac3 = V_SET1(calibration->ac3/8192.0);
+	const VEC ac4 = V_SET1(calibration->ac4/32768.0), ac5 = V_SET1(calibration->ac5/32768.0), ac6 = V_SET1(calibration->ac6);
+	const VEC b1 = V_SET1(calibration->b1/65536.0), b2 = V_SET1(calibration->b2/2048.0);
+	const VEC mc11 = V_SET1(calibration->mc11), md = V_SET1(calibration->md);
+	const VEC b7Scale = V_SET1(calibration->b7Scale[oss]);
+	const VEC b6Limit = V_SET1(1048576.0), b6MinusLimit = V_SET1(-1048576.0);
+	const VEC b7Limit = V_SET1(2147483648.0), pressureLimit = V_SET1(134217728.0);
+	const VEC k2m2 = V_SET1(1.0/4), k2m4 = V_SET1(1.0/16), k2m8 = V_SET1(1.0/256), k2m12 = V_SET1(1.0/4096);
+	const VEC c8 = V_SET1(8.0), c4000 = V_SET1(4000.0), c32768 = V_SET1(32768.0);
+	const VEC c3038 = V_SET1(3038.0/65536), c7357 = V_SET1(-7357.0/65536), c3791 = V_SET1(3791.0);
+	VEC ut, up, x1, x2, x3, den, b3, b4, b5, b6, b6sq, b7, q, r, p;
+	VMASK valid;
+	int32_t b5Scalar;
+	size_t i;
+	int lane, bits;
+
+	for (i=0;i+V_LANES<=count;i+=V_LANES)
+	{
+		ut = V_LOAD_U16(rawTemperature+i);
+		up = V_LOAD_I32(rawPressure+i);
+
+		/* Temperature */
+		x1 = V_FLOOR(V_MUL(V_SUB(ut,ac6),ac5));
+		den = V_ADD(x1,md);
+		valid = V_NE(den,zero);
+		x2 = V_TRUNC(V_DIV(mc11,den));
+		b5 = V_ADD(x1,x2);
+		V_STORE_I32(temperature+i,V_FLOOR(V_MUL(V_ADD(b5,c8),k2m4)));
+
+		/* Pressure */
+		b6 = V_SUB(b5,c4000);
+		valid = V_AND(valid,V_AND(V_LT(b6,b6Limit),V_LT(b6MinusLimit,b6)));
+		b6sq = V_FLOOR(V_MUL(V_MUL(b6,b6),k2m12));
+		x1 = V_FLOOR(V_MUL(b2,b6sq));
+		x2 = V_FLOOR(V_MUL(ac2,b6));
+		b3 = V_TRUNC(V_ADD(V_MUL(V_ADD(x1,x2),b3Scale),b3Offset));
+		x1 = V_FLOOR(V_MUL(ac3,b6));
+		x2 = V_FLOOR(V_MUL(b1,b6sq));
+		x3 = V_ADD(V_FLOOR(V_ADD(V_MUL(V_ADD(x1,x2),k2m2),half)),c32768);
+		valid = V_AND(valid,V_GE(x3,zero));
+		b4 = V_FLOOR(V_MUL(ac4,x3));
+		valid = V_AND(valid,V_LT(zero,b4));
+		b7 = V_SUB(up,b3);
+		valid = V_AND(valid,V_AND(V_GE(up,zero),V_GE(b7,zero)));
+		b7 = V_MUL(b7,b7Scale);
+
+		/* One division gives both (B7*2)/B4 and (B7/B4)*2 from the quotient and the remainder. */
+		q = V_FLOOR(V_DIV(b7,b4));
+		r = V_SUB(b7,V_MUL(q,b4));
+		p = V_MUL(q,two);
+		p = V_BLEND(V_LT(b7,b7Limit),V_ADD(p,V_BLEND(V_GE(V_MUL(r,two),b4),one,zero)),p);
+		valid = V_AND(valid,V_LT(p,pressureLimit));
+
+		x1 = V_FLOOR(V_MUL(p,k2m8));
+		x1 = V_FLOOR(V_MUL(V_MUL(x1,x1),c3038));
+		x2 = V_FLOOR(V_MUL(p,c7357));
+		p = V_ADD(p,V_FLOOR(V_MUL(V_ADD(V_ADD(x1,x2),c3791),k2m4)));
+		V_STORE_I32(pressure+i,p);
+
+		bits = V_MASK_BITS(valid);
+		if (bits == (1 << V_LANES) - 1)
+			continue;
+		for (lane=0;lane<V_LANES;lane++)
+		{
+			if (bits & (1 << lane))
+				continue;
+			temperature[i+lane] = BMP085_calculateTemperature(calibration,rawTemperature[i+lane],&b5Scalar);
+			pressure[i+lane] = BMP085_calculatePressure(calibration,oss,rawPressure[i+lane],b5Scalar);
+		}
+	}
+
+	BMP085_compensateBatchScalar(calibration,oss,rawTemperature+i,rawPressure+i,temperature+i,pressure+i,count-i);
+}
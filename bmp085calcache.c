@@ -0,0 +1,267 @@
+/*
+ * BMP085 library
+ * bmp085calcache.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085calcache.c
+ *  @brief Implements the functions defined in the header file bmp085calcache.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085calcache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+_Static_assert(sizeof(BMP085CalCacheHeader) == 32,"cache header must be 32 bytes");
+_Static_assert(sizeof(BMP085CalCacheEntry) == 72,"cache entry must be 72 bytes");
+
+/* CRC-32 (IEEE 802.3) of an entry with the checksum member set to zero. */
+static uint32_t BMP085CalCache_checksum(const BMP085CalCacheEntry *entry)
+{
+	BMP085CalCacheEntry copy = *entry;
+	const unsigned char *data = (const unsigned char *)&copy;
+	uint32_t crc = 0xFFFFFFFF;
+	size_t i;
+	int bit;
+
+	copy.checksum = 0;
+	for (i=0;i<sizeof(copy);i++)
+	{
+		crc ^= data[i];
+		for (bit=0;bit<8;bit++)
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+	}
+	return ~crc;
+}
+
+/* Reads the whole buffer, resuming after short reads and signals. */
+static int BMP085CalCache_read(int fd,void *data,size_t size)
+{
+	char *buffer = (char *)data;
+	ssize_t done;
+
+	while (size)
+	{
+		done = read(fd,buffer,size);
+		if (done < 0 && errno == EINTR)
+			continue;
+		if (done <= 0)
+			return 1;
+		buffer += done;
+		size -= done;
+	}
+	return 0;
+}
+
+/* Writes the whole buffer, resuming after short writes and signals. */
+static int BMP085CalCache_write(int fd,const void *data,size_t size)
+{
+	const char *buffer = (const char *)data;
+	ssize_t written;
+
+	while (size)
+	{
+		written = write(fd,buffer,size);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return 1;
+		}
+		buffer += written;
+		size -= written;
+	}
+	return 0;
+}
+
+/* Returns the entry of a sensor, NULL when the sensor is not cached. */
+static BMP085CalCacheEntry *BMP085CalCache_find(BMP085CalCache *cache,const char *adapter,unsigned char I2CAddress)
+{
+	size_t i;
+
+	for (i=0;i<cache->count;i++)
+		if (cache->entries[i].I2CAddress == I2CAddress && !strcmp(cache->entries[i].adapter,adapter))
+			return &(cache->entries[i]);
+	return NULL;
+}
+
+/* Adds an empty entry. */
+static BMP085CalCacheEntry *BMP085CalCache_add(BMP085CalCache *cache)
+{
+	BMP085CalCacheEntry *entries;
+	size_t capacity;
+
+	if (cache->count == cache->capacity)
+	{
+		capacity = cache->capacity ? 2 * cache->capacity : 16;
+		entries = realloc(cache->entries,capacity * sizeof(BMP085CalCacheEntry));
+		if (!entries)
+			return NULL;
+		cache->entries = entries;
+		cache->capacity = capacity;
+	}
+	return &(cache->entries[cache->count++]);
+}
+
+/* Initializes an empty cache. */
+void BMP085CalCache_init(BMP085CalCache *cache)
+{
+	memset(cache,0,sizeof(BMP085CalCache));
+}
+
+/* Loads a cache file. */
+int BMP085CalCache_load(BMP085CalCache *cache,const char *path)
+{
+	BMP085CalCacheHeader header;
+	BMP085CalCacheEntry entry, *slot;
+	uint32_t i;
+	int fd;
+
+	BMP085CalCache_init(cache);
+	fd = open(path,O_RDONLY|O_CLOEXEC);
+	if (fd < 0)
+		return errno == ENOENT ? 0 : 1;
+
+	if (BMP085CalCache_read(fd,&header,sizeof(header)) || memcmp(header.magic,BMP085CALCACHE_MAGIC,8) ||
+		header.version != BMP085CALCACHE_VERSION || header.byteOrder != BMP085CALCACHE_BYTE_ORDER ||
+		header.headerSize != sizeof(BMP085CalCacheHeader) || header.entrySize != sizeof(BMP085CalCacheEntry))
+	{
+		close(fd);
+		return 1;
+	}
+
+	for (i=0;i<header.count;i++)
+	{
+		// A truncated file keeps the complete entries.
+		if (BMP085CalCache_read(fd,&entry,sizeof(entry)))
+			break;
+		if (entry.checksum != BMP085CalCache_checksum(&entry) || entry.adapter[BMP085CALCACHE_ADAPTER_SIZE-1] ||
+			BMP085CalCache_find(cache,entry.adapter,entry.I2CAddress))
+		{
+			cache->dropped++;
+			continue;
+		}
+		slot = BMP085CalCache_add(cache);
+		if (!slot)
+			break;
+		*slot = entry;
+	}
+	cache->dropped += header.count - i;
+
+	close(fd);
+	return 0;
+}
+
+/* Writes the cache to a file. */
+int BMP085CalCache_save(BMP085CalCache *cache,const char *path)
+{
+	BMP085CalCacheHeader header;
+	char temporary[4096];
+	int fd, result;
+
+	if (!cache->modified)
+		return 0;
+	if (snprintf(temporary,sizeof(temporary),"%s.%d",path,(int)getpid()) >= (int)sizeof(temporary))
+		return 1;
+
+	memset(&header,0,sizeof(header));
+	memcpy(header.magic,BMP085CALCACHE_MAGIC,8);
+	header.version = BMP085CALCACHE_VERSION;
+	header.byteOrder = BMP085CALCACHE_BYTE_ORDER;
+	header.headerSize = sizeof(BMP085CalCacheHeader);
+	header.entrySize = sizeof(BMP085CalCacheEntry);
+	header.count = cache->count;
+
+	fd = open(temporary,O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC,0644);
+	if (fd < 0)
+		return 1;
+	result = BMP085CalCache_write(fd,&header,sizeof(header)) ||
+		BMP085CalCache_write(fd,cache->entries,cache->count * sizeof(BMP085CalCacheEntry));
+	if (close(fd))
+		result = 1;
+	if (!result && rename(temporary,path))
+		result = 1;
+	if (result)
+	{
+		unlink(temporary);
+		return 1;
+	}
+
+	cache->modified = 0;
+	return 0;
+}
+
+/* Sensor initialization through the cache on an i2c-dev bus. */
+int BMP085CalCache_initSensor(BMP085CalCache *cache,const char *adapter,BMP085 *sensor,int *I2Cbus,unsigned char I2CAddress,overSampling oss)
+{
+	sensor->I2CBus=*I2Cbus;
+	return BMP085CalCache_initSensorOnBus(cache,adapter,sensor,&I2CBus_devOps,NULL,I2CAddress,oss);
+}
+
+/* Sensor initialization through the cache over a custom transport. */
+int BMP085CalCache_initSensorOnBus(BMP085CalCache *cache,const char *adapter,BMP085 *sensor,const I2CBusOps *busOps,void *busContext,unsigned char I2CAddress,overSampling oss)
+{
+	BMP085CalCacheEntry *entry;
+	long long begin, readTime;
+
+	if (strlen(adapter) >= BMP085CALCACHE_ADAPTER_SIZE)
+	{
+		cache->misses++;
+		return BMP085_initSensorOnBus(sensor,busOps,busContext,I2CAddress,oss);
+	}
+
+	entry = BMP085CalCache_find(cache,adapter,I2CAddress);
+	if (entry)
+	{
+		begin = tNow();
+		if (!BMP085_initSensorWithCalibration(sensor,busOps,busContext,I2CAddress,oss,entry->calibration))
+		{
+			cache->hits++;
+			cache->savedTime += entry->readTime - (tNow() - begin);
+			return 0;
+		}
+		cache->stale++;
+	}
+
+	cache->misses++;
+	begin = tNow();
+	if (BMP085_initSensorOnBus(sensor,busOps,busContext,I2CAddress,oss))
+		return 1;
+	readTime = tNow() - begin;
+
+	if (!entry)
+	{
+		entry = BMP085CalCache_add(cache);
+		// The sensor works without the cache.
+		if (!entry)
+			return 0;
+	}
+	memset(entry,0,sizeof(BMP085CalCacheEntry));
+	strcpy(entry->adapter,adapter);
+	entry->readTime = readTime;
+	memcpy(entry->calibration,sensor->calibrationCoeficients,22);
+	entry->I2CAddress = I2CAddress;
+	entry->checksum = BMP085CalCache_checksum(entry);
+	cache->modified = 1;
+
+	return 0;
+}
+
+/* Releases the entries. */
+void BMP085CalCache_destroy(BMP085CalCache *cache)
+{
+	free(cache->entries);
+	BMP085CalCache_init(cache);
+}
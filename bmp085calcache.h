@@ -0,0 +1,174 @@
+/*
+ * BMP085 library
+ * bmp085calcache.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085calcache.h
+  * @brief
+  * Header file part of libBMP085 library. It defines a persistent cache of
+  * calibration tables, keyed by the I2C adapter and the sensor address.
+  *
+  * A sensor found in the cache is initialized with
+  * BMP085_initSensorWithCalibration(), which reads the chip ID and the first
+  * BMP085_CALIBRATION_FINGERPRINT bytes of the table instead of all 22 bytes.
+  * When they do not match, the sensor was replaced and the whole table is read
+  * again. Every entry of the cache file carries a checksum, and damaged entries
+  * are dropped when the file is loaded.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085CALCACHE_H_
+#define BMP085CALCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085CALCACHE_FORMAT Calibration cache file format */
+/* @{ */
+#define BMP085CALCACHE_MAGIC "BMP085CC"	/**< First 8 bytes of a cache file. */
+#define BMP085CALCACHE_VERSION 1	/**< Version of the cache format. */
+#define BMP085CALCACHE_BYTE_ORDER 0x01020304	/**< Written in the host byte order for detecting foreign files. */
+#define BMP085CALCACHE_ADAPTER_SIZE 32	/**< Size of the adapter name, terminating zero included. */
+/* @} */
+
+/**
+ * @brief Header at the start of a cache file, 32 bytes.
+ */
+typedef struct bmp085calcacheheader
+{
+	char magic[8];	/**< BMP085CALCACHE_MAGIC. */
+	uint32_t version;	/**< BMP085CALCACHE_VERSION. */
+	uint32_t byteOrder;	/**< BMP085CALCACHE_BYTE_ORDER in the byte order of the writer. */
+	uint32_t headerSize;	/**< Size of the header in bytes. */
+	uint32_t entrySize;	/**< Size of one entry in bytes. */
+	uint32_t count;	/**< Number of entries following the header. */
+	uint32_t reserved;	/**< Zero. */
+} BMP085CalCacheHeader;
+
+/**
+ * @brief Calibration table of one sensor, 72 bytes.
+ */
+typedef struct bmp085calcacheentry
+{
+	char adapter[BMP085CALCACHE_ADAPTER_SIZE];	/**< Name of the I2C adapter, for example the i2c-dev device. */
+	int64_t readTime;	/**< Time in [ns] the last full read of the calibration table took. */
+	uint32_t checksum;	/**< CRC-32 of the entry with this member set to zero. */
+	unsigned char calibration[22];	/**< Calibration table as read from the sensor. */
+	unsigned char I2CAddress;	/**< I2C address of the sensor. */
+	unsigned char reserved[5];	/**< Zero. */
+} BMP085CalCacheEntry;
+
+/**
+ * @brief Calibration cache and its hit counters.
+ */
+typedef struct bmp085calcache
+{
+	BMP085CalCacheEntry *entries;	/**< Cached tables. */
+	size_t count;	/**< Number of cached tables. */
+	size_t capacity;	/**< Number of allocated entries. */
+	int modified;	/**< Set when an entry was added or replaced since the cache was loaded. */
+	unsigned long hits;	/**< Sensors initialized from the cache. */
+	unsigned long misses;	/**< Sensors whose calibration table was read in full. */
+	unsigned long stale;	/**< Misses of sensors that had an entry which did not match the sensor. */
+	unsigned long dropped;	/**< Entries of the loaded file dropped because of a wrong checksum. */
+	long long savedTime;	/**< Full read time of the cache hits minus the time of their validation in [ns]. */
+} BMP085CalCache;
+
+/** \defgroup BMP085CALCACHE_FUNC Calibration cache functions */
+/* @{ */
+
+/**
+ * @brief Initializes an empty cache.
+ *
+ * @param[in,out] cache pointer to the cache.
+ */
+void BMP085CalCache_init(BMP085CalCache *cache);
+
+/**
+ * @brief Initializes the cache with the entries of a cache file.
+ *
+ * A missing file gives an empty cache. Entries with a wrong checksum are
+ * dropped and counted. The cache is usable after a failure, but empty.
+ *
+ * @param[in,out] cache pointer to the cache.
+ * @param[in] path name of the cache file.
+ * @return int returns 0 for successful operation or a missing file, 1 when the file is not a cache file of this host.
+ */
+int BMP085CalCache_load(BMP085CalCache *cache,const char *path);
+
+/**
+ * @brief Writes the cache to a file when it was modified.
+ *
+ * The entries are written to a temporary file that replaces \a path, so a
+ * reader never sees a partially written cache.
+ *
+ * @param[in,out] cache pointer to the cache.
+ * @param[in] path name of the cache file.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085CalCache_save(BMP085CalCache *cache,const char *path);
+
+/**
+ * @brief Sensor initialization through the cache on an i2c-dev bus.
+ *
+ * Same as BMP085_initSensor(), see BMP085CalCache_initSensorOnBus().
+ *
+ * @param[in,out] cache pointer to the cache.
+ * @param[in] adapter name of the I2C adapter, for example the i2c-dev device.
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] I2Cbus pointer to the file descriptor of the I2C bus present on the system.
+ * @param[in] I2CAddress address of the sensor on the I2C bus.
+ * @param[in] oss defining the over sampling mode of the sensor for the pressure measurement.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085CalCache_initSensor(BMP085CalCache *cache,const char *adapter,BMP085 *sensor,int *I2Cbus,unsigned char I2CAddress,overSampling oss);
+
+/**
+ * @brief Sensor initialization through the cache over a custom transport.
+ *
+ * A cached table is validated with BMP085_initSensorWithCalibration(). When
+ * there is no entry or the sensor does not match it, the sensor is initialized
+ * with BMP085_initSensorOnBus() and the table is stored in the cache, together
+ * with the time the full read took. Adapter names longer than
+ * BMP085CALCACHE_ADAPTER_SIZE-1 characters are not cached.
+ *
+ * @param[in,out] cache pointer to the cache.
+ * @param[in] adapter name of the I2C adapter.
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] busOps transport operations used for accessing the sensor.
+ * @param[in] busContext context passed to the transport operations.
+ * @param[in] I2CAddress address of the sensor on the I2C bus.
+ * @param[in] oss defining the over sampling mode of the sensor for the pressure measurement.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085CalCache_initSensorOnBus(BMP085CalCache *cache,const char *adapter,BMP085 *sensor,const I2CBusOps *busOps,void *busContext,unsigned char I2CAddress,overSampling oss);
+
+/**
+ * @brief Releases the entries of the cache.
+ *
+ * @param[in,out] cache pointer to the cache.
+ */
+void BMP085CalCache_destroy(BMP085CalCache *cache);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085CALCACHE_H_ */
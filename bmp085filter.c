@@ -0,0 +1,173 @@
+/*
+ * BMP085 library
+ * bmp085filter.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085filter.c
+ *  @brief Implements the functions defined in the header file bmp085filter.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085filter.h"
+
+#include <string.h>
+
+/* Extra fractional bits of the IIR state, so small corrections are not truncated away. */
+#define BMP085FILTER_IIR_BITS 16
+
+/* Adds a stage with cleared state. */
+static int BMP085Filter_addStage(BMP085Filter *filter,filterType type,unsigned int length)
+{
+	BMP085FilterStage *stage;
+
+	if (filter->stageCount == BMP085FILTER_MAX_STAGES)
+		return 1;
+
+	stage = &(filter->stages[filter->stageCount++]);
+	memset(stage,0,sizeof(BMP085FilterStage));
+	stage->type = type;
+	stage->length = length;
+
+	return 0;
+}
+
+/* Median of the window, sorted by insertion into a local copy. */
+static int32_t BMP085Filter_median(const BMP085FilterStage *stage)
+{
+	int32_t sorted[BMP085FILTER_MAX_MEDIAN], value;
+	unsigned int i, j;
+
+	for (i=0;i<stage->count;i++)
+	{
+		value = stage->window[i];
+		for (j=i;j>0 && sorted[j-1]>value;j--)
+			sorted[j] = sorted[j-1];
+		sorted[j] = value;
+	}
+	return sorted[stage->count/2];
+}
+
+/* Passes a fixed-point value through one stage. */
+static int32_t BMP085Filter_stage(BMP085FilterStage *stage,int32_t value)
+{
+	switch (stage->type)
+	{
+		case filterMovingAverage:
+			if (stage->count == stage->length)
+				stage->sum -= stage->window[stage->position];
+			else
+				stage->count++;
+			stage->window[stage->position] = value;
+			stage->sum += value;
+			stage->position = (stage->position + 1) % stage->length;
+			// Rounded mean; the window is partially filled during start-up.
+			return (int32_t)((stage->sum + (stage->sum >= 0 ? 1 : -1) * (int64_t)(stage->count / 2)) / (int64_t)stage->count);
+
+		case filterIIR:
+			// The first sample initializes the state, so the output does not ramp up from zero.
+			if (!stage->count)
+			{
+				stage->sum = (int64_t)value << BMP085FILTER_IIR_BITS;
+				stage->count = 1;
+			}
+			else
+				stage->sum += (((int64_t)value << BMP085FILTER_IIR_BITS) - stage->sum) >> stage->length;
+			return (int32_t)((stage->sum + (1 << (BMP085FILTER_IIR_BITS - 1))) >> BMP085FILTER_IIR_BITS);
+
+		case filterMedian:
+			stage->window[stage->position] = value;
+			stage->position = (stage->position + 1) % stage->length;
+			if (stage->count < stage->length)
+				stage->count++;
+			return BMP085Filter_median(stage);
+	}
+
+	return value;
+}
+
+/* Initializes an empty filter. */
+int BMP085Filter_init(BMP085Filter *filter,unsigned int decimation)
+{
+	memset(filter,0,sizeof(BMP085Filter));
+	if (!decimation)
+		return 1;
+	filter->decimation = decimation;
+	return 0;
+}
+
+/* Appends a moving average stage. */
+int BMP085Filter_addMovingAverage(BMP085Filter *filter,unsigned int length)
+{
+	if (!length || length > BMP085FILTER_MAX_WINDOW)
+		return 1;
+	return BMP085Filter_addStage(filter,filterMovingAverage,length);
+}
+
+/* Appends an IIR stage. */
+int BMP085Filter_addIIR(BMP085Filter *filter,unsigned int shift)
+{
+	if (!shift || shift > BMP085FILTER_MAX_SHIFT)
+		return 1;
+	return BMP085Filter_addStage(filter,filterIIR,shift);
+}
+
+/* Appends a median stage. */
+int BMP085Filter_addMedian(BMP085Filter *filter,unsigned int length)
+{
+	if (!(length & 1) || length > BMP085FILTER_MAX_MEDIAN)
+		return 1;
+	return BMP085Filter_addStage(filter,filterMedian,length);
+}
+
+/* Passes one sample through the filter. */
+int BMP085Filter_process(BMP085Filter *filter,int32_t input,int32_t *output)
+{
+	int32_t value = input * (1 << BMP085FILTER_FRACTION_BITS);
+	unsigned int i;
+
+	for (i=0;i<filter->stageCount;i++)
+		value = BMP085Filter_stage(&(filter->stages[i]),value);
+
+	if (++filter->phase < filter->decimation)
+		return 0;
+
+	filter->phase = 0;
+	*output = value;
+	return 1;
+}
+
+/* Clears the state of the stages. */
+void BMP085Filter_reset(BMP085Filter *filter)
+{
+	unsigned int i;
+
+	for (i=0;i<filter->stageCount;i++)
+	{
+		filter->stages[i].count = 0;
+		filter->stages[i].position = 0;
+		filter->stages[i].sum = 0;
+	}
+	filter->phase = 0;
+}
+
+/* Group delay in input samples. */
+float BMP085Filter_delay(const BMP085Filter *filter)
+{
+	float delay = 0;
+	unsigned int i;
+
+	for (i=0;i<filter->stageCount;i++)
+	{
+		if (filter->stages[i].type == filterIIR)
+			delay += (1 << filter->stages[i].length) - 1;
+		else
+			delay += (filter->stages[i].length - 1) / 2.0f;
+	}
+	return delay;
+}
@@ -0,0 +1,157 @@
+/*
+ * BMP085 library
+ * bmp085filter.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085filter.h
+  * @brief
+  * Header file part of libBMP085 library. It defines a fixed-point filter
+  * pipeline for software oversampling of the measured values.
+  *
+  * A filter is a cascade of up to BMP085FILTER_MAX_STAGES stages (moving
+  * average, first order IIR, median-of-N) followed by an optional decimation.
+  * It accepts integer samples, for example the pressure in [Pa] produced by
+  * BMP085_takeMeasurement() or BMP085_calculatePressure(), and produces values
+  * in the same unit with BMP085FILTER_FRACTION_BITS fractional bits, so the
+  * reduced noise is not lost to rounding. Sampling in ultraLowPower mode at a
+  * high rate and filtering reaches the noise of the slower modes.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085FILTER_H_
+#define BMP085FILTER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085FILTER_LIMITS Filter limits */
+/* @{ */
+#define BMP085FILTER_MAX_STAGES 4	/**< Maximum number of stages in a filter. */
+#define BMP085FILTER_MAX_WINDOW 64	/**< Maximum window of a moving average stage. */
+#define BMP085FILTER_MAX_MEDIAN 15	/**< Maximum window of a median stage. */
+#define BMP085FILTER_MAX_SHIFT 12	/**< Maximum shift of an IIR stage. */
+#define BMP085FILTER_FRACTION_BITS 8	/**< Fractional bits of the filter output. */
+/* @} */
+
+/**
+ * @brief Type of a filter stage.
+ */
+typedef enum filterType
+{
+	filterMovingAverage = 0,	/**< Mean of the last N samples. */
+	filterIIR,	/**< First order low pass, y += (x - y) / 2^shift. */
+	filterMedian	/**< Median of the last N samples, removes spikes. */
+} filterType;
+
+/**
+ * @brief State of one filter stage.
+ */
+typedef struct bmp085filterstage
+{
+	filterType type;	/**< Type of the stage. */
+	unsigned int length;	/**< Window of the moving average and median stages, shift of the IIR stage. */
+	unsigned int count;	/**< Number of samples in the window. */
+	unsigned int position;	/**< Next slot of the window. */
+	int64_t sum;	/**< Sum of the moving average window, state of the IIR stage. */
+	int32_t window[BMP085FILTER_MAX_WINDOW];	/**< Last samples of the moving average and median stages. */
+} BMP085FilterStage;
+
+/**
+ * @brief Filter pipeline.
+ */
+typedef struct bmp085filter
+{
+	BMP085FilterStage stages[BMP085FILTER_MAX_STAGES];	/**< Filter stages, applied in order. */
+	unsigned int stageCount;	/**< Number of stages. */
+	unsigned int decimation;	/**< One output for every decimation input samples. */
+	unsigned int phase;	/**< Input samples since the last output. */
+} BMP085Filter;
+
+/** \defgroup BMP085FILTER_FUNC Filter functions */
+/* @{ */
+
+/**
+ * @brief Initializes an empty filter.
+ *
+ * A filter without stages only converts the samples to fixed point and decimates them.
+ *
+ * @param[in,out] filter pointer to the filter.
+ * @param[in] decimation one output for every \a decimation input samples, 1 for no decimation.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Filter_init(BMP085Filter *filter,unsigned int decimation);
+
+/**
+ * @brief Appends a moving average stage.
+ *
+ * @param[in,out] filter pointer to the filter.
+ * @param[in] length number of averaged samples, up to BMP085FILTER_MAX_WINDOW.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Filter_addMovingAverage(BMP085Filter *filter,unsigned int length);
+
+/**
+ * @brief Appends a first order IIR stage with the coefficient 1/2^shift.
+ *
+ * @param[in,out] filter pointer to the filter.
+ * @param[in] shift coefficient of the stage, from 1 to BMP085FILTER_MAX_SHIFT.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Filter_addIIR(BMP085Filter *filter,unsigned int shift);
+
+/**
+ * @brief Appends a median stage.
+ *
+ * @param[in,out] filter pointer to the filter.
+ * @param[in] length odd number of samples, up to BMP085FILTER_MAX_MEDIAN.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Filter_addMedian(BMP085Filter *filter,unsigned int length);
+
+/**
+ * @brief Passes one sample through the filter.
+ *
+ * @param[in,out] filter pointer to the filter.
+ * @param[in] input the sample, with an absolute value below 2^23.
+ * @param[out] output filtered value with BMP085FILTER_FRACTION_BITS fractional bits, set only when the function returns 1.
+ * @return int 1 when an output value was produced, 0 when the sample was consumed by the decimation.
+ */
+int BMP085Filter_process(BMP085Filter *filter,int32_t input,int32_t *output);
+
+/**
+ * @brief Clears the state of every stage, keeping the configuration.
+ *
+ * @param[in,out] filter pointer to the filter.
+ */
+void BMP085Filter_reset(BMP085Filter *filter);
+
+/**
+ * @brief Returns the group delay of the filter in input samples.
+ *
+ * The delay of the moving average and median stages is (N-1)/2 samples, the
+ * delay of an IIR stage is 2^shift-1 samples at low frequencies.
+ *
+ * @param[in] filter pointer to the filter.
+ */
+float BMP085Filter_delay(const BMP085Filter *filter);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085FILTER_H_ */
@@ -0,0 +1,396 @@
+/*
+ * BMP085 library
+ * bmp085iio.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085iio.c
+ *  @brief Implements the functions defined in the header file bmp085iio.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085iio.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <math.h>
+#include <dirent.h>
+
+/* Opens an attribute of the device. */
+static int BMP085Iio_openAttribute(const BMP085Iio *iio,const char *name,int flags)
+{
+	char path[2*BMP085IIO_PATH_SIZE];
+
+	snprintf(path,sizeof(path),"%s/%s",iio->sysfsPath,name);
+	return open(path,flags|O_CLOEXEC);
+}
+
+/* Reads an attribute of the device as a string without the trailing newline. */
+static int BMP085Iio_readAttribute(const BMP085Iio *iio,const char *name,char *value,size_t size)
+{
+	ssize_t length;
+	int fd = BMP085Iio_openAttribute(iio,name,O_RDONLY);
+
+	if (fd < 0)
+		return 1;
+	length = read(fd,value,size - 1);
+	close(fd);
+	if (length <= 0)
+		return 1;
+	value[length] = 0;
+	if (value[length-1] == '\n')
+		value[length-1] = 0;
+	return 0;
+}
+
+/* Writes an attribute of the device. */
+static int BMP085Iio_writeAttribute(const BMP085Iio *iio,const char *name,const char *value)
+{
+	size_t length = strlen(value);
+	int fd = BMP085Iio_openAttribute(iio,name,O_WRONLY), result;
+
+	if (fd < 0)
+		return 1;
+	result = write(fd,value,length) != (ssize_t)length;
+	if (close(fd))
+		result = 1;
+	return result;
+}
+
+/* Reads a number from an attribute kept open, from its start. */
+static int BMP085Iio_readNumber(int fd,double *value)
+{
+	char text[64], *end;
+	ssize_t length;
+
+	length = pread(fd,text,sizeof(text) - 1,0);
+	if (length <= 0)
+		return 1;
+	text[length] = 0;
+	*value = strtod(text,&end);
+	return end == text;
+}
+
+/* Selects the over sampling ratio of the pressure conversion when it changed. */
+static int BMP085Iio_setOversampling(BMP085Iio *iio,int oss)
+{
+	char ratio[8];
+	int length;
+
+	if (iio->oss == oss)
+		return 0;
+	if (iio->oversamplingFd >= 0)
+	{
+		length = snprintf(ratio,sizeof(ratio),"%d\n",1 << oss);
+		if (pwrite(iio->oversamplingFd,ratio,length,0) != length)
+			return 1;
+	}
+	iio->oss = oss;
+	return 0;
+}
+
+static int BMP085Iio_read(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+{
+	(void)context;
+	(void)I2CAddress;
+	(void)registry;
+	(void)buffer;
+	(void)size;
+	errno = ENOTSUP;
+	return ERROR_I2C_READ_FAILED;
+}
+
+static int BMP085Iio_write(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+{
+	(void)context;
+	(void)I2CAddress;
+	(void)registry;
+	(void)value;
+	errno = ENOTSUP;
+	return ERROR_I2C_WRITE_FAILED;
+}
+
+/* One-shot measurement through sysfs, the kernel waits for the conversions. */
+static int BMP085Iio_measure(void *context,unsigned char I2CAddress,int oss,int32_t *temperature,int32_t *pressure)
+{
+	BMP085Iio *iio = (BMP085Iio *)context;
+	double value;
+
+	(void)I2CAddress;
+	if (BMP085Iio_setOversampling(iio,oss))
+		return ERROR_I2C_WRITE_FAILED;
+
+	// in_temp_input is in milli degrees Celsius and in_pressure_input in [kPa].
+	if (BMP085Iio_readNumber(iio->temperatureFd,&value))
+		return ERROR_I2C_READ_FAILED;
+	*temperature = lround(value / 100);
+	if (BMP085Iio_readNumber(iio->pressureFd,&value))
+		return ERROR_I2C_READ_FAILED;
+	*pressure = lround(value * 1000);
+
+	return 0;
+}
+
+const I2CBusOps BMP085Iio_busOps = { .read = BMP085Iio_read, .write = BMP085Iio_write, .measure = BMP085Iio_measure };
+
+/* Finds the first BMP085 or BMP180 IIO device. */
+int BMP085Iio_find(const char *root,char *path,size_t size)
+{
+	char best[BMP085IIO_PATH_SIZE] = "", name[32];
+	BMP085Iio device;
+	struct dirent *entry;
+	DIR *directory;
+
+	directory = opendir(root);
+	if (!directory)
+		return 1;
+	while ((entry = readdir(directory)))
+	{
+		if (strncmp(entry->d_name,"iio:device",10) || (best[0] && strcmp(entry->d_name,best) > 0))
+			continue;
+		if (snprintf(device.sysfsPath,sizeof(device.sysfsPath),"%s/%s",root,entry->d_name) >= (int)sizeof(device.sysfsPath))
+			continue;
+		if (BMP085Iio_readAttribute(&device,"name",name,sizeof(name)))
+			continue;
+		if (!strcmp(name,"bmp085") || !strcmp(name,"bmp180"))
+			snprintf(best,sizeof(best),"%s",entry->d_name);
+	}
+	closedir(directory);
+
+	if (!best[0] || snprintf(path,size,"%s/%s",root,best) >= (int)size)
+		return 1;
+	return 0;
+}
+
+/* Opens an IIO device. */
+int BMP085Iio_open(BMP085Iio *iio,const char *sysfsPath,const char *devicePath)
+{
+	const char *name;
+
+	memset(iio,0,sizeof(BMP085Iio));
+	iio->temperatureFd = iio->pressureFd = iio->oversamplingFd = iio->bufferFd = -1;
+	iio->oss = -1;
+	if (snprintf(iio->sysfsPath,sizeof(iio->sysfsPath),"%s",sysfsPath) >= (int)sizeof(iio->sysfsPath))
+		return 1;
+	if (devicePath)
+		name = devicePath;
+	else
+	{
+		name = strrchr(sysfsPath,'/');
+		name = name ? name + 1 : sysfsPath;
+	}
+	if (snprintf(iio->devicePath,sizeof(iio->devicePath),"%s%s",devicePath ? "" : "/dev/",name) >= (int)sizeof(iio->devicePath))
+		return 1;
+
+	iio->temperatureFd = BMP085Iio_openAttribute(iio,"in_temp_input",O_RDONLY);
+	iio->pressureFd = BMP085Iio_openAttribute(iio,"in_pressure_input",O_RDONLY);
+	iio->oversamplingFd = BMP085Iio_openAttribute(iio,"in_pressure_oversampling_ratio",O_RDWR);
+	if (iio->temperatureFd < 0 || iio->pressureFd < 0)
+	{
+		BMP085Iio_close(iio);
+		return 1;
+	}
+
+	return 0;
+}
+
+/* Enables a channel of the scan and reads its layout. */
+static int BMP085Iio_enableChannel(BMP085Iio *iio,BMP085IioChannel *channel,const char *prefix)
+{
+	char name[64], value[64], endian, sign;
+	const char *shift;
+
+	memset(channel,0,sizeof(BMP085IioChannel));
+	snprintf(name,sizeof(name),"scan_elements/%s_en",prefix);
+	if (BMP085Iio_writeAttribute(iio,name,"1"))
+		return 1;
+
+	// For example le:s32/32>>0, with an optional repeat count after the storage bits.
+	snprintf(name,sizeof(name),"scan_elements/%s_type",prefix);
+	if (BMP085Iio_readAttribute(iio,name,value,sizeof(value)) ||
+		sscanf(value,"%ce:%c%u/%u",&endian,&sign,&(channel->realBits),&(channel->storageBits)) != 4 ||
+		(channel->storageBits != 8 && channel->storageBits != 16 && channel->storageBits != 32 && channel->storageBits != 64) ||
+		channel->realBits == 0 || channel->realBits > channel->storageBits)
+		return 1;
+	channel->bigEndian = endian == 'b';
+	channel->isSigned = sign == 's';
+	shift = strstr(value,">>");
+	channel->shift = shift ? atoi(shift + 2) : 0;
+
+	snprintf(name,sizeof(name),"scan_elements/%s_index",prefix);
+	if (BMP085Iio_readAttribute(iio,name,value,sizeof(value)))
+		return 1;
+	channel->index = atoi(value);
+
+	snprintf(name,sizeof(name),"%s_scale",prefix);
+	channel->scale = BMP085Iio_readAttribute(iio,name,value,sizeof(value)) ? 1.0 : strtod(value,NULL);
+	channel->enabled = 1;
+	return 0;
+}
+
+/* Places the enabled channels in the scan in the order of their indexes, each aligned to its size. */
+static int BMP085Iio_layout(BMP085Iio *iio)
+{
+	BMP085IioChannel *channels[3] = { &(iio->temperature), &(iio->pressure), &(iio->timestamp) }, *swap;
+	unsigned int offset = 0, bytes, largest = 1;
+	int i, j;
+
+	for (i=0;i<3;i++)
+		for (j=i+1;j<3;j++)
+			if (channels[j]->index < channels[i]->index)
+			{
+				swap = channels[i];
+				channels[i] = channels[j];
+				channels[j] = swap;
+			}
+
+	for (i=0;i<3;i++)
+	{
+		if (!channels[i]->enabled)
+			continue;
+		bytes = channels[i]->storageBits / 8;
+		offset = (offset + bytes - 1) / bytes * bytes;
+		channels[i]->offset = offset;
+		offset += bytes;
+		if (bytes > largest)
+			largest = bytes;
+	}
+	iio->scanSize = (offset + largest - 1) / largest * largest;
+
+	return iio->scanSize == 0 || iio->scanSize > BMP085IIO_SCAN_SIZE;
+}
+
+/* Enables the buffer with a trigger. */
+int BMP085Iio_startBuffer(BMP085Iio *iio,const char *trigger,unsigned int length,overSampling oss)
+{
+	char value[32];
+
+	BMP085Iio_stopBuffer(iio);
+	if (BMP085Iio_setOversampling(iio,oss) ||
+		BMP085Iio_enableChannel(iio,&(iio->temperature),"in_temp") ||
+		BMP085Iio_enableChannel(iio,&(iio->pressure),"in_pressure"))
+		return 1;
+	// The timestamp channel and the monotonic clock are optional.
+	if (!BMP085Iio_enableChannel(iio,&(iio->timestamp),"in_timestamp"))
+		BMP085Iio_writeAttribute(iio,"current_timestamp_clock","monotonic\n");
+	if (BMP085Iio_layout(iio))
+		return 1;
+
+	if (trigger && BMP085Iio_writeAttribute(iio,"trigger/current_trigger",trigger))
+		return 1;
+	if (length)
+	{
+		snprintf(value,sizeof(value),"%u",length);
+		if (BMP085Iio_writeAttribute(iio,"buffer/length",value))
+			return 1;
+	}
+	if (BMP085Iio_writeAttribute(iio,"buffer/enable","1"))
+		return 1;
+
+	iio->bufferFd = open(iio->devicePath,O_RDONLY|O_NONBLOCK|O_CLOEXEC);
+	if (iio->bufferFd < 0)
+	{
+		BMP085Iio_writeAttribute(iio,"buffer/enable","0");
+		return 1;
+	}
+	iio->pending = 0;
+	return 0;
+}
+
+/* Extracts the value of a channel from a scan. */
+static int64_t BMP085Iio_value(const BMP085IioChannel *channel,const unsigned char *scan)
+{
+	unsigned int bytes = channel->storageBits / 8, i;
+	uint64_t value = 0;
+
+	for (i=0;i<bytes;i++)
+		value |= (uint64_t)scan[channel->offset + (channel->bigEndian ? bytes - 1 - i : i)] << (8*i);
+	value >>= channel->shift;
+	if (channel->realBits < 64)
+	{
+		value &= (1ULL << channel->realBits) - 1;
+		if (channel->isSigned && (value >> (channel->realBits - 1)))
+			value |= ~0ULL << channel->realBits;
+	}
+	return (int64_t)value;
+}
+
+/* Takes samples from the buffer without blocking. */
+size_t BMP085Iio_readBuffer(BMP085Iio *iio,BMP085Sample *samples,size_t count)
+{
+	size_t n = 0, want, scans, i;
+	const unsigned char *scan;
+	ssize_t got;
+
+	if (iio->bufferFd < 0)
+		return 0;
+
+	while (n < count)
+	{
+		want = (count - n) * iio->scanSize;
+		if (want > sizeof(iio->buffer))
+			want = sizeof(iio->buffer) / iio->scanSize * iio->scanSize;
+		got = 0;
+		if (iio->pending < want)
+		{
+			got = read(iio->bufferFd,iio->buffer + iio->pending,want - iio->pending);
+			if (got > 0)
+				iio->pending += got;
+		}
+
+		scans = iio->pending / iio->scanSize;
+		if (scans > count - n)
+			scans = count - n;
+		for (i=0;i<scans;i++,n++)
+		{
+			scan = iio->buffer + i*iio->scanSize;
+			memset(&samples[n],0,sizeof(BMP085Sample));
+			samples[n].sequence = iio->sequence++;
+			samples[n].timestamp = iio->timestamp.enabled ? BMP085Iio_value(&(iio->timestamp),scan) : tNow();
+			samples[n].temperatureTimestamp = samples[n].timestamp;
+			// Scaled values are in milli degrees Celsius and [kPa].
+			samples[n].temperature = lround(BMP085Iio_value(&(iio->temperature),scan) * iio->temperature.scale / 100);
+			samples[n].pressure = lround(BMP085Iio_value(&(iio->pressure),scan) * iio->pressure.scale * 1000);
+			samples[n].oss = iio->oss < 0 ? ultraLowPower : (overSampling)iio->oss;
+		}
+		iio->pending -= scans * iio->scanSize;
+		memmove(iio->buffer,iio->buffer + scans * iio->scanSize,iio->pending);
+
+		if (!scans && got <= 0)
+			break;
+	}
+
+	return n;
+}
+
+/* Disables the buffer. */
+void BMP085Iio_stopBuffer(BMP085Iio *iio)
+{
+	if (iio->bufferFd < 0)
+		return;
+	close(iio->bufferFd);
+	iio->bufferFd = -1;
+	BMP085Iio_writeAttribute(iio,"buffer/enable","0");
+}
+
+/* Closes the device. */
+void BMP085Iio_close(BMP085Iio *iio)
+{
+	BMP085Iio_stopBuffer(iio);
+	if (iio->temperatureFd >= 0)
+		close(iio->temperatureFd);
+	if (iio->pressureFd >= 0)
+		close(iio->pressureFd);
+	if (iio->oversamplingFd >= 0)
+		close(iio->oversamplingFd);
+	iio->temperatureFd = iio->pressureFd = iio->oversamplingFd = -1;
+}
@@ -0,0 +1,172 @@
+/*
+ * BMP085 library
+ * bmp085iio.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085iio.h
+  * @brief
+  * Header file part of libBMP085 library. It defines a backend that reads the
+  * sensor through the Linux IIO subsystem, for boards where the kernel bmp280
+  * driver (which also handles the BMP085 and BMP180) is bound to the sensor.
+  *
+  * One-shot measurements read the in_temp_input and in_pressure_input sysfs
+  * attributes through the measure operation of BMP085Iio_busOps, so a sensor
+  * initialized with BMP085_initSensorOnBus() works with BMP085_takeMeasurement()
+  * and everything built on it. The kernel driver does not expose the raw values
+  * or the calibration table. For streaming, the buffered character device is
+  * read with a trigger, see BMP085Iio_startBuffer().
+  *
+  * The sysfs directory and the character device are given as paths, so the
+  * backend works with a fake device tree in a temporary directory.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085IIO_H_
+#define BMP085IIO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "libbmp085.h"
+#include "bmp085stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085IIO_DEF IIO backend definitions */
+/* @{ */
+#define BMP085IIO_SYSFS_ROOT "/sys/bus/iio/devices"	/**< Directory of the IIO devices. */
+#define BMP085IIO_PATH_SIZE 256	/**< Size of the stored paths. */
+#define BMP085IIO_SCAN_SIZE 64	/**< Largest supported size of one scan of the buffer in bytes. */
+#define BMP085IIO_READ_SCANS 32	/**< Scans read from the character device with one read(). */
+/* @} */
+
+/**
+ * @brief Layout of one channel in a scan of the IIO buffer.
+ */
+typedef struct bmp085iiochannel
+{
+	int enabled;	/**< Set when the channel is part of the scan. */
+	int index;	/**< Scan index of the channel. */
+	int isSigned;	/**< Set for a signed value. */
+	int bigEndian;	/**< Set for a big endian value. */
+	unsigned int storageBits;	/**< Bits the value occupies in the scan. */
+	unsigned int realBits;	/**< Significant bits of the value. */
+	unsigned int shift;	/**< Right shift of the value. */
+	unsigned int offset;	/**< Position in the scan in bytes. */
+	double scale;	/**< Scale of the value to milli degrees Celsius or [kPa]. */
+} BMP085IioChannel;
+
+/**
+ * @brief State of an IIO device.
+ */
+typedef struct bmp085iio
+{
+	char sysfsPath[BMP085IIO_PATH_SIZE];	/**< Sysfs directory of the device. */
+	char devicePath[BMP085IIO_PATH_SIZE];	/**< Buffered character device. */
+	int temperatureFd;	/**< in_temp_input, kept open. */
+	int pressureFd;	/**< in_pressure_input, kept open. */
+	int oversamplingFd;	/**< in_pressure_oversampling_ratio, -1 when the driver does not support it. */
+	int oss;	/**< Over sampling mode set in the driver, -1 when unknown. */
+
+	int bufferFd;	/**< Opened character device while the buffer is enabled, -1 otherwise; can be watched with poll(). */
+	BMP085IioChannel temperature;	/**< Temperature channel of the scan. */
+	BMP085IioChannel pressure;	/**< Pressure channel of the scan. */
+	BMP085IioChannel timestamp;	/**< Timestamp channel of the scan. */
+	size_t scanSize;	/**< Size of one scan in bytes. */
+	size_t pending;	/**< Bytes of an incomplete scan in the read buffer. */
+	unsigned long sequence;	/**< Sequence number of the next buffered sample. */
+	unsigned char buffer[BMP085IIO_SCAN_SIZE * BMP085IIO_READ_SCANS];	/**< Read buffer of the character device. */
+} BMP085Iio;
+
+/** \defgroup BMP085IIO_FUNC IIO backend functions */
+/* @{ */
+
+/**
+ * @brief Transport operations of an IIO device.
+ *
+ * The context passed to the operations is a pointer to BMP085Iio. The I2C
+ * address is ignored. Only the measure operation is supported, the register
+ * operations fail.
+ */
+extern const I2CBusOps BMP085Iio_busOps;
+
+/**
+ * @brief Finds the first IIO device of a BMP085 or BMP180 sensor.
+ *
+ * @param[in] root directory of the IIO devices, BMP085IIO_SYSFS_ROOT on a real system.
+ * @param[out] path sysfs directory of the device.
+ * @param[in] size size of \a path.
+ * @return int returns 0 for successful operation, 1 when there is no such device.
+ */
+int BMP085Iio_find(const char *root,char *path,size_t size);
+
+/**
+ * @brief Opens an IIO device.
+ *
+ * @param[in,out] iio pointer to the device.
+ * @param[in] sysfsPath sysfs directory of the device, for example /sys/bus/iio/devices/iio:device0.
+ * @param[in] devicePath buffered character device, NULL for /dev/ and the name of the sysfs directory.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Iio_open(BMP085Iio *iio,const char *sysfsPath,const char *devicePath);
+
+/**
+ * @brief Enables the buffer of the device with a trigger.
+ *
+ * Enables the temperature, pressure and, when available, the timestamp
+ * channels, reads their layout, selects the trigger and enables the buffer.
+ * The timestamps are switched to CLOCK_MONOTONIC when the driver allows it.
+ *
+ * @param[in,out] iio pointer to the device.
+ * @param[in] trigger name of the trigger, NULL to keep the current trigger.
+ * @param[in] length capacity of the kernel buffer in scans, 0 to keep the current length.
+ * @param[in] oss over sampling mode of the pressure conversion.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Iio_startBuffer(BMP085Iio *iio,const char *trigger,unsigned int length,overSampling oss);
+
+/**
+ * @brief Takes up to \a count samples from the buffer without blocking.
+ *
+ * Samples carry the compensated values only; the raw values are zero. The
+ * timestamp comes from the timestamp channel, or from tNow() without it.
+ *
+ * @param[in,out] iio pointer to the device.
+ * @param[out] samples array for the samples.
+ * @param[in] count size of the array.
+ * @return size_t number of samples returned.
+ */
+size_t BMP085Iio_readBuffer(BMP085Iio *iio,BMP085Sample *samples,size_t count);
+
+/**
+ * @brief Disables the buffer of the device.
+ *
+ * @param[in,out] iio pointer to the device.
+ */
+void BMP085Iio_stopBuffer(BMP085Iio *iio);
+
+/**
+ * @brief Disables the buffer and closes the device.
+ *
+ * @param[in,out] iio pointer to the device.
+ */
+void BMP085Iio_close(BMP085Iio *iio);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085IIO_H_ */
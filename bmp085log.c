@@ -0,0 +1,269 @@
+/*
+ * BMP085 library
+ * bmp085log.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085log.c
+ *  @brief Implements the functions defined in the header file bmp085log.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085log.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "bmp085batch.h"
+
+/* Records compensated per call of the batch kernel during a replay. */
+#define BMP085LOG_REPLAY_CHUNK 1024
+
+_Static_assert(sizeof(BMP085LogHeader) == 64,"log header must be 64 bytes");
+_Static_assert(sizeof(BMP085LogRecord) == 16,"log record must be 16 bytes");
+
+/* Writes the whole buffer, resuming after short writes and signals. */
+static int BMP085Log_write(int fd,const void *data,size_t size)
+{
+	const char *buffer = (const char *)data;
+	ssize_t written;
+
+	while (size)
+	{
+		written = write(fd,buffer,size);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return 1;
+		}
+		buffer += written;
+		size -= written;
+	}
+	return 0;
+}
+
+/* Checks the header of a log. */
+static int BMP085Log_validHeader(const BMP085LogHeader *header)
+{
+	return !memcmp(header->magic,BMP085LOG_MAGIC,8) && header->version == BMP085LOG_VERSION &&
+		header->byteOrder == BMP085LOG_BYTE_ORDER && header->headerSize == sizeof(BMP085LogHeader) &&
+		header->recordSize == sizeof(BMP085LogRecord);
+}
+
+/* Cuts the file after the last committed record and positions the writer there. */
+static int BMP085LogWriter_truncate(BMP085LogWriter *writer)
+{
+	off_t end = sizeof(BMP085LogHeader) + writer->committed * sizeof(BMP085LogRecord);
+
+	if (ftruncate(writer->fd,end) || lseek(writer->fd,end,SEEK_SET) != end)
+		return 1;
+	return 0;
+}
+
+/* Writes the header of a new log, or positions the writer at the end of an existing log of the same sensor. */
+static int BMP085LogWriter_prepare(BMP085LogWriter *writer,const BMP085LogHeader *header)
+{
+	BMP085LogHeader existing;
+	struct stat status;
+
+	if (fstat(writer->fd,&status))
+		return 1;
+	if (status.st_size == 0)
+		return BMP085Log_write(writer->fd,header,sizeof(BMP085LogHeader));
+
+	if (status.st_size < (off_t)sizeof(existing) || pread(writer->fd,&existing,sizeof(existing),0) != sizeof(existing) ||
+		!BMP085Log_validHeader(&existing) || memcmp(existing.calibration,header->calibration,22))
+		return 1;
+
+	// Drop an incomplete last record left by an interrupted writer.
+	writer->committed = writer->records = (status.st_size - sizeof(BMP085LogHeader)) / sizeof(BMP085LogRecord);
+	return BMP085LogWriter_truncate(writer);
+}
+
+/* Opens a log for writing. */
+int BMP085LogWriter_open(BMP085LogWriter *writer,const char *path,const BMP085 *sensor)
+{
+	BMP085LogHeader header;
+
+	memset(&header,0,sizeof(header));
+	memcpy(header.magic,BMP085LOG_MAGIC,8);
+	header.version = BMP085LOG_VERSION;
+	header.byteOrder = BMP085LOG_BYTE_ORDER;
+	header.headerSize = sizeof(BMP085LogHeader);
+	header.recordSize = sizeof(BMP085LogRecord);
+	memcpy(header.calibration,sensor->calibrationCoeficients,22);
+	header.I2CAddress = sensor->I2CAddress;
+
+	writer->buffered = 0;
+	writer->records = 0;
+	writer->committed = 0;
+	writer->fd = open(path,O_RDWR|O_CREAT|O_CLOEXEC,0644);
+	if (writer->fd < 0)
+		return 1;
+
+	if (BMP085LogWriter_prepare(writer,&header))
+	{
+		close(writer->fd);
+		writer->fd = -1;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* Appends one raw sample. */
+int BMP085LogWriter_append(BMP085LogWriter *writer,long long timestamp,uint16_t rawTemperature,uint32_t rawPressure,overSampling oss)
+{
+	BMP085LogRecord *record;
+
+	// A full buffer is left by a failed write; the record is rejected unless the retry succeeds.
+	if (writer->buffered == BMP085LOG_BUFFER_RECORDS && BMP085LogWriter_flush(writer))
+		return BMP085LOG_REJECTED;
+
+	record = &(writer->buffer[writer->buffered++]);
+	record->timestamp = timestamp;
+	record->rawPressure = rawPressure;
+	record->rawTemperature = rawTemperature;
+	record->oss = oss;
+	record->reserved = 0;
+	writer->records++;
+
+	if (writer->buffered == BMP085LOG_BUFFER_RECORDS && BMP085LogWriter_flush(writer))
+		return BMP085LOG_FLUSH_PENDING;
+	return 0;
+}
+
+/* Appends the last measurement of a sensor. */
+int BMP085LogWriter_appendSensor(BMP085LogWriter *writer,const BMP085 *sensor)
+{
+	uint16_t rawTemperature = (sensor->rawTemperatureData[0]<<8) + sensor->rawTemperatureData[1];
+	uint32_t rawPressure = ((sensor->rawPressureData[0]<<16) + (sensor->rawPressureData[1]<<8) + sensor->rawPressureData[2]) >> (8-sensor->conversionOss);
+
+	return BMP085LogWriter_append(writer,sensor->conversionStart,rawTemperature,rawPressure,sensor->conversionOss);
+}
+
+/* Writes the buffered records, keeping them and cutting off a partial write on failure. */
+int BMP085LogWriter_flush(BMP085LogWriter *writer)
+{
+	if (!writer->buffered)
+		return 0;
+	if (BMP085Log_write(writer->fd,writer->buffer,writer->buffered * sizeof(BMP085LogRecord)))
+	{
+		BMP085LogWriter_truncate(writer);
+		return 1;
+	}
+
+	writer->committed += writer->buffered;
+	writer->buffered = 0;
+	return 0;
+}
+
+/* Flushes and closes the log. */
+int BMP085LogWriter_close(BMP085LogWriter *writer)
+{
+	int result;
+
+	if (writer->fd < 0)
+		return 1;
+
+	result = BMP085LogWriter_flush(writer);
+	if (close(writer->fd))
+		result = 1;
+	writer->fd = -1;
+
+	return result;
+}
+
+/* Maps a log into memory. */
+int BMP085LogReader_open(BMP085LogReader *reader,const char *path)
+{
+	struct stat status;
+	int fd;
+
+	memset(reader,0,sizeof(BMP085LogReader));
+	fd = open(path,O_RDONLY|O_CLOEXEC);
+	if (fd < 0)
+		return 1;
+	if (fstat(fd,&status) || status.st_size < (off_t)sizeof(BMP085LogHeader))
+	{
+		close(fd);
+		return 1;
+	}
+
+	reader->mapSize = status.st_size;
+	reader->map = mmap(NULL,reader->mapSize,PROT_READ,MAP_SHARED,fd,0);
+	close(fd);
+	if (reader->map == MAP_FAILED)
+	{
+		reader->map = NULL;
+		return 1;
+	}
+	madvise(reader->map,reader->mapSize,MADV_SEQUENTIAL);
+
+	reader->header = (const BMP085LogHeader *)reader->map;
+	reader->records = (const BMP085LogRecord *)((const char *)reader->map + sizeof(BMP085LogHeader));
+	reader->count = (reader->mapSize - sizeof(BMP085LogHeader)) / sizeof(BMP085LogRecord);
+	if (!BMP085Log_validHeader(reader->header) || BMP085_decodeCalibration(&(reader->calibration),reader->header->calibration))
+	{
+		BMP085LogReader_close(reader);
+		return 1;
+	}
+
+	return 0;
+}
+
+/* Compensates a range of records. */
+size_t BMP085LogReader_replay(BMP085LogReader *reader,size_t first,size_t count,int32_t *temperature,int32_t *pressure)
+{
+	uint16_t rawTemperature[BMP085LOG_REPLAY_CHUNK];
+	uint32_t rawPressure[BMP085LOG_REPLAY_CHUNK];
+	const BMP085LogRecord *record;
+	size_t done = 0, n;
+	uint8_t oss;
+
+	if (first >= reader->count)
+		return 0;
+	if (count > reader->count - first)
+		count = reader->count - first;
+
+	// Gather runs of records with the same mode into the arrays of the batch kernel.
+	while (done < count)
+	{
+		record = &(reader->records[first + done]);
+		oss = record->oss;
+		if (oss > ultraHighResolution)
+		{
+			temperature[done] = 0;
+			pressure[done] = 0;
+			reader->corrupt++;
+			done++;
+			continue;
+		}
+		for (n=0;n<BMP085LOG_REPLAY_CHUNK && done + n < count && record[n].oss == oss;n++)
+		{
+			rawTemperature[n] = record[n].rawTemperature;
+			rawPressure[n] = record[n].rawPressure;
+		}
+		BMP085_compensateBatch(&(reader->calibration),oss,rawTemperature,rawPressure,temperature + done,pressure + done,n);
+		done += n;
+	}
+
+	return count;
+}
+
+/* Unmaps the log. */
+void BMP085LogReader_close(BMP085LogReader *reader)
+{
+	if (reader->map)
+		munmap(reader->map,reader->mapSize);
+	memset(reader,0,sizeof(BMP085LogReader));
+}
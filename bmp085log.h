@@ -0,0 +1,215 @@
+/*
+ * BMP085 library
+ * bmp085log.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085log.h
+  * @brief
+  * Header file part of libBMP085 library. It defines an append-only binary
+  * log of raw samples and the functions for writing and replaying it.
+  *
+  * The file starts with a BMP085LogHeader that holds the calibration table of
+  * the sensor, followed by fixed-size BMP085LogRecord records with the raw
+  * temperature, raw pressure, over sampling mode and timestamp of every sample.
+  * Values are stored in the byte order of the host, which is recorded in the
+  * header. The reader maps the file into memory and replays the records
+  * through the batch compensation.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085LOG_H_
+#define BMP085LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085LOG_FORMAT Log file format */
+/* @{ */
+#define BMP085LOG_MAGIC "BMP085LG"	/**< First 8 bytes of a log file. */
+#define BMP085LOG_VERSION 1	/**< Version of the log format. */
+#define BMP085LOG_BYTE_ORDER 0x01020304	/**< Written in the host byte order for detecting foreign logs. */
+#define BMP085LOG_BUFFER_RECORDS 256	/**< Records buffered by the writer before a write(). */
+/* @} */
+
+/** \defgroup BMP085LOG_STATUS Status codes of the log writer */
+/* @{ */
+/** The record was rejected because the full buffer could not be written, send it again later. */
+#define BMP085LOG_REJECTED 1
+/** The record was buffered but the buffer could not be written; the next append or flush retries it. */
+#define BMP085LOG_FLUSH_PENDING 2
+/* @} */
+
+/**
+ * @brief Header at the start of a log file, 64 bytes.
+ */
+typedef struct bmp085logheader
+{
+	char magic[8];	/**< BMP085LOG_MAGIC. */
+	uint32_t version;	/**< BMP085LOG_VERSION. */
+	uint32_t byteOrder;	/**< BMP085LOG_BYTE_ORDER in the byte order of the writer. */
+	uint32_t headerSize;	/**< Size of the header in bytes. */
+	uint32_t recordSize;	/**< Size of one record in bytes. */
+	unsigned char calibration[22];	/**< Calibration table as read from the sensor. */
+	unsigned char I2CAddress;	/**< I2C address of the sensor. */
+	unsigned char reserved[17];	/**< Zero. */
+} BMP085LogHeader;
+
+/**
+ * @brief One raw sample in the log, 16 bytes.
+ */
+typedef struct bmp085logrecord
+{
+	int64_t timestamp;	/**< CLOCK_MONOTONIC time in [ns] when the pressure conversion was started. */
+	uint32_t rawPressure;	/**< Raw pressure value (UP), shifted right by 8-oss. */
+	uint16_t rawTemperature;	/**< Raw temperature value (UT). */
+	uint8_t oss;	/**< Over sampling mode of the pressure conversion. */
+	uint8_t reserved;	/**< Zero. */
+} BMP085LogRecord;
+
+/**
+ * @brief State of a log writer.
+ */
+typedef struct bmp085logwriter
+{
+	int fd;	/**< File descriptor of the log file. */
+	unsigned int buffered;	/**< Number of records in the buffer. */
+	unsigned long records;	/**< Number of records in the file, buffered records included. */
+	unsigned long committed;	/**< Number of records completely written to the file. */
+	BMP085LogRecord buffer[BMP085LOG_BUFFER_RECORDS];	/**< Records not yet written to the file. */
+} BMP085LogWriter;
+
+/**
+ * @brief State of a log reader.
+ */
+typedef struct bmp085logreader
+{
+	void *map;	/**< Mapping of the log file. */
+	size_t mapSize;	/**< Size of the mapping in bytes. */
+	const BMP085LogHeader *header;	/**< Header of the log. */
+	const BMP085LogRecord *records;	/**< Records of the log. */
+	size_t count;	/**< Number of complete records. */
+	size_t corrupt;	/**< Records with an invalid over sampling mode met by BMP085LogReader_replay(). */
+	BMP085Calibration calibration;	/**< Calibration table decoded from the header. */
+} BMP085LogReader;
+
+/** \defgroup BMP085LOG_FUNC Raw sample log functions */
+/* @{ */
+
+/**
+ * @brief Opens a log for writing.
+ *
+ * A new file is created when \a path does not exist. An existing log recorded
+ * with the same calibration table is appended to, after dropping an incomplete
+ * last record. Any other existing file is rejected.
+ *
+ * @param[in,out] writer pointer to the log writer.
+ * @param[in] path name of the log file.
+ * @param[in] sensor initialized sensor whose calibration table is stored in the header.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085LogWriter_open(BMP085LogWriter *writer,const char *path,const BMP085 *sensor);
+
+/**
+ * @brief Appends one raw sample to the log.
+ *
+ * The record is copied into a buffer and written to the file with the
+ * following BMP085LOG_BUFFER_RECORDS-1 records. When that write fails the
+ * records stay in the buffer and the next append or flush retries it; while
+ * the buffer is full and the retry fails, new records are rejected and not
+ * counted in \a records.
+ *
+ * @param[in,out] writer pointer to the log writer.
+ * @param[in] timestamp CLOCK_MONOTONIC time in [ns] of the sample.
+ * @param[in] rawTemperature raw temperature value (UT).
+ * @param[in] rawPressure raw pressure value (UP), shifted right by 8-oss.
+ * @param[in] oss over sampling mode of the pressure conversion.
+ * @return int returns 0 for successful operation, BMP085LOG_REJECTED when the record was not kept,
+ * BMP085LOG_FLUSH_PENDING when it was kept but the buffer could not be written.
+ */
+int BMP085LogWriter_append(BMP085LogWriter *writer,long long timestamp,uint16_t rawTemperature,uint32_t rawPressure,overSampling oss);
+
+/**
+ * @brief Appends the last measurement of a sensor to the log.
+ *
+ * Call after BMP085_takeMeasurement() or a completed BMP085_pollMeasurement().
+ *
+ * @param[in,out] writer pointer to the log writer.
+ * @param[in] sensor the sensor.
+ * @return int returns the status of BMP085LogWriter_append().
+ */
+int BMP085LogWriter_appendSensor(BMP085LogWriter *writer,const BMP085 *sensor);
+
+/**
+ * @brief Writes the buffered records to the file.
+ *
+ * On failure, for example a full file system, a partially written record is
+ * cut off so the file ends after the last complete record, and the records
+ * stay buffered for a later flush.
+ *
+ * @param[in,out] writer pointer to the log writer.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085LogWriter_flush(BMP085LogWriter *writer);
+
+/**
+ * @brief Flushes and closes the log.
+ *
+ * @param[in,out] writer pointer to the log writer.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085LogWriter_close(BMP085LogWriter *writer);
+
+/**
+ * @brief Maps a log into memory and validates its header.
+ *
+ * @param[in,out] reader pointer to the log reader.
+ * @param[in] path name of the log file.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085LogReader_open(BMP085LogReader *reader,const char *path);
+
+/**
+ * @brief Compensates a range of records with the calibration table of the log.
+ *
+ * Runs of records with the same over sampling mode are passed to BMP085_compensateBatch().
+ * A record with an invalid mode is not compensated: its temperature and pressure
+ * are set to 0 and it is counted in \a corrupt.
+ *
+ * @param[in,out] reader pointer to the log reader.
+ * @param[in] first index of the first record.
+ * @param[in] count number of records.
+ * @param[out] temperature temperatures in 0.1 degrees Celsius.
+ * @param[out] pressure pressures in [Pa].
+ * @return size_t number of replayed records, corrupt ones included, fewer than \a count at the end of the log.
+ */
+size_t BMP085LogReader_replay(BMP085LogReader *reader,size_t first,size_t count,int32_t *temperature,int32_t *pressure);
+
+/**
+ * @brief Unmaps the log.
+ *
+ * @param[in,out] reader pointer to the log reader.
+ */
+void BMP085LogReader_close(BMP085LogReader *reader);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085LOG_H_ */
@@ -0,0 +1,300 @@
+/*
+ * BMP085 library
+ * bmp085manager.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085manager.c
+ *  @brief Implements the functions defined in the header file bmp085manager.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085manager.h"
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include "I2Cbus.h"
+
+typedef struct bmp085managerbus
+{
+	BMP085Manager *manager;
+	const I2CBusOps *busOps;
+	void *busContext;
+	int fd;	/* File descriptor of a bus opened by the manager, -1 otherwise. */
+	pthread_t worker;
+	int sensors[BMP085MANAGER_MAX_SENSORS];	/* Indexes of the sensors on the bus. */
+	int sensorCount;
+} BMP085ManagerBus;
+
+struct bmp085manager
+{
+	BMP085ManagerBus buses[BMP085MANAGER_MAX_BUSES];
+	int busCount;
+	BMP085 sensors[BMP085MANAGER_MAX_SENSORS];
+	int sensorCount;
+	long long period;
+	int running;	/* Read and written atomically, the stop flag of the workers. */
+	int started;
+
+	pthread_mutex_t lock;	/* Protects the queue. */
+	pthread_cond_t available;
+	BMP085Reading queue[BMP085MANAGER_QUEUE_SIZE];
+	unsigned int head, count;
+	unsigned long dropped;
+};
+
+/* Adds a reading to the queue, dropping the oldest one when the queue is full. */
+static void BMP085Manager_push(BMP085Manager *manager,const BMP085Reading *reading)
+{
+	pthread_mutex_lock(&(manager->lock));
+	if (manager->count == BMP085MANAGER_QUEUE_SIZE)
+	{
+		manager->head = (manager->head + 1) % BMP085MANAGER_QUEUE_SIZE;
+		manager->count--;
+		manager->dropped++;
+	}
+	manager->queue[(manager->head + manager->count) % BMP085MANAGER_QUEUE_SIZE] = *reading;
+	manager->count++;
+	pthread_cond_signal(&(manager->available));
+	pthread_mutex_unlock(&(manager->lock));
+}
+
+/* Worker thread of a bus: samples the sensors on the bus in rounds with overlapping conversions. */
+static void *BMP085Manager_worker(void *argument)
+{
+	BMP085ManagerBus *bus = (BMP085ManagerBus *)argument;
+	BMP085Manager *manager = bus->manager;
+	BMP085 *sensors[BMP085MANAGER_MAX_SENSORS];
+	int status[BMP085MANAGER_MAX_SENSORS];
+	BMP085Reading reading;
+	long long round = tNow();
+	int i, failed;
+
+	for (i=0;i<bus->sensorCount;i++)
+		sensors[i] = &(manager->sensors[bus->sensors[i]]);
+
+	while (__atomic_load_n(&(manager->running),__ATOMIC_ACQUIRE))
+	{
+		BMP085_takeGroupMeasurement(sensors,bus->sensorCount,status);
+		reading.timestamp = tNow();
+		failed = 0;
+		for (i=0;i<bus->sensorCount;i++)
+		{
+			reading.sensor = bus->sensors[i];
+			reading.status = status[i];
+			reading.temperature = sensors[i]->temperature;
+			reading.pressure = sensors[i]->pressure;
+			BMP085Manager_push(manager,&reading);
+			if (status[i])
+				failed++;
+		}
+
+		if (manager->period)
+		{
+			round += manager->period;
+			if (round <= tNow())
+				round = tNow();
+		}
+		else
+			round = tNow();
+		// A bus failing at once, like an unplugged adapter, would spin and flood the queue.
+		if (failed == bus->sensorCount && round < tNow() + BMP085_PressureConversionTime[ultraHighResolution])
+			round = tNow() + BMP085_PressureConversionTime[ultraHighResolution];
+		if (round > tNow())
+			tDelayUntil(round);
+	}
+
+	return NULL;
+}
+
+/* Creates an empty manager. */
+BMP085Manager *BMP085Manager_create(void)
+{
+	BMP085Manager *manager = calloc(1,sizeof(BMP085Manager));
+	pthread_condattr_t attributes;
+
+	if (!manager)
+		return NULL;
+
+	pthread_mutex_init(&(manager->lock),NULL);
+	pthread_condattr_init(&attributes);
+	pthread_condattr_setclock(&attributes,CLOCK_MONOTONIC);
+	pthread_cond_init(&(manager->available),&attributes);
+	pthread_condattr_destroy(&attributes);
+
+	return manager;
+}
+
+/* Adds a bus with a custom transport. */
+int BMP085Manager_addBusOps(BMP085Manager *manager,const I2CBusOps *busOps,void *busContext)
+{
+	BMP085ManagerBus *bus;
+
+	if (manager->started || manager->busCount == BMP085MANAGER_MAX_BUSES)
+		return -1;
+
+	bus = &(manager->buses[manager->busCount]);
+	bus->manager = manager;
+	bus->busOps = busOps;
+	bus->busContext = busContext;
+	bus->fd = -1;
+	bus->sensorCount = 0;
+
+	return manager->busCount++;
+}
+
+/* Opens an I2C bus and adds it to the manager. */
+int BMP085Manager_addBus(BMP085Manager *manager,char *device)
+{
+	BMP085ManagerBus *bus;
+	int fd, index;
+
+	if (manager->started || manager->busCount == BMP085MANAGER_MAX_BUSES)
+		return -1;
+
+	if (openI2CBus(&fd,device))
+		return -1;
+
+	bus = &(manager->buses[manager->busCount]);
+	index = BMP085Manager_addBusOps(manager,&I2CBus_devOps,&(bus->fd));
+	bus->fd = fd;
+	return index;
+}
+
+/* Initializes a sensor on one of the buses. */
+int BMP085Manager_addSensor(BMP085Manager *manager,int bus,unsigned char I2CAddress,overSampling oss)
+{
+	BMP085ManagerBus *managerBus;
+
+	if (manager->started || bus < 0 || bus >= manager->busCount || manager->sensorCount == BMP085MANAGER_MAX_SENSORS)
+		return -1;
+
+	managerBus = &(manager->buses[bus]);
+	if (BMP085_initSensorOnBus(&(manager->sensors[manager->sensorCount]),managerBus->busOps,managerBus->busContext,I2CAddress,oss))
+		return -1;
+
+	managerBus->sensors[managerBus->sensorCount++] = manager->sensorCount;
+	return manager->sensorCount++;
+}
+
+/* Returns the sensor structure. */
+BMP085 *BMP085Manager_sensor(BMP085Manager *manager,int sensor)
+{
+	if (sensor < 0 || sensor >= manager->sensorCount)
+		return NULL;
+	return &(manager->sensors[sensor]);
+}
+
+/* Starts one worker per bus. */
+int BMP085Manager_start(BMP085Manager *manager,long long period)
+{
+	int i;
+
+	if (manager->started)
+		return 1;
+
+	manager->period = period;
+	__atomic_store_n(&(manager->running),1,__ATOMIC_RELEASE);
+	for (i=0;i<manager->busCount;i++)
+	{
+		// A bus without sensors has nothing to sample.
+		if (!manager->buses[i].sensorCount)
+			continue;
+		if (pthread_create(&(manager->buses[i].worker),NULL,BMP085Manager_worker,&(manager->buses[i])))
+		{
+			__atomic_store_n(&(manager->running),0,__ATOMIC_RELEASE);
+			while (i--)
+				if (manager->buses[i].sensorCount)
+					pthread_join(manager->buses[i].worker,NULL);
+			return 1;
+		}
+	}
+	manager->started = 1;
+
+	return 0;
+}
+
+/* Takes the oldest reading from the queue. */
+int BMP085Manager_read(BMP085Manager *manager,BMP085Reading *reading,long long timeout)
+{
+	long long deadline = tNow() + timeout;
+	struct timespec time;
+	int result = 1;
+
+	time.tv_sec = deadline / 1000000000LL;
+	time.tv_nsec = deadline % 1000000000LL;
+
+	pthread_mutex_lock(&(manager->lock));
+	while (!manager->count && __atomic_load_n(&(manager->running),__ATOMIC_ACQUIRE) && timeout)
+	{
+		if (timeout < 0)
+			pthread_cond_wait(&(manager->available),&(manager->lock));
+		else if (pthread_cond_timedwait(&(manager->available),&(manager->lock),&time))
+			break;
+	}
+	if (manager->count)
+	{
+		*reading = manager->queue[manager->head];
+		manager->head = (manager->head + 1) % BMP085MANAGER_QUEUE_SIZE;
+		manager->count--;
+		result = 0;
+	}
+	pthread_mutex_unlock(&(manager->lock));
+
+	return result;
+}
+
+/* Number of readings dropped because the queue was full. */
+unsigned long BMP085Manager_dropped(BMP085Manager *manager)
+{
+	unsigned long dropped;
+
+	pthread_mutex_lock(&(manager->lock));
+	dropped = manager->dropped;
+	pthread_mutex_unlock(&(manager->lock));
+
+	return dropped;
+}
+
+/* Stops the worker threads. */
+void BMP085Manager_stop(BMP085Manager *manager)
+{
+	int i;
+
+	if (!manager->started)
+		return;
+
+	pthread_mutex_lock(&(manager->lock));
+	__atomic_store_n(&(manager->running),0,__ATOMIC_RELEASE);
+	pthread_cond_broadcast(&(manager->available));
+	pthread_mutex_unlock(&(manager->lock));
+
+	for (i=0;i<manager->busCount;i++)
+		if (manager->buses[i].sensorCount)
+			pthread_join(manager->buses[i].worker,NULL);
+	manager->started = 0;
+}
+
+/* Stops the manager and releases its resources. */
+void BMP085Manager_destroy(BMP085Manager *manager)
+{
+	int i;
+
+	if (!manager)
+		return;
+
+	BMP085Manager_stop(manager);
+	for (i=0;i<manager->busCount;i++)
+		if (manager->buses[i].fd >= 0)
+			closeI2CBus(&(manager->buses[i].fd));
+
+	pthread_cond_destroy(&(manager->available));
+	pthread_mutex_destroy(&(manager->lock));
+	free(manager);
+}
@@ -0,0 +1,167 @@
+/*
+ * BMP085 library
+ * bmp085manager.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085manager.h
+  * @brief
+  * Header file part of libBMP085 library. It defines a manager that owns
+  * several I2C buses and the sensors attached to them.
+  *
+  * Every bus is served by its own worker thread, so conversions on
+  * different adapters run in parallel, and the conversions of sensors
+  * on the same bus overlap. The readings of all sensors are delivered
+  * through a single queue read with BMP085Manager_read().
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085MANAGER_H_
+#define BMP085MANAGER_H_
+
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085MANAGER_LIMITS Sensor manager limits */
+/* @{ */
+#define BMP085MANAGER_MAX_BUSES 8	/**< Maximum number of buses per manager. */
+#define BMP085MANAGER_MAX_SENSORS 32	/**< Maximum number of sensors per manager. */
+#define BMP085MANAGER_QUEUE_SIZE 256	/**< Number of readings buffered for the consumer. */
+/* @} */
+
+/**
+ * @brief Result of one measurement delivered by the manager.
+ */
+typedef struct bmp085reading
+{
+	int sensor;	/**< Sensor index returned by BMP085Manager_addSensor(). */
+	int status;	/**< 0 for a successful measurement, 1 for failure. */
+	long long timestamp;	/**< CLOCK_MONOTONIC time in [ns] when the measurement completed. */
+	float temperature;	/**< Temperature in degrees Celsius. */
+	long pressure;	/**< Barometric pressure in [Pa]. */
+} BMP085Reading;
+
+/**
+ * @brief Opaque sensor manager.
+ */
+typedef struct bmp085manager BMP085Manager;
+
+/** \defgroup BMP085MANAGER_FUNC Sensor manager functions */
+/* @{ */
+
+/**
+ * @brief Creates an empty manager.
+ *
+ * @return BMP085Manager* the new manager, NULL when out of memory.
+ */
+BMP085Manager *BMP085Manager_create(void);
+
+/**
+ * @brief Opens an I2C bus and adds it to the manager.
+ *
+ * The bus is closed by BMP085Manager_destroy().
+ *
+ * @param[in,out] manager the manager.
+ * @param[in] device name of the device file that represents the I2C interface on the system.
+ * @return int index of the bus, -1 for failure.
+ */
+int BMP085Manager_addBus(BMP085Manager *manager,char *device);
+
+/**
+ * @brief Adds a bus with a custom transport to the manager.
+ *
+ * @param[in,out] manager the manager.
+ * @param[in] busOps transport operations of the bus.
+ * @param[in] busContext context passed to the transport operations.
+ * @return int index of the bus, -1 for failure.
+ */
+int BMP085Manager_addBusOps(BMP085Manager *manager,const I2CBusOps *busOps,void *busContext);
+
+/**
+ * @brief Initializes a sensor on one of the buses of the manager.
+ *
+ * Sensors can be added only while the manager is stopped.
+ *
+ * @param[in,out] manager the manager.
+ * @param[in] bus index of the bus returned by BMP085Manager_addBus() or BMP085Manager_addBusOps().
+ * @param[in] I2CAddress address of the sensor on the I2C bus.
+ * @param[in] oss over sampling mode of the sensor.
+ * @return int index of the sensor, -1 for failure.
+ */
+int BMP085Manager_addSensor(BMP085Manager *manager,int bus,unsigned char I2CAddress,overSampling oss);
+
+/**
+ * @brief Returns the sensor structure for configuring it before the manager is started.
+ *
+ * @param[in] manager the manager.
+ * @param[in] sensor index of the sensor.
+ * @return BMP085* the sensor, NULL for an invalid index.
+ */
+BMP085 *BMP085Manager_sensor(BMP085Manager *manager,int sensor);
+
+/**
+ * @brief Starts one worker thread per bus with sensors.
+ *
+ * Each worker samples all of the sensors on its bus in rounds with
+ * BMP085_takeGroupMeasurement(), overlapping their conversions. After a
+ * round in which every sensor of the bus failed, the next round starts
+ * no earlier than the maximum pressure conversion time later.
+ *
+ * @param[in,out] manager the manager.
+ * @param[in] period minimum time between the start of two rounds on a bus in [ns], 0 for continuous sampling.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Manager_start(BMP085Manager *manager,long long period);
+
+/**
+ * @brief Takes the oldest reading from the queue.
+ *
+ * @param[in,out] manager the manager.
+ * @param[out] reading the reading.
+ * @param[in] timeout maximum time to wait for a reading in [ns], 0 to return immediately, negative to wait forever.
+ * @return int returns 0 when a reading was returned, 1 on timeout or when the manager is stopped and the queue is empty.
+ */
+int BMP085Manager_read(BMP085Manager *manager,BMP085Reading *reading,long long timeout);
+
+/**
+ * @brief Returns the number of readings dropped because the queue was full.
+ *
+ * @param[in] manager the manager.
+ */
+unsigned long BMP085Manager_dropped(BMP085Manager *manager);
+
+/**
+ * @brief Stops the worker threads and waits for them to finish.
+ *
+ * Readings still in the queue can be read after the manager is stopped.
+ *
+ * @param[in,out] manager the manager.
+ */
+void BMP085Manager_stop(BMP085Manager *manager);
+
+/**
+ * @brief Stops the manager, closes the buses it opened and releases its memory.
+ *
+ * @param[in] manager the manager.
+ */
+void BMP085Manager_destroy(BMP085Manager *manager);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085MANAGER_H_ */
@@ -0,0 +1,113 @@
+/*
+ * BMP085 library
+ * bmp085scheduler.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085scheduler.c
+ *  @brief Implements the functions defined in the header file bmp085scheduler.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085scheduler.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/timerfd.h>
+#include "I2Cbus.h"
+
+/* Creates the timer and arms it. */
+int BMP085Scheduler_init(BMP085Scheduler *scheduler,long long period,long long start)
+{
+	struct itimerspec timer;
+
+	memset(scheduler,0,sizeof(BMP085Scheduler));
+	scheduler->fd = -1;
+	if (period <= 0)
+		return 1;
+
+	if (!start)
+		start = tNow() + period;
+	scheduler->period = period;
+	scheduler->start = start;
+
+	scheduler->fd = timerfd_create(CLOCK_MONOTONIC,TFD_NONBLOCK|TFD_CLOEXEC);
+	if (scheduler->fd < 0)
+		return 1;
+
+	// Absolute first expiration and a fixed interval: the kernel keeps the deadlines.
+	timer.it_value.tv_sec = start/1000000000LL;
+	timer.it_value.tv_nsec = start%1000000000LL;
+	timer.it_interval.tv_sec = period/1000000000LL;
+	timer.it_interval.tv_nsec = period%1000000000LL;
+	if (timerfd_settime(scheduler->fd,TFD_TIMER_ABSTIME,&timer,NULL))
+	{
+		close(scheduler->fd);
+		scheduler->fd = -1;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* File descriptor for an event loop. */
+int BMP085Scheduler_fd(const BMP085Scheduler *scheduler)
+{
+	return scheduler->fd;
+}
+
+/* Consumes the deadlines that have passed. */
+int BMP085Scheduler_acknowledge(BMP085Scheduler *scheduler)
+{
+	uint64_t expirations;
+
+	if (read(scheduler->fd,&expirations,sizeof(expirations)) != sizeof(expirations))
+		return (errno == EAGAIN) ? 0 : -1;
+
+	scheduler->expirations += expirations;
+	scheduler->missed += expirations - 1;
+	scheduler->ticks++;
+
+	scheduler->lateness = tNow() - BMP085Scheduler_deadline(scheduler);
+	if (scheduler->lateness > scheduler->maxLateness)
+		scheduler->maxLateness = scheduler->lateness;
+
+	return 1;
+}
+
+/* Blocks until the next deadline. */
+int BMP085Scheduler_wait(BMP085Scheduler *scheduler)
+{
+	struct pollfd fd = { scheduler->fd, POLLIN, 0 };
+	int result;
+
+	while ((result = BMP085Scheduler_acknowledge(scheduler)) == 0)
+		if (poll(&fd,1,-1) < 0 && errno != EINTR)
+			return 1;
+
+	return (result < 0) ? 1 : 0;
+}
+
+/* Time of the last delivered deadline. */
+long long BMP085Scheduler_deadline(const BMP085Scheduler *scheduler)
+{
+	if (!scheduler->expirations)
+		return scheduler->start;
+	return scheduler->start + (long long)(scheduler->expirations - 1) * scheduler->period;
+}
+
+/* Disarms the timer. */
+void BMP085Scheduler_destroy(BMP085Scheduler *scheduler)
+{
+	if (scheduler->fd >= 0)
+		close(scheduler->fd);
+	scheduler->fd = -1;
+}
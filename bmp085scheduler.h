@@ -0,0 +1,112 @@
+/*
+ * BMP085 library
+ * bmp085scheduler.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085scheduler.h
+  * @brief
+  * Header file part of libBMP085 library. It defines a fixed-rate scheduler
+  * for periodic measurements.
+  *
+  * The deadlines are absolute times of the CLOCK_MONOTONIC clock kept by a
+  * Linux timerfd, so the time spent in bus I/O does not shift the following
+  * deadlines and the sampling rate does not drift. Deadlines that pass while
+  * the previous measurement is still running are reported as missed. The
+  * file descriptor of the timer can be added to an epoll or poll set.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085SCHEDULER_H_
+#define BMP085SCHEDULER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief State of the fixed-rate scheduler.
+ */
+typedef struct bmp085scheduler
+{
+	int fd;	/**< File descriptor of the timerfd, readable when a deadline has passed. */
+	long long period;	/**< Time between two deadlines in [ns]. */
+	long long start;	/**< CLOCK_MONOTONIC time in [ns] of the first deadline. */
+	unsigned long long expirations;	/**< Number of deadlines that have passed. */
+	unsigned long ticks;	/**< Number of deadlines delivered to the caller. */
+	unsigned long missed;	/**< Number of deadlines skipped because the caller was late. */
+	long long lateness;	/**< Time in [ns] between the last delivered deadline and its handling. */
+	long long maxLateness;	/**< Largest lateness in [ns]. */
+} BMP085Scheduler;
+
+/** \defgroup BMP085SCHEDULER_FUNC Fixed-rate scheduler functions */
+/* @{ */
+
+/**
+ * @brief Creates the timer and arms it.
+ *
+ * @param[in,out] scheduler pointer to the scheduler.
+ * @param[in] period time between two deadlines in [ns].
+ * @param[in] start CLOCK_MONOTONIC time in [ns] of the first deadline, 0 for one period from now.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Scheduler_init(BMP085Scheduler *scheduler,long long period,long long start);
+
+/**
+ * @brief Returns the file descriptor to be watched for readability in an event loop.
+ *
+ * The descriptor is non-blocking. When it is readable, call BMP085Scheduler_acknowledge().
+ *
+ * @param[in] scheduler pointer to the scheduler.
+ */
+int BMP085Scheduler_fd(const BMP085Scheduler *scheduler);
+
+/**
+ * @brief Consumes the deadlines that have passed without blocking.
+ *
+ * When more than one deadline has passed since the last call, the extra
+ * deadlines are counted as missed.
+ *
+ * @param[in,out] scheduler pointer to the scheduler.
+ * @return int 1 when a deadline has passed, 0 when none has passed and -1 for failure.
+ */
+int BMP085Scheduler_acknowledge(BMP085Scheduler *scheduler);
+
+/**
+ * @brief Blocks until the next deadline and consumes it.
+ *
+ * @param[in,out] scheduler pointer to the scheduler.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Scheduler_wait(BMP085Scheduler *scheduler);
+
+/**
+ * @brief Returns the CLOCK_MONOTONIC time in [ns] of the last delivered deadline.
+ *
+ * @param[in] scheduler pointer to the scheduler.
+ */
+long long BMP085Scheduler_deadline(const BMP085Scheduler *scheduler);
+
+/**
+ * @brief Disarms the timer and closes its file descriptor.
+ *
+ * @param[in,out] scheduler pointer to the scheduler.
+ */
+void BMP085Scheduler_destroy(BMP085Scheduler *scheduler);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085SCHEDULER_H_ */
@@ -0,0 +1,209 @@
+/*
+ * BMP085 library
+ * bmp085shm.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085shm.c
+ *  @brief Implements the functions defined in the header file bmp085shm.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085shm.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define BMP085SHM_MASK (BMP085SHM_HISTORY - 1)
+
+_Static_assert((BMP085SHM_HISTORY & BMP085SHM_MASK) == 0,"history must be a power of two");
+
+/* Starts an update, readers retry until it is finished. */
+static void BMP085ShmPublisher_begin(BMP085ShmSegment *segment)
+{
+	__atomic_store_n(&(segment->sequence),segment->sequence + 1,__ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/* Finishes an update. */
+static void BMP085ShmPublisher_end(BMP085ShmSegment *segment)
+{
+	segment->updated = tNow();
+	__atomic_store_n(&(segment->sequence),segment->sequence + 1,__ATOMIC_RELEASE);
+}
+
+/* Creates and maps the segment. */
+int BMP085ShmPublisher_open(BMP085ShmPublisher *publisher,const char *name,const BMP085 *sensor,long long period)
+{
+	BMP085ShmSegment *segment;
+	int fd;
+
+	publisher->segment = NULL;
+	if (strlen(name) >= sizeof(publisher->name))
+		return 1;
+	strcpy(publisher->name,name);
+
+	fd = shm_open(name,O_RDWR|O_CREAT|O_CLOEXEC,0644);
+	if (fd < 0)
+		return 1;
+	if (ftruncate(fd,sizeof(BMP085ShmSegment)))
+	{
+		close(fd);
+		return 1;
+	}
+	segment = mmap(NULL,sizeof(BMP085ShmSegment),PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+	close(fd);
+	if (segment == MAP_FAILED)
+		return 1;
+
+	// Readers of a reused segment see an update in progress until it is cleared.
+	BMP085ShmPublisher_begin(segment);
+	memset((char *)segment + offsetof(BMP085ShmSegment,count),0,sizeof(BMP085ShmSegment) - offsetof(BMP085ShmSegment,count));
+	segment->size = sizeof(BMP085ShmSegment);
+	segment->history = BMP085SHM_HISTORY;
+	memcpy(segment->calibration,sensor->calibrationCoeficients,22);
+	segment->I2CAddress = sensor->I2CAddress;
+	segment->reserved = 0;
+	segment->publisher = getpid();
+	segment->period = period;
+	segment->version = BMP085SHM_VERSION;
+	segment->magic = BMP085SHM_MAGIC;
+	BMP085ShmPublisher_end(segment);
+
+	publisher->segment = segment;
+	return 0;
+}
+
+/* Publishes a sample. */
+void BMP085ShmPublisher_publish(BMP085ShmPublisher *publisher,const BMP085Sample *sample)
+{
+	BMP085ShmSegment *segment = publisher->segment;
+
+	BMP085ShmPublisher_begin(segment);
+	segment->samples[segment->count & BMP085SHM_MASK] = *sample;
+	segment->count++;
+	BMP085ShmPublisher_end(segment);
+}
+
+/* Counts a failed measurement. */
+void BMP085ShmPublisher_failed(BMP085ShmPublisher *publisher)
+{
+	BMP085ShmSegment *segment = publisher->segment;
+
+	BMP085ShmPublisher_begin(segment);
+	segment->failures++;
+	BMP085ShmPublisher_end(segment);
+}
+
+/* Unmaps and removes the segment. */
+void BMP085ShmPublisher_close(BMP085ShmPublisher *publisher)
+{
+	if (!publisher->segment)
+		return;
+	munmap(publisher->segment,sizeof(BMP085ShmSegment));
+	shm_unlink(publisher->name);
+	publisher->segment = NULL;
+}
+
+/* Maps an existing segment for reading. */
+int BMP085ShmClient_open(BMP085ShmClient *client,const char *name)
+{
+	const BMP085ShmSegment *segment;
+	struct stat status;
+	int fd;
+
+	client->segment = NULL;
+	fd = shm_open(name,O_RDONLY|O_CLOEXEC,0);
+	if (fd < 0)
+		return 1;
+	if (fstat(fd,&status) || status.st_size != sizeof(BMP085ShmSegment))
+	{
+		close(fd);
+		return 1;
+	}
+	segment = mmap(NULL,sizeof(BMP085ShmSegment),PROT_READ,MAP_SHARED,fd,0);
+	close(fd);
+	if (segment == MAP_FAILED)
+		return 1;
+
+	if (segment->magic != BMP085SHM_MAGIC || segment->version != BMP085SHM_VERSION ||
+		segment->size != sizeof(BMP085ShmSegment) || segment->history != BMP085SHM_HISTORY)
+	{
+		munmap((void *)segment,sizeof(BMP085ShmSegment));
+		return 1;
+	}
+
+	client->segment = segment;
+	return 0;
+}
+
+/* Number of published samples. */
+unsigned long BMP085ShmClient_count(const BMP085ShmClient *client)
+{
+	return __atomic_load_n(&(client->segment->count),__ATOMIC_ACQUIRE);
+}
+
+/*
+ * Copies the most recent samples under the sequence lock. The copy is repeated
+ * when the publisher updated the segment in the meantime.
+ */
+static size_t BMP085ShmClient_copy(const BMP085ShmClient *client,BMP085Sample *samples,size_t count)
+{
+	const BMP085ShmSegment *segment = client->segment;
+	unsigned long sequence, published;
+	size_t n, i;
+	int attempt;
+
+	for (attempt=0;attempt<BMP085SHM_READ_RETRIES;attempt++)
+	{
+		sequence = __atomic_load_n(&(segment->sequence),__ATOMIC_ACQUIRE);
+		if (sequence & 1)
+		{
+			// The publisher may be preempted in the middle of an update.
+			sched_yield();
+			continue;
+		}
+
+		published = segment->count;
+		n = published < BMP085SHM_HISTORY ? published : BMP085SHM_HISTORY;
+		if (n > count)
+			n = count;
+		for (i=0;i<n;i++)
+			samples[i] = segment->samples[(published - n + i) & BMP085SHM_MASK];
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&(segment->sequence),__ATOMIC_RELAXED) == sequence)
+			return n;
+	}
+
+	return 0;
+}
+
+/* Copies the latest sample. */
+int BMP085ShmClient_latest(const BMP085ShmClient *client,BMP085Sample *sample)
+{
+	return BMP085ShmClient_copy(client,sample,1) ? 0 : 1;
+}
+
+/* Copies the most recent samples, oldest first. */
+size_t BMP085ShmClient_history(const BMP085ShmClient *client,BMP085Sample *samples,size_t count)
+{
+	return BMP085ShmClient_copy(client,samples,count);
+}
+
+/* Unmaps the segment. */
+void BMP085ShmClient_close(BMP085ShmClient *client)
+{
+	if (client->segment)
+		munmap((void *)client->segment,sizeof(BMP085ShmSegment));
+	client->segment = NULL;
+}
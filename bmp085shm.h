@@ -0,0 +1,179 @@
+/*
+ * BMP085 library
+ * bmp085shm.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085shm.h
+  * @brief
+  * Header file part of libBMP085 library. It defines the publishing of samples
+  * in a POSIX shared memory segment, for one process that owns the sensor and
+  * any number of readers.
+  *
+  * The segment holds the calibration table of the sensor and a ring of the
+  * last BMP085SHM_HISTORY samples, guarded by a sequence lock. The publisher
+  * never waits for readers, and a reader only maps the segment and copies
+  * from it, so reading the latest sample needs no system call and causes no
+  * traffic on the I2C bus.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085SHM_H_
+#define BMP085SHM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "libbmp085.h"
+#include "bmp085stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085SHM_DEF Shared memory segment definitions */
+/* @{ */
+#define BMP085SHM_MAGIC 0x35385042	/**< "BP85" at the start of the segment. */
+#define BMP085SHM_VERSION 1	/**< Version of the segment layout. */
+#define BMP085SHM_HISTORY 256	/**< Samples kept in the segment, a power of two. */
+#define BMP085SHM_READ_RETRIES 10000	/**< Attempts of a reader before it gives up on a publisher stuck in an update. */
+#define BMP085SHM_DEFAULT_NAME "/bmp085"	/**< Default name of the segment. */
+/* @} */
+
+/**
+ * @brief Layout of the shared memory segment.
+ */
+typedef struct bmp085shmsegment
+{
+	uint32_t magic;	/**< BMP085SHM_MAGIC. */
+	uint32_t version;	/**< BMP085SHM_VERSION. */
+	uint32_t size;	/**< Size of the segment in bytes. */
+	uint32_t history;	/**< Number of samples in the ring. */
+	unsigned char calibration[22];	/**< Calibration table of the published sensor. */
+	unsigned char I2CAddress;	/**< I2C address of the published sensor. */
+	unsigned char reserved;	/**< Zero. */
+	int32_t publisher;	/**< Process ID of the publisher. */
+	long long period;	/**< Time between two samples in [ns] set by the publisher, 0 when unknown. */
+
+	unsigned long sequence __attribute__((aligned(64)));	/**< Sequence lock, odd while the publisher updates the segment. */
+	unsigned long count;	/**< Number of published samples. */
+	unsigned long failures;	/**< Number of failed measurements reported by the publisher. */
+	long long updated;	/**< CLOCK_MONOTONIC time in [ns] of the last update. */
+
+	BMP085Sample samples[BMP085SHM_HISTORY] __attribute__((aligned(64)));	/**< Ring of the last samples, sample n is at n % history. */
+} BMP085ShmSegment;
+
+/**
+ * @brief Publishing side of a segment.
+ */
+typedef struct bmp085shmpublisher
+{
+	BMP085ShmSegment *segment;	/**< Mapped segment. */
+	char name[64];	/**< Name of the segment. */
+} BMP085ShmPublisher;
+
+/**
+ * @brief Reading side of a segment.
+ */
+typedef struct bmp085shmclient
+{
+	const BMP085ShmSegment *segment;	/**< Mapped segment. */
+} BMP085ShmClient;
+
+/** \defgroup BMP085SHM_FUNC Shared memory publishing functions */
+/* @{ */
+
+/**
+ * @brief Creates the segment and prepares it for publishing the samples of a sensor.
+ *
+ * An existing segment with the same name is reused and cleared.
+ *
+ * @param[in,out] publisher pointer to the publisher.
+ * @param[in] name name of the segment, starting with '/'.
+ * @param[in] sensor initialized sensor whose calibration table is stored in the segment.
+ * @param[in] period time between two samples in [ns], 0 when unknown.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085ShmPublisher_open(BMP085ShmPublisher *publisher,const char *name,const BMP085 *sensor,long long period);
+
+/**
+ * @brief Publishes a sample.
+ *
+ * @param[in,out] publisher pointer to the publisher.
+ * @param[in] sample the sample.
+ */
+void BMP085ShmPublisher_publish(BMP085ShmPublisher *publisher,const BMP085Sample *sample);
+
+/**
+ * @brief Counts a failed measurement in the segment.
+ *
+ * @param[in,out] publisher pointer to the publisher.
+ */
+void BMP085ShmPublisher_failed(BMP085ShmPublisher *publisher);
+
+/**
+ * @brief Unmaps and removes the segment.
+ *
+ * Readers that still have the segment mapped keep the last published samples.
+ *
+ * @param[in,out] publisher pointer to the publisher.
+ */
+void BMP085ShmPublisher_close(BMP085ShmPublisher *publisher);
+
+/**
+ * @brief Maps an existing segment for reading.
+ *
+ * @param[in,out] client pointer to the client.
+ * @param[in] name name of the segment.
+ * @return int returns 0 for successful operation, 1 when the segment does not exist or has another layout.
+ */
+int BMP085ShmClient_open(BMP085ShmClient *client,const char *name);
+
+/**
+ * @brief Returns the number of published samples, for detecting new samples cheaply.
+ *
+ * @param[in] client pointer to the client.
+ */
+unsigned long BMP085ShmClient_count(const BMP085ShmClient *client);
+
+/**
+ * @brief Copies the latest sample.
+ *
+ * @param[in] client pointer to the client.
+ * @param[out] sample the latest sample.
+ * @return int returns 0 for successful operation, 1 when nothing was published yet or the publisher is stuck in an update.
+ */
+int BMP085ShmClient_latest(const BMP085ShmClient *client,BMP085Sample *sample);
+
+/**
+ * @brief Copies up to \a count of the most recent samples, oldest first.
+ *
+ * @param[in] client pointer to the client.
+ * @param[out] samples array for the samples.
+ * @param[in] count size of the array.
+ * @return size_t number of copied samples.
+ */
+size_t BMP085ShmClient_history(const BMP085ShmClient *client,BMP085Sample *samples,size_t count);
+
+/**
+ * @brief Unmaps the segment.
+ *
+ * @param[in,out] client pointer to the client.
+ */
+void BMP085ShmClient_close(BMP085ShmClient *client);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085SHM_H_ */
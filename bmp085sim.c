@@ -0,0 +1,356 @@
+/*
+ * BMP085 library
+ * bmp085sim.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085sim.c
+ *  @brief Implements the functions defined in the header file bmp085sim.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085sim.h"
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/timerfd.h>
+#include "libbmp085.h"
+
+/* Typical conversion times from the Bosch datasheet. */
+const long BMP085Sim_TemperatureConversionTime = 3000000L;
+const long BMP085Sim_PressureConversionTime[]={ 3000000L, 5000000L, 9000000L, 17000000L };
+
+/* RMS pressure noise from the Bosch datasheet in [Pa] and the matching peak of the triangular noise (RMS*sqrt(6)). */
+const int BMP085Sim_PressureNoise[]={ 6, 5, 4, 3 };
+static const int BMP085Sim_datasheetNoisePeak[]={ 15, 12, 10, 7 };
+
+/* Calibration table from the calculation example in the Bosch datasheet. */
+static const unsigned char BMP085Sim_datasheetCalibration[22] = {
+	0x01, 0x98,	/* AC1 = 408 */
+	0xFF, 0xB8,	/* AC2 = -72 */
+	0xC7, 0xD1,	/* AC3 = -14383 */
+	0x7F, 0xE5,	/* AC4 = 32741 */
+	0x7F, 0xF5,	/* AC5 = 32757 */
+	0x5A, 0x71,	/* AC6 = 23153 */
+	0x18, 0x2E,	/* B1 = 6190 */
+	0x00, 0x04,	/* B2 = 4 */
+	0x80, 0x00,	/* MB = -32768 */
+	0xDD, 0xF9,	/* MC = -8711 */
+	0x0B, 0x34	/* MD = 2868 */
+};
+
+/* Smallest raw temperature value that gives at least the simulated temperature. */
+static long BMP085Sim_rawTemperature(const BMP085Calibration *calibration,long temperature)
+{
+	long low = 0, high = 0xFFFF, middle;
+	int32_t b5;
+
+	while (low < high)
+	{
+		middle = (low + high) / 2;
+		if (BMP085_calculateTemperature(calibration,middle,&b5) < temperature)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+/* Smallest raw pressure value that gives at least the requested pressure. */
+static long BMP085Sim_rawPressure(const BMP085Calibration *calibration,long temperature,long pressure,int oss)
+{
+	long low = 0, high = (0x10000L << oss) - 1, middle;
+	int32_t b5;
+
+	BMP085_calculateTemperature(calibration,BMP085Sim_rawTemperature(calibration,temperature),&b5);
+	while (low < high)
+	{
+		middle = (low + high) / 2;
+		if (BMP085_calculatePressure(calibration,oss,middle,b5) < pressure)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+/* Triangular noise in [-peak,peak] from a linear congruential generator. */
+static int BMP085Sim_noise(BMP085Sim *sim,int oss)
+{
+	int peak = sim->datasheetNoise ? BMP085Sim_datasheetNoisePeak[oss] : sim->noise;
+	long sum = 0;
+	int i;
+
+	if (peak <= 0)
+		return 0;
+	for (i=0;i<2;i++)
+	{
+		sim->seed = sim->seed * 1103515245UL + 12345UL;
+		sum += (long)((sim->seed >> 16) % (unsigned long)(peak + 1));
+	}
+	return (int)(sum - peak);
+}
+
+/* Stores the result of a finished conversion in the data registers. */
+static void BMP085Sim_update(BMP085Sim *sim)
+{
+	BMP085Calibration calibration;
+	unsigned char command = sim->command;
+	int oss = command >> 6;
+	long raw;
+
+	if (!command || tNow() < sim->conversionEnd)
+		return;
+
+	/* Sco bit is cleared at the end of the conversion. */
+	sim->registers[BMP085_CONTROL_REG] &= ~BMP085_CONTROL_SCO;
+	sim->command = 0;
+
+	/* An invalid calibration table leaves the data registers unchanged. */
+	if (BMP085_decodeCalibration(&calibration,&(sim->registers[BMP085_CALIBRATION_TABLE])))
+		return;
+
+	if (command == BMP085_START_TEMPERATURE_MEASUREMENT)
+	{
+		raw = BMP085Sim_rawTemperature(&calibration,sim->temperature);
+		sim->registers[BMP085_DATA_REG_MSB] = (raw >> 8) & 0xFF;
+		sim->registers[BMP085_DATA_REG_LSB] = raw & 0xFF;
+		sim->registers[BMP085_DATA_REG_XLASB] = 0;
+	}
+	else
+	{
+		raw = BMP085Sim_rawPressure(&calibration,sim->temperature,sim->pressure + BMP085Sim_noise(sim,oss),oss) << (8 - oss);
+		sim->registers[BMP085_DATA_REG_MSB] = (raw >> 16) & 0xFF;
+		sim->registers[BMP085_DATA_REG_LSB] = (raw >> 8) & 0xFF;
+		sim->registers[BMP085_DATA_REG_XLASB] = raw & 0xFF;
+	}
+}
+
+/* Decides whether the transaction is not acknowledged. */
+static int BMP085Sim_fault(BMP085Sim *sim)
+{
+	int fault = sim->wedged;
+
+	if (!fault && sim->failureRate > 0)
+	{
+		sim->failureSeed = sim->failureSeed * 1103515245UL + 12345UL;
+		fault = ((sim->failureSeed >> 16) & 0xFFFF) < sim->failureRate * 65536.0;
+	}
+	if (fault)
+	{
+		sim->failures++;
+		errno = EREMOTEIO;
+	}
+	return fault;
+}
+
+static int BMP085Sim_read(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+{
+	BMP085Sim *sim = (BMP085Sim *)context;
+
+	if (I2CAddress != sim->I2CAddress || size < 0 || registry + size > 256 || BMP085Sim_fault(sim))
+		return ERROR_I2C_READ_FAILED;
+
+	BMP085Sim_update(sim);
+	if (sim->command && registry <= BMP085_DATA_REG_XLASB && registry + size > BMP085_DATA_REG_MSB)
+		sim->earlyReads++;
+
+	memcpy(buffer,&(sim->registers[registry]),size);
+	sim->reads++;
+	sim->bytesRead += size;
+	sim->bytesWritten++;
+
+	return 0;
+}
+
+static int BMP085Sim_write(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+{
+	BMP085Sim *sim = (BMP085Sim *)context;
+	int oss = value >> 6;
+
+	if (I2CAddress != sim->I2CAddress || BMP085Sim_fault(sim))
+		return ERROR_I2C_WRITE_FAILED;
+
+	sim->writes++;
+	sim->bytesWritten += 2;
+
+	if (registry != BMP085_CONTROL_REG)
+		return 0;
+
+	BMP085Sim_update(sim);
+	if (value == BMP085_START_TEMPERATURE_MEASUREMENT)
+		sim->conversionEnd = tNow() + BMP085Sim_TemperatureConversionTime;
+	else if ((value & 0x3F) == BMP085_START_PRESSURE_MEASUREMENT)
+		sim->conversionEnd = tNow() + BMP085Sim_PressureConversionTime[oss];
+	else
+		return 0;
+
+	sim->command = value;
+	sim->registers[BMP085_CONTROL_REG] = value | BMP085_CONTROL_SCO;
+
+	// The EOC pin rises when the conversion ends.
+	if (sim->eocLine >= 0)
+	{
+		struct itimerspec edge = { { 0, 0 }, { sim->conversionEnd/1000000000LL, sim->conversionEnd%1000000000LL } };
+
+		timerfd_settime(sim->eocLine,TFD_TIMER_ABSTIME,&edge,NULL);
+	}
+
+	return 0;
+}
+
+static int BMP085Sim_recover(void *context)
+{
+	BMP085Sim *sim = (BMP085Sim *)context;
+
+	sim->wedged = 0;
+	sim->recoveries++;
+	return 0;
+}
+
+const I2CBusOps BMP085Sim_busOps = { .read = BMP085Sim_read, .write = BMP085Sim_write, .recover = BMP085Sim_recover };
+
+/* Initializes the simulated sensor. */
+void BMP085Sim_init(BMP085Sim *sim,unsigned char I2CAddress)
+{
+	memset(sim,0,sizeof(BMP085Sim));
+	sim->I2CAddress = I2CAddress;
+	sim->seed = 1;
+	sim->failureSeed = 1;
+	sim->eocLine = -1;
+	sim->registers[BMP085_CHIP_ID_REG] = BMP085_CHIP_ID;
+	memcpy(&(sim->registers[BMP085_CALIBRATION_TABLE]),BMP085Sim_datasheetCalibration,22);
+	BMP085Sim_setEnvironment(sim,150,69964);
+}
+
+/* Sets the simulated temperature and pressure. */
+void BMP085Sim_setEnvironment(BMP085Sim *sim,long temperature,long pressure)
+{
+	sim->temperature = temperature;
+	sim->pressure = pressure;
+}
+
+/* Generates one pair of raw values without the bus and the conversion time. */
+void BMP085Sim_rawSample(BMP085Sim *sim,overSampling oss,uint16_t *rawTemperature,uint32_t *rawPressure)
+{
+	BMP085Calibration calibration;
+
+	BMP085_decodeCalibration(&calibration,&(sim->registers[BMP085_CALIBRATION_TABLE]));
+	*rawTemperature = BMP085Sim_rawTemperature(&calibration,sim->temperature);
+	*rawPressure = BMP085Sim_rawPressure(&calibration,sim->temperature,sim->pressure + BMP085Sim_noise(sim,oss),oss);
+}
+
+/* Opens a timerfd that fires at the end of every conversion. */
+int BMP085Sim_openEocLine(BMP085Sim *sim)
+{
+	if (sim->eocLine < 0)
+		sim->eocLine = timerfd_create(CLOCK_MONOTONIC,TFD_NONBLOCK|TFD_CLOEXEC);
+	return sim->eocLine;
+}
+
+/* Closes the simulated EOC line. */
+void BMP085Sim_closeEocLine(BMP085Sim *sim)
+{
+	if (sim->eocLine >= 0)
+		close(sim->eocLine);
+	sim->eocLine = -1;
+}
+
+/* Clears the transaction counters. */
+void BMP085Sim_resetCounters(BMP085Sim *sim)
+{
+	sim->reads = 0;
+	sim->writes = 0;
+	sim->bytesRead = 0;
+	sim->bytesWritten = 0;
+	sim->earlyReads = 0;
+}
+
+/* Keeps the simulated bus busy for the duration of a transfer. */
+static void BMP085SimBus_transfer(BMP085SimBus *bus,int bytes)
+{
+	if (bus->byteTime)
+		tDelayUntil(tNow() + (long long)bus->byteTime * bytes);
+}
+
+static BMP085Sim *BMP085SimBus_device(BMP085SimBus *bus,unsigned char I2CAddress)
+{
+	int i;
+
+	for (i=0;i<bus->deviceCount;i++)
+		if (bus->devices[i]->I2CAddress == I2CAddress)
+			return bus->devices[i];
+	return NULL;
+}
+
+/*
+ * Selects the slave address like I2C_SLAVE on a shared i2c-dev descriptor and
+ * yields, so a concurrent user can select another address before the
+ * transfer. Returns the address the transfer goes to.
+ */
+static unsigned char BMP085SimBus_select(BMP085SimBus *bus,unsigned char I2CAddress)
+{
+	if (!bus->splitTransactions)
+		return I2CAddress;
+	bus->selected = I2CAddress;
+	sched_yield();
+	return bus->selected;
+}
+
+static int BMP085SimBus_read(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char *buffer,int size)
+{
+	BMP085SimBus *bus = (BMP085SimBus *)context;
+	BMP085Sim *sim = BMP085SimBus_device(bus,I2CAddress = BMP085SimBus_select(bus,I2CAddress));
+
+	/* Address and register, repeated START with the address, then the data. */
+	BMP085SimBus_transfer(bus,3 + size);
+	if (!sim)
+		return ERROR_I2C_READ_FAILED;
+	return BMP085Sim_read(sim,I2CAddress,registry,buffer,size);
+}
+
+static int BMP085SimBus_write(void *context,unsigned char I2CAddress,unsigned char registry,unsigned char value)
+{
+	BMP085SimBus *bus = (BMP085SimBus *)context;
+	BMP085Sim *sim = BMP085SimBus_device(bus,I2CAddress = BMP085SimBus_select(bus,I2CAddress));
+
+	BMP085SimBus_transfer(bus,3);
+	if (!sim)
+		return ERROR_I2C_WRITE_FAILED;
+	return BMP085Sim_write(sim,I2CAddress,registry,value);
+}
+
+static int BMP085SimBus_recover(void *context)
+{
+	BMP085SimBus *bus = (BMP085SimBus *)context;
+	int i;
+
+	for (i=0;i<bus->deviceCount;i++)
+		BMP085Sim_recover(bus->devices[i]);
+	return 0;
+}
+
+const I2CBusOps BMP085SimBus_busOps = { .read = BMP085SimBus_read, .write = BMP085SimBus_write, .recover = BMP085SimBus_recover };
+
+/* Initializes an empty simulated bus. */
+void BMP085SimBus_init(BMP085SimBus *bus,long byteTime)
+{
+	memset(bus,0,sizeof(BMP085SimBus));
+	bus->byteTime = byteTime;
+}
+
+/* Attaches a simulated sensor to the bus. */
+int BMP085SimBus_attach(BMP085SimBus *bus,BMP085Sim *sim)
+{
+	if (bus->deviceCount == BMP085SIM_MAX_DEVICES)
+		return 1;
+	bus->devices[bus->deviceCount++] = sim;
+	return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * BMP085 library
+ * bmp085sim.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085sim.h
+  * @brief
+  * Header file part of libBMP085 library. It defines an in-process simulation
+  * of the Bosch BMP085/BMP180 sensor that can be used as a transport
+  * instead of the Linux i2c-dev interface.
+  *
+  * The simulated sensor implements the register map, the calibration table
+  * at 0xAA and the conversion timing for every over sampling mode.
+  * Raw values are derived from the configured temperature and pressure,
+  * so the output is deterministic and can be checked against the datasheet.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085SIM_H_
+#define BMP085SIM_H_
+
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief State of a simulated BMP085 sensor.
+ */
+typedef struct bmp085sim
+{
+	unsigned char I2CAddress;	/**< I2C address the simulated sensor responds to.*/
+	unsigned char registers[256];	/**< Register map of the sensor.*/
+	long temperature;	/**< Simulated temperature in 0.1 degrees Celsius.*/
+	long pressure;	/**< Simulated barometric pressure in Pa.*/
+	int noise;	/**< Peak amplitude of the pressure noise in Pa, 0 disables the noise.*/
+	int datasheetNoise;	/**< Set to use the datasheet RMS noise of each over sampling mode instead of noise.*/
+	unsigned long seed;	/**< State of the noise generator.*/
+	unsigned char command;	/**< Conversion in progress, 0 when the sensor is idle.*/
+	long long conversionEnd;	/**< CLOCK_MONOTONIC time in [ns] when the running conversion ends.*/
+	unsigned long reads;	/**< Number of read transactions.*/
+	unsigned long writes;	/**< Number of write transactions.*/
+	unsigned long bytesRead;	/**< Number of bytes read from the sensor.*/
+	unsigned long bytesWritten;	/**< Number of bytes written to the sensor, register address included.*/
+	unsigned long earlyReads;	/**< Data reads issued before the conversion was complete.*/
+	double failureRate;	/**< Probability that a transaction is not acknowledged, 0 disables the failures.*/
+	int wedged;	/**< Set to fail every transaction until the transport is recovered.*/
+	unsigned long failureSeed;	/**< State of the failure generator.*/
+	unsigned long failures;	/**< Number of transactions that were not acknowledged.*/
+	unsigned long recoveries;	/**< Number of recover operations.*/
+	int eocLine;	/**< timerfd standing in for the EOC line, -1 when not opened.*/
+} BMP085Sim;
+
+#define BMP085SIM_MAX_DEVICES 16	/**< Maximum number of simulated sensors on a simulated bus. */
+
+/**
+ * @brief Simulated I2C bus with several simulated sensors attached.
+ *
+ * Transactions are routed to the sensor with the matching I2C address.
+ */
+typedef struct bmp085simbus
+{
+	BMP085Sim *devices[BMP085SIM_MAX_DEVICES];	/**< Sensors attached to the bus.*/
+	int deviceCount;	/**< Number of attached sensors.*/
+	long byteTime;	/**< Time in [ns] the bus is busy per transferred byte, 0 for an infinitely fast bus.*/
+	int splitTransactions;	/**< Set to split every transaction into the I2C_SLAVE, write() and read() steps of the i2c-dev fallback, with the selected address shared by all users of the bus.*/
+	volatile unsigned char selected;	/**< Slave address selected by the last split transaction.*/
+} BMP085SimBus;
+
+/** \defgroup BMP085SIM_FUNC Simulated sensor functions */
+/* @{ */
+
+/**
+ * @brief Conversion time of the simulated sensor for the temperature measurement in [ns].
+ */
+extern const long BMP085Sim_TemperatureConversionTime;
+
+/**
+ * @brief Conversion time of the simulated sensor for the pressure measurement in [ns], indexed by overSampling.
+ */
+extern const long BMP085Sim_PressureConversionTime[];
+
+/**
+ * @brief RMS pressure noise in [Pa] from the Bosch datasheet, indexed by overSampling.
+ *
+ * Used for the simulated noise when datasheetNoise is set.
+ */
+extern const int BMP085Sim_PressureNoise[];
+
+/**
+ * @brief Transport operations of the simulated sensor.
+ *
+ * The context passed to the operations is a pointer to BMP085Sim. A transaction
+ * that is not acknowledged, selected by failureRate or wedged, fails with errno
+ * set to EREMOTEIO and leaves the sensor unchanged. The recover operation clears
+ * wedged.
+ */
+extern const I2CBusOps BMP085Sim_busOps;
+
+/**
+ * @brief Initializes the simulated sensor.
+ *
+ * Loads the calibration table from the example in the Bosch datasheet and sets
+ * the environment to the datasheet example values (15.0 degrees Celsius, 69964 Pa).
+ *
+ * @param[in,out] sim pointer to the simulated sensor.
+ * @param[in] I2CAddress I2C address the simulated sensor responds to.
+ */
+void BMP085Sim_init(BMP085Sim *sim,unsigned char I2CAddress);
+
+/**
+ * @brief Sets the temperature and pressure returned by the following conversions.
+ *
+ * @param[in,out] sim pointer to the simulated sensor.
+ * @param[in] temperature temperature in 0.1 degrees Celsius.
+ * @param[in] pressure barometric pressure in Pa.
+ */
+void BMP085Sim_setEnvironment(BMP085Sim *sim,long temperature,long pressure);
+
+/**
+ * @brief Generates the raw values of one measurement without the bus and the conversion time.
+ *
+ * The values are the same as the ones a conversion started over the bus would
+ * produce, including the noise, so long noisy sample streams can be generated quickly.
+ *
+ * @param[in,out] sim pointer to the simulated sensor.
+ * @param[in] oss over sampling mode of the pressure conversion.
+ * @param[out] rawTemperature raw temperature value (UT).
+ * @param[out] rawPressure raw pressure value (UP), shifted right by 8-oss.
+ */
+void BMP085Sim_rawSample(BMP085Sim *sim,overSampling oss,uint16_t *rawTemperature,uint32_t *rawPressure);
+
+/**
+ * @brief Opens a simulated EOC line of the sensor.
+ *
+ * The line is a non-blocking timerfd armed at the end of every conversion, so
+ * it becomes readable at the moment a real EOC pin would rise. Pass it to
+ * BMP085_setEndOfConversionLine().
+ *
+ * @param[in,out] sim pointer to the simulated sensor.
+ * @return int file descriptor of the line, -1 for failure.
+ */
+int BMP085Sim_openEocLine(BMP085Sim *sim);
+
+/**
+ * @brief Closes the simulated EOC line.
+ *
+ * @param[in,out] sim pointer to the simulated sensor.
+ */
+void BMP085Sim_closeEocLine(BMP085Sim *sim);
+
+/**
+ * @brief Clears the transaction counters of the simulated sensor.
+ *
+ * @param[in,out] sim pointer to the simulated sensor.
+ */
+void BMP085Sim_resetCounters(BMP085Sim *sim);
+
+/**
+ * @brief Transport operations of the simulated bus.
+ *
+ * The context passed to the operations is a pointer to BMP085SimBus. The recover
+ * operation recovers every attached sensor.
+ */
+extern const I2CBusOps BMP085SimBus_busOps;
+
+/**
+ * @brief Initializes an empty simulated bus.
+ *
+ * @param[in,out] bus pointer to the simulated bus.
+ * @param[in] byteTime time in [ns] needed to transfer one byte, 0 for an infinitely fast bus.
+ */
+void BMP085SimBus_init(BMP085SimBus *bus,long byteTime);
+
+/**
+ * @brief Attaches a simulated sensor to the simulated bus.
+ *
+ * @param[in,out] bus pointer to the simulated bus.
+ * @param[in] sim pointer to an initialized simulated sensor.
+ * @return int returns 0 for successful operation, 1 when the bus is full.
+ */
+int BMP085SimBus_attach(BMP085SimBus *bus,BMP085Sim *sim);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085SIM_H_ */
@@ -0,0 +1,95 @@
+/*
+ * BMP085 library
+ * bmp085stats.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085stats.c
+ *  @brief Implements the functions defined in the header file bmp085stats.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085stats.h"
+
+#include <errno.h>
+
+static const char *BMP085Stats_phaseName[] = { "start command", "conversion", "data read", "compensation", "transfer", "retry" };
+static const char *BMP085Stats_errorName[] = { "nack", "timeout", "bus", "other" };
+
+/* Counts a failed transaction by type. */
+void BMP085Stats_countError(BMP085Stats *stats,int error)
+{
+	switch (error)
+	{
+		case EREMOTEIO:
+		case ENXIO:
+			stats->errors[statsErrorNack]++;
+			break;
+		case ETIMEDOUT:
+			stats->errors[statsErrorTimeout]++;
+			break;
+		case EIO:
+		case EAGAIN:
+		case EBUSY:
+			stats->errors[statsErrorBus]++;
+			break;
+		default:
+			stats->errors[statsErrorOther]++;
+	}
+}
+
+/* Upper bound of the bucket holding the percentile. */
+long long BMP085Stats_percentile(const BMP085Histogram *histogram,double percentile)
+{
+	unsigned long rank, seen = 0;
+	int bucket;
+
+	if (!histogram->count)
+		return 0;
+
+	rank = (unsigned long)(histogram->count * percentile / 100.0);
+	if (rank >= histogram->count)
+		rank = histogram->count - 1;
+	for (bucket=0;bucket<BMP085STATS_BUCKETS;bucket++)
+	{
+		seen += histogram->buckets[bucket];
+		if (seen > rank)
+			break;
+	}
+	if (bucket >= BMP085STATS_BUCKETS - 1)
+		return histogram->maximum;
+
+	// The bucket bound never exceeds the largest recorded latency.
+	return (2LL << bucket) < histogram->maximum ? (2LL << bucket) : histogram->maximum;
+}
+
+/* Prints the counters and the histograms. */
+void BMP085Stats_print(const BMP085Stats *stats,const char *name,FILE *output)
+{
+	const BMP085Histogram *histogram;
+	int phase, error;
+
+	fprintf(output,"%s:\n",name);
+	fprintf(output,"  transactions: %lu reads (%lu bytes), %lu writes (%lu bytes)\n",stats->reads,stats->bytesRead,stats->writes,stats->bytesWritten);
+	fprintf(output,"  errors: %lu read, %lu write (",stats->readErrors,stats->writeErrors);
+	for (error=0;error<statsErrors;error++)
+		fprintf(output,"%s%s %lu",error ? ", " : "",BMP085Stats_errorName[error],stats->errors[error]);
+	fprintf(output,")\n");
+	if (stats->measurements || stats->failedMeasurements)
+		fprintf(output,"  measurements: %lu completed, %lu failed\n",stats->measurements,stats->failedMeasurements);
+
+	for (phase=0;phase<statsPhases;phase++)
+	{
+		histogram = &(stats->latency[phase]);
+		if (!histogram->count)
+			continue;
+		fprintf(output,"  %-14s n=%-8lu mean %10.1f us  min %10.1f us  p50 <%9.1f us  p99 <%9.1f us  max %10.1f us\n",
+			BMP085Stats_phaseName[phase],histogram->count,histogram->total/1e3/histogram->count,histogram->minimum/1e3,
+			BMP085Stats_percentile(histogram,50)/1e3,BMP085Stats_percentile(histogram,99)/1e3,histogram->maximum/1e3);
+	}
+}
@@ -0,0 +1,186 @@
+/*
+ * BMP085 library
+ * bmp085stats.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085stats.h
+  * @brief
+  * Header file part of libBMP085 library. It defines the performance
+  * counters and latency histograms kept per sensor and per I2C bus.
+  *
+  * The instrumentation is compiled in only when the library is built with
+  * BMP085_STATS defined (make STATS=1). Without it the instrumentation points
+  * expand to nothing and BMP085_getStats() and I2CBus_getStats() report failure.
+  * The layout of the BMP085 structure does not depend on the flag, so
+  * applications need not be built with it.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085STATS_H_
+#define BMP085STATS_H_
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085STATS_DEF Statistics definitions */
+/* @{ */
+/** Number of histogram buckets, bucket k counts latencies in [2^k,2^(k+1)) ns. */
+#define BMP085STATS_BUCKETS 36
+/* @} */
+
+/**
+ * @brief Measured phases of a sensor measurement and of a bus transaction.
+ */
+typedef enum statsPhase
+{
+	statsStartCommand = 0,	/**< Sending a start of conversion command. */
+	statsConversion,	/**< Conversion start to the beginning of the data read, Sco polling included. */
+	statsDataRead,	/**< Reading the conversion result. */
+	statsCompensation,	/**< Calculating the temperature or pressure from the raw value. */
+	statsTransfer,	/**< One bus transaction, recorded for buses. */
+	statsRetry,	/**< First failure of a retried transaction to its final result. */
+	statsPhases
+} statsPhase;
+
+/**
+ * @brief Types of transport errors, derived from errno of the failed transaction.
+ */
+typedef enum statsError
+{
+	statsErrorNack = 0,	/**< No acknowledge from the sensor (EREMOTEIO, ENXIO). */
+	statsErrorTimeout,	/**< Bus timeout (ETIMEDOUT). */
+	statsErrorBus,	/**< Adapter or bus failure (EIO, EAGAIN, EBUSY). */
+	statsErrorOther,	/**< Any other failure. */
+	statsErrors
+} statsError;
+
+/**
+ * @brief Latency histogram with power of two buckets.
+ */
+typedef struct bmp085histogram
+{
+	unsigned long count;	/**< Number of recorded latencies. */
+	unsigned long long total;	/**< Sum of the recorded latencies in [ns]. */
+	long long minimum;	/**< Smallest latency in [ns]. */
+	long long maximum;	/**< Largest latency in [ns]. */
+	unsigned long buckets[BMP085STATS_BUCKETS];	/**< Latency distribution. */
+} BMP085Histogram;
+
+/**
+ * @brief Counters and histograms of a sensor or of a bus.
+ */
+typedef struct bmp085stats
+{
+	unsigned long reads;	/**< Read transactions. */
+	unsigned long writes;	/**< Write transactions. */
+	unsigned long bytesRead;	/**< Data bytes read. */
+	unsigned long bytesWritten;	/**< Bytes written, register address included. */
+	unsigned long readErrors;	/**< Failed read transactions. */
+	unsigned long writeErrors;	/**< Failed write transactions. */
+	unsigned long errors[statsErrors];	/**< Failed transactions by type. */
+	unsigned long measurements;	/**< Completed measurements, counted for sensors. */
+	unsigned long failedMeasurements;	/**< Failed measurements, counted for sensors. */
+	BMP085Histogram latency[statsPhases];	/**< Latency of every phase. */
+	long long mark;	/**< CLOCK_MONOTONIC time in [ns] of the last instrumentation point. */
+} BMP085Stats;
+
+/** \defgroup BMP085STATS_FUNC Statistics functions */
+/* @{ */
+
+/**
+ * @brief Adds a latency to a histogram.
+ *
+ * @param[in,out] histogram the histogram.
+ * @param[in] latency latency in [ns].
+ */
+static inline void BMP085Stats_record(BMP085Histogram *histogram,long long latency)
+{
+	int bucket = latency > 1 ? 63 - __builtin_clzll((unsigned long long)latency) : 0;
+
+	if (bucket >= BMP085STATS_BUCKETS)
+		bucket = BMP085STATS_BUCKETS - 1;
+	histogram->buckets[bucket]++;
+	if (!histogram->count++ || latency < histogram->minimum)
+		histogram->minimum = latency;
+	if (latency > histogram->maximum)
+		histogram->maximum = latency;
+	histogram->total += latency;
+}
+
+/**
+ * @brief Records the time since the last instrumentation point as the latency of a phase.
+ *
+ * @param[in,out] stats the statistics.
+ * @param[in] phase the phase that ended.
+ * @param[in] now current CLOCK_MONOTONIC time in [ns], becomes the new instrumentation point.
+ */
+static inline void BMP085Stats_lap(BMP085Stats *stats,statsPhase phase,long long now)
+{
+	BMP085Stats_record(&(stats->latency[phase]),now - stats->mark);
+	stats->mark = now;
+}
+
+/**
+ * @brief Counts a failed transaction by the errno it left behind.
+ *
+ * @param[in,out] stats the statistics.
+ * @param[in] error errno after the failed transaction.
+ */
+void BMP085Stats_countError(BMP085Stats *stats,int error);
+
+/**
+ * @brief Returns an upper bound of the given percentile of a histogram in [ns].
+ *
+ * @param[in] histogram the histogram.
+ * @param[in] percentile percentile between 0 and 100.
+ * @return long long upper bound of the bucket holding the percentile, 0 for an empty histogram.
+ */
+long long BMP085Stats_percentile(const BMP085Histogram *histogram,double percentile);
+
+/**
+ * @brief Prints the counters and a summary of every non-empty histogram.
+ *
+ * @param[in] stats the statistics.
+ * @param[in] name name printed in the heading.
+ * @param[in] output stream for the report.
+ */
+void BMP085Stats_print(const BMP085Stats *stats,const char *name,FILE *output);
+
+/* @} */
+
+/*
+ * Instrumentation points used inside the library. They expand to nothing
+ * unless the library is built with BMP085_STATS.
+ */
+#ifdef BMP085_STATS
+#define BMP085STATS_MARK(target) ((target)->mark = tNow())
+#define BMP085STATS_LAP(target,phase) BMP085Stats_lap((target),(phase),tNow())
+#define BMP085STATS_RECORD(target,phase,value) BMP085Stats_record(&((target)->latency[phase]),(value))
+#define BMP085STATS_ADD(target,field,value) ((target)->field += (value))
+#define BMP085STATS_ERROR(target,error) BMP085Stats_countError((target),(error))
+#else
+#define BMP085STATS_MARK(target) ((void)0)
+#define BMP085STATS_LAP(target,phase) ((void)0)
+#define BMP085STATS_RECORD(target,phase,value) ((void)0)
+#define BMP085STATS_ADD(target,field,value) ((void)0)
+#define BMP085STATS_ERROR(target,error) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085STATS_H_ */
@@ -0,0 +1,186 @@
+/*
+ * BMP085 library
+ * bmp085stream.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085stream.c
+ *  @brief Implements the functions defined in the header file bmp085stream.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085stream.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "I2Cbus.h"
+
+/* Writes a sample into the ring buffer, or counts an overrun when it is full. */
+static void BMP085Stream_push(BMP085Stream *stream,const BMP085Sample *sample)
+{
+	unsigned long head = stream->head;
+
+	if (head - stream->tailCache > stream->mask)
+	{
+		stream->tailCache = __atomic_load_n(&(stream->tail),__ATOMIC_ACQUIRE);
+		if (head - stream->tailCache > stream->mask)
+		{
+			__atomic_store_n(&(stream->overruns),stream->overruns + 1,__ATOMIC_RELAXED);
+			return;
+		}
+	}
+
+	stream->buffer[head & stream->mask] = *sample;
+	__atomic_store_n(&(stream->head),head + 1,__ATOMIC_RELEASE);
+}
+
+/* Fills a sample from the last measurement of a sensor. */
+void BMP085Stream_sample(const BMP085 *sensor,BMP085Sample *sample)
+{
+	// The pressure conversion is the last one started by the measurement.
+	sample->timestamp = sensor->conversionStart;
+	sample->temperatureTimestamp = sensor->temperatureTime;
+	sample->oss = sensor->conversionOss;
+	sample->rawTemperature = (sensor->rawTemperatureData[0]<<8) + sensor->rawTemperatureData[1];
+	sample->rawPressure = ((sensor->rawPressureData[0]<<16) + (sensor->rawPressureData[1]<<8) + sensor->rawPressureData[2]) >> (8-sensor->conversionOss);
+	sample->temperature = (sensor->b5 + 8) >> 4;
+	sample->pressure = sensor->pressure;
+}
+
+/* Acquisition thread. */
+static void *BMP085Stream_thread(void *argument)
+{
+	BMP085Stream *stream = (BMP085Stream *)argument;
+	BMP085 *sensor = stream->sensor;
+	BMP085Sample sample;
+	long long next = tNow();
+	int failed;
+
+	while (__atomic_load_n(&(stream->running),__ATOMIC_ACQUIRE))
+	{
+		failed = stream->adaptive ? BMP085Adaptive_takeMeasurement(stream->adaptive,sensor) : BMP085_takeMeasurement(sensor);
+		if (failed)
+			__atomic_store_n(&(stream->failures),stream->failures + 1,__ATOMIC_RELAXED);
+		else
+		{
+			// Only measured samples are numbered, so every gap is an overrun.
+			BMP085Stream_sample(sensor,&sample);
+			sample.sequence = stream->sequence++;
+			BMP085Stream_push(stream,&sample);
+		}
+
+		if (stream->period)
+		{
+			next += stream->period;
+			if (next <= tNow())
+				next = tNow();
+		}
+		else
+			next = tNow();
+		// A transport failing at once, like an unplugged adapter, would spin.
+		if (failed && next < tNow() + BMP085_PressureConversionTime[sensor->conversionOss])
+			next = tNow() + BMP085_PressureConversionTime[sensor->conversionOss];
+		if (next > tNow())
+			tDelayUntil(next);
+	}
+
+	return NULL;
+}
+
+/* Initializes the sampling engine. */
+int BMP085Stream_init(BMP085Stream *stream,BMP085 *sensor,size_t capacity,long long period)
+{
+	memset(stream,0,sizeof(BMP085Stream));
+
+	if (capacity < 2 || (capacity & (capacity - 1)))
+		return 1;
+
+	stream->buffer = malloc(capacity * sizeof(BMP085Sample));
+	if (!stream->buffer)
+		return 1;
+
+	stream->sensor = sensor;
+	stream->mask = capacity - 1;
+	stream->period = period;
+
+	return 0;
+}
+
+/* Lets a controller select the mode of every sample. */
+void BMP085Stream_setAdaptive(BMP085Stream *stream,BMP085Adaptive *adaptive)
+{
+	stream->adaptive = adaptive;
+}
+
+/* Starts the acquisition thread. */
+int BMP085Stream_start(BMP085Stream *stream)
+{
+	if (stream->running)
+		return 1;
+
+	stream->running = 1;
+	if (pthread_create(&(stream->thread),NULL,BMP085Stream_thread,stream))
+	{
+		stream->running = 0;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* Takes the oldest sample from the ring buffer. */
+int BMP085Stream_read(BMP085Stream *stream,BMP085Sample *sample)
+{
+	return BMP085Stream_readBatch(stream,sample,1) ? 0 : 1;
+}
+
+/* Takes up to count samples from the ring buffer. */
+size_t BMP085Stream_readBatch(BMP085Stream *stream,BMP085Sample *samples,size_t count)
+{
+	unsigned long tail = stream->tail;
+	unsigned long available = __atomic_load_n(&(stream->head),__ATOMIC_ACQUIRE) - tail;
+	size_t i;
+
+	if (count > available)
+		count = available;
+	for (i=0;i<count;i++)
+		samples[i] = stream->buffer[(tail + i) & stream->mask];
+
+	__atomic_store_n(&(stream->tail),tail + count,__ATOMIC_RELEASE);
+	return count;
+}
+
+/* Number of samples dropped because the ring buffer was full. */
+unsigned long BMP085Stream_overruns(const BMP085Stream *stream)
+{
+	return __atomic_load_n(&(stream->overruns),__ATOMIC_RELAXED);
+}
+
+/* Number of failed measurements. */
+unsigned long BMP085Stream_failures(const BMP085Stream *stream)
+{
+	return __atomic_load_n(&(stream->failures),__ATOMIC_RELAXED);
+}
+
+/* Stops the acquisition thread. */
+void BMP085Stream_stop(BMP085Stream *stream)
+{
+	if (!stream->running)
+		return;
+
+	__atomic_store_n(&(stream->running),0,__ATOMIC_RELEASE);
+	pthread_join(stream->thread,NULL);
+}
+
+/* Stops the sampling engine and releases the ring buffer. */
+void BMP085Stream_destroy(BMP085Stream *stream)
+{
+	BMP085Stream_stop(stream);
+	free(stream->buffer);
+	stream->buffer = NULL;
+}
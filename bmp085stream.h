@@ -0,0 +1,183 @@
+/*
+ * BMP085 library
+ * bmp085stream.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085stream.h
+  * @brief
+  * Header file part of libBMP085 library. It defines a continuous sampling
+  * engine that acquires samples from one sensor in a background thread.
+  *
+  * Samples are written into a single-producer single-consumer ring buffer
+  * without locks. The acquisition thread never waits for the consumer: when
+  * the ring is full the new sample is dropped and counted as an overrun,
+  * and the gap is visible to the consumer through the sample sequence numbers.
+  * Failed measurements are not numbered and do not leave gaps; they are
+  * counted separately and delay the next attempt by one conversion time.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085STREAM_H_
+#define BMP085STREAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "libbmp085.h"
+#include "bmp085adaptive.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One timestamped sample produced by the sampling engine.
+ */
+typedef struct bmp085sample
+{
+	unsigned long sequence;	/**< Number of the sample, consecutive unless samples were dropped as overruns. */
+	long long timestamp;	/**< CLOCK_MONOTONIC time in [ns] when the pressure conversion was started. */
+	long long temperatureTimestamp;	/**< CLOCK_MONOTONIC time in [ns] when the temperature conversion was started. */
+	uint16_t rawTemperature;	/**< Raw temperature value (UT). */
+	uint32_t rawPressure;	/**< Raw pressure value (UP), shifted right by 8-oss. */
+	int32_t temperature;	/**< Temperature in 0.1 degrees Celsius. */
+	int32_t pressure;	/**< Barometric pressure in [Pa]. */
+	overSampling oss;	/**< Over sampling mode of the pressure conversion. */
+} BMP085Sample;
+
+/**
+ * @brief State of the continuous sampling engine.
+ *
+ * The producer and consumer indexes live on separate cache lines, so the
+ * acquisition thread and the consumer do not invalidate each other's cache.
+ */
+typedef struct bmp085stream
+{
+	BMP085 *sensor;	/**< Sampled sensor. */
+	BMP085Adaptive *adaptive;	/**< Controller selecting the mode of every sample, NULL for the mode of the sensor. */
+	BMP085Sample *buffer;	/**< Ring buffer of samples. */
+	unsigned long mask;	/**< Capacity of the ring buffer minus one. */
+	long long period;	/**< Time between the start of two samples in [ns], 0 for continuous sampling. */
+	pthread_t thread;	/**< Acquisition thread. */
+	int running;	/**< Set while the acquisition thread is running. */
+
+	unsigned long head __attribute__((aligned(64)));	/**< Next slot written by the producer. */
+	unsigned long tailCache;	/**< Last consumer index seen by the producer. */
+	unsigned long sequence;	/**< Sequence number of the next measured sample. */
+	unsigned long overruns;	/**< Samples dropped because the ring buffer was full. */
+	unsigned long failures;	/**< Failed measurements. */
+
+	unsigned long tail __attribute__((aligned(64)));	/**< Next slot read by the consumer. */
+} BMP085Stream;
+
+/** \defgroup BMP085STREAM_FUNC Continuous sampling functions */
+/* @{ */
+
+/**
+ * @brief Initializes the sampling engine for an initialized sensor.
+ *
+ * @param[in,out] stream pointer to the sampling engine.
+ * @param[in] sensor sensor initialized with BMP085_initSensor() or BMP085_initSensorOnBus().
+ * @param[in] capacity number of samples in the ring buffer, must be a power of two.
+ * @param[in] period time between the start of two samples in [ns], 0 for continuous sampling.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Stream_init(BMP085Stream *stream,BMP085 *sensor,size_t capacity,long long period);
+
+/**
+ * @brief Lets a controller select the over sampling mode of every sample.
+ *
+ * Call before BMP085Stream_start(). The mode of every sample is in its oss member.
+ *
+ * @param[in,out] stream pointer to the sampling engine.
+ * @param[in] adaptive initialized controller used only by the acquisition thread, NULL for the mode of the sensor.
+ */
+void BMP085Stream_setAdaptive(BMP085Stream *stream,BMP085Adaptive *adaptive);
+
+/**
+ * @brief Starts the acquisition thread.
+ *
+ * @param[in,out] stream pointer to the sampling engine.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Stream_start(BMP085Stream *stream);
+
+/**
+ * @brief Takes the oldest sample from the ring buffer without blocking.
+ *
+ * Must be called from a single consumer thread.
+ *
+ * @param[in,out] stream pointer to the sampling engine.
+ * @param[out] sample the sample.
+ * @return int returns 0 when a sample was returned, 1 when the ring buffer is empty.
+ */
+int BMP085Stream_read(BMP085Stream *stream,BMP085Sample *sample);
+
+/**
+ * @brief Takes up to \a count samples from the ring buffer without blocking.
+ *
+ * @param[in,out] stream pointer to the sampling engine.
+ * @param[out] samples array for the samples.
+ * @param[in] count size of the array.
+ * @return size_t number of samples returned.
+ */
+size_t BMP085Stream_readBatch(BMP085Stream *stream,BMP085Sample *samples,size_t count);
+
+/**
+ * @brief Returns the number of samples dropped because the ring buffer was full.
+ *
+ * @param[in] stream pointer to the sampling engine.
+ */
+unsigned long BMP085Stream_overruns(const BMP085Stream *stream);
+
+/**
+ * @brief Returns the number of failed measurements.
+ *
+ * @param[in] stream pointer to the sampling engine.
+ */
+unsigned long BMP085Stream_failures(const BMP085Stream *stream);
+
+/**
+ * @brief Stops the acquisition thread and waits for it to finish.
+ *
+ * Samples still in the ring buffer can be read after the engine is stopped.
+ *
+ * @param[in,out] stream pointer to the sampling engine.
+ */
+void BMP085Stream_stop(BMP085Stream *stream);
+
+/**
+ * @brief Fills a sample from the last measurement of a sensor.
+ *
+ * Every member except the sequence number is set. Call after a successful
+ * BMP085_takeMeasurement() or BMP085_pollMeasurement().
+ *
+ * @param[in] sensor the sensor.
+ * @param[out] sample the sample.
+ */
+void BMP085Stream_sample(const BMP085 *sensor,BMP085Sample *sample);
+
+/**
+ * @brief Stops the sampling engine and releases the ring buffer.
+ *
+ * @param[in,out] stream pointer to the sampling engine.
+ */
+void BMP085Stream_destroy(BMP085Stream *stream);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085STREAM_H_ */
@@ -0,0 +1,99 @@
+/*
+ * BMP085 library
+ * bmp085vario.c
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+/** @file bmp085vario.c
+ *  @brief Implements the functions defined in the header file bmp085vario.h.
+ *
+ *  @author libBMP085 contributors
+ */
+#include "bmp085vario.h"
+#include "bmp085batch.h"
+
+#include <string.h>
+
+/* RMS pressure noise of every mode in [Pa] from the Bosch datasheet. */
+static const double BMP085Vario_datasheetNoise[] = { 6, 5, 4, 3 };
+
+/* Initializes the estimator. */
+int BMP085Vario_init(BMP085Vario *vario,const varioPolicy *policy,double baseLinePressure)
+{
+	int oss;
+
+	memset(vario,0,sizeof(BMP085Vario));
+	if (policy)
+		vario->policy = *policy;
+	else
+	{
+		vario->policy.acceleration = BMP085VARIO_ACCELERATION;
+		memcpy(vario->policy.pressureNoise,BMP085Vario_datasheetNoise,sizeof(BMP085Vario_datasheetNoise));
+	}
+	if (vario->policy.acceleration <= 0 || baseLinePressure <= 0)
+		return 1;
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+		if (vario->policy.pressureNoise[oss] <= 0)
+			return 1;
+
+	vario->baseLinePressure = baseLinePressure;
+	return 0;
+}
+
+/* Predicts the state at the time of the sample and corrects it with the measured altitude. */
+void BMP085Vario_update(BMP085Vario *vario,long long timestamp,int32_t pressure,overSampling oss)
+{
+	double measured = BMP085_approximateAltitude(pressure,vario->baseLinePressure);
+	double q = vario->policy.acceleration, dt, slope, noise, residual, innovation, altitudeGain, speedGain;
+
+	// Slope of the barometric formula, dh/dp = -(44330 - h) / (5.255 p), converts the pressure noise to metres.
+	slope = (44330 - measured) / (5.255 * pressure);
+	noise = vario->policy.pressureNoise[oss] * slope;
+	noise *= noise;
+
+	if (!vario->samples++)
+	{
+		vario->altitude = measured;
+		vario->speed = 0;
+		vario->altitudeVariance = noise;
+		vario->covariance = 0;
+		vario->speedVariance = BMP085VARIO_INITIAL_SPEED * BMP085VARIO_INITIAL_SPEED;
+		vario->timestamp = timestamp;
+		return;
+	}
+
+	if (timestamp > vario->timestamp)
+	{
+		dt = (timestamp - vario->timestamp) / 1e9;
+		vario->timestamp = timestamp;
+		vario->altitude += vario->speed * dt;
+		vario->altitudeVariance += dt * (2 * vario->covariance + dt * vario->speedVariance) + q * dt * dt * dt / 3;
+		vario->covariance += dt * vario->speedVariance + q * dt * dt / 2;
+		vario->speedVariance += q * dt;
+	}
+
+	residual = measured - vario->altitude;
+	innovation = vario->altitudeVariance + noise;
+	altitudeGain = vario->altitudeVariance / innovation;
+	speedGain = vario->covariance / innovation;
+	vario->altitude += altitudeGain * residual;
+	vario->speed += speedGain * residual;
+	vario->speedVariance -= speedGain * vario->covariance;
+	vario->altitudeVariance -= altitudeGain * vario->altitudeVariance;
+	vario->covariance -= altitudeGain * vario->covariance;
+}
+
+/* Measures and feeds the result to the estimator. */
+int BMP085Vario_takeMeasurement(BMP085Vario *vario,BMP085 *sensor)
+{
+	if (BMP085_takeMeasurement(sensor))
+		return 1;
+
+	BMP085Vario_update(vario,sensor->conversionStart,sensor->pressure,sensor->conversionOss);
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * BMP085 library
+ * bmp085vario.h
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file bmp085vario.h
+  * @brief
+  * Header file part of libBMP085 library. It defines an estimator of the
+  * altitude and the vertical speed from timestamped pressure samples.
+  *
+  * The estimator is a Kalman filter with a constant velocity model: the
+  * vertical speed changes by white noise acceleration with the spectral density
+  * of the policy, and every sample measures the altitude with the pressure noise
+  * of its over sampling mode, converted to metres at the current altitude. Each
+  * sample is processed in constant time, without history. Samples may arrive at
+  * irregular intervals and in different modes, for example from a BMP085Stream
+  * with an adaptive controller.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef BMP085VARIO_H_
+#define BMP085VARIO_H_
+
+#include <stdint.h>
+#include "libbmp085.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup BMP085VARIO_DEF Vertical speed estimator definitions */
+/* @{ */
+#define BMP085VARIO_ACCELERATION 1.0	/**< Default acceleration in [m^2/s^3]. */
+#define BMP085VARIO_INITIAL_SPEED 10.0	/**< Standard deviation of the vertical speed before the first sample in [m/s]. */
+/* @} */
+
+/**
+ * @brief Noise model of the vertical speed estimator.
+ */
+typedef struct variopolicy
+{
+	double acceleration;	/**< Spectral density of the vertical acceleration in [m^2/s^3]; higher values follow speed changes faster and pass more noise. */
+	double pressureNoise[4];	/**< RMS noise of the pressure in [Pa], indexed by overSampling. */
+} varioPolicy;
+
+/**
+ * @brief State of the vertical speed estimator.
+ */
+typedef struct bmp085vario
+{
+	varioPolicy policy;	/**< Noise model. */
+	float baseLinePressure;	/**< Pressure at the altitude 0, in [Pa]. */
+	double altitude;	/**< Estimated altitude above the baseline in [m]. */
+	double speed;	/**< Estimated vertical speed in [m/s], positive when climbing. */
+	double altitudeVariance;	/**< Variance of the altitude estimate in [m^2]. */
+	double covariance;	/**< Covariance of the altitude and speed estimates in [m^2/s]. */
+	double speedVariance;	/**< Variance of the speed estimate in [m^2/s^2]. */
+	long long timestamp;	/**< Time of the last sample in [ns]. */
+	unsigned long samples;	/**< Number of processed samples. */
+} BMP085Vario;
+
+/** \defgroup BMP085VARIO_FUNC Vertical speed estimator functions */
+/* @{ */
+
+/**
+ * @brief Initializes the estimator.
+ *
+ * @param[in,out] vario pointer to the estimator.
+ * @param[in] policy noise model, NULL for BMP085VARIO_ACCELERATION and the RMS noise of every mode from the Bosch datasheet.
+ * @param[in] baseLinePressure pressure at the altitude 0, in [Pa].
+ * @return int returns 0 for successful operation, 1 when a noise of the policy or the baseline is not positive.
+ */
+int BMP085Vario_init(BMP085Vario *vario,const varioPolicy *policy,double baseLinePressure);
+
+/**
+ * @brief Feeds a pressure sample to the estimator.
+ *
+ * Predicts the state at \a timestamp and corrects it with the altitude of the
+ * sample. The first sample sets the altitude. A sample that is not later than
+ * the previous one only corrects the state.
+ *
+ * @param[in,out] vario pointer to the estimator.
+ * @param[in] timestamp CLOCK_MONOTONIC time in [ns] when the pressure conversion was started.
+ * @param[in] pressure pressure in [Pa].
+ * @param[in] oss mode the sample was taken in.
+ */
+void BMP085Vario_update(BMP085Vario *vario,long long timestamp,int32_t pressure,overSampling oss);
+
+/**
+ * @brief Measures and feeds the result to the estimator.
+ *
+ * Calls BMP085_takeMeasurement() and updates the estimator with the pressure,
+ * conversionStart and conversionOss of the sensor.
+ *
+ * @param[in,out] vario pointer to the estimator.
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085Vario_takeMeasurement(BMP085Vario *vario,BMP085 *sensor);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP085VARIO_H_ */
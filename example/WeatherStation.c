@@ -2,6 +2,7 @@
  *
  * Created: 01-Jun-16
  * Author: Goce Boshkovski
+ * Extended in 2026 by the libBMP085 contributors.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -17,26 +18,59 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <getopt.h>
+#include <signal.h>
+#include <string.h>
 #include "I2Cbus.h"
 #include "libbmp085.h"
+#include "bmp085scheduler.h"
+#include "bmp085shm.h"
+#include "bmp085calcache.h"
+#include "bmp085adaptive.h"
+#include "bmp085iio.h"
+#include "bmp085arbiter.h"
+#include "bmp085vario.h"
 
 void print_usage(const char *);
 void parse_opts(int argc, char *argv[]);
+int run_daemon(BMP085 *sensor);
+int run_client(void);
 
 char I2CAddress;
 char *device = "/dev/i2c-0";
 int measureTemperature,measurePressure = 0;
 int calculateAltitude = 0;
+int estimateVerticalSpeed = 0;
 int addressPresent, printSensorCalibrationTable = 0;
 int mode = 1;
+long interval = 0;
+int count = 1;
+int countPresent = 0;
+int printStats = 0;
+int retries = 0;
+char *daemonSegment = NULL;
+char *clientSegment = NULL;
+char *cacheFile = NULL;
+char *iioDevice = NULL;
+long adaptiveLatency = -1;
+char *eocChip = NULL;
+unsigned int eocOffset = 0;
+int lockBus = 0;
+BMP085Adaptive adaptive;
+BMP085Vario vario;
+volatile sig_atomic_t stopRequested = 0;
 
 int main(int argc, char **argv)
 {
-	int I2CBus;
+	int I2CBus = -1, eocLine = -1;
+	BMP085Iio iio;
+	BMP085Arbiter arbiter;
 
 	parse_opts(argc,argv);	
 
-	if (!addressPresent)
+	if (clientSegment)
+		return run_client();
+
+	if (!addressPresent && !iioDevice)
 	{
 		printf("Device address is not defined.\n");
 		print_usage(argv[0]);
@@ -53,42 +87,179 @@ int main(int argc, char **argv)
 	BMP085 *sensor;
 	sensor = (BMP085 *) malloc(sizeof(BMP085));
 	
-	if (openI2CBus(&I2CBus,device))
+	if (iioDevice)
+	{
+		if (BMP085Iio_open(&iio,iioDevice,NULL))
+		{
+			printf("Failed to open the IIO device %s.\n",iioDevice);
+			return 1;
+		}
+		if (BMP085_initSensorOnBus(sensor,&BMP085Iio_busOps,&iio,I2CAddress,mode))
+		{
+			printf("Failed to init BMP085 sensor.\n");
+			return 1;
+		}
+	}
+	else if (openI2CBus(&I2CBus,device))
 	{
 		printf("Failed to open I2C bus via device: %s.\n",device);
 		return 1;
 	}
-	
-	if (BMP085_initSensor(sensor,&I2CBus,I2CAddress,mode))
+	else if (cacheFile)
+	{
+		BMP085CalCache cache;
+
+		if (BMP085CalCache_load(&cache,cacheFile))
+			printf("Ignoring the invalid calibration cache %s.\n",cacheFile);
+		if (BMP085CalCache_initSensor(&cache,device,sensor,&I2CBus,I2CAddress,mode))
+		{
+			printf("Failed to init BMP085 sensor.\n");
+			return 1;
+		}
+		if (BMP085CalCache_save(&cache,cacheFile))
+			printf("Failed to save the calibration cache %s.\n",cacheFile);
+		printf("Calibration cache: %lu hits, %lu misses (%lu stale), %lu dropped entries, %.1f ms saved\n",
+			cache.hits,cache.misses,cache.stale,cache.dropped,cache.savedTime/1e6);
+		BMP085CalCache_destroy(&cache);
+	}
+	else if (lockBus)
+	{
+		if (BMP085Arbiter_init(&arbiter,&I2CBus_devOps,&I2CBus,device) ||
+			BMP085_initSensorOnBus(sensor,&BMP085Arbiter_busOps,&arbiter,I2CAddress,mode))
+		{
+			printf("Failed to init BMP085 sensor.\n");
+			return 1;
+		}
+	}
+	else if (BMP085_initSensor(sensor,&I2CBus,I2CAddress,mode))
 	{
 		printf("Failed to init BMP085 sensor.\n");
 		return 1;
 	}
 
 
+	if (eocChip)
+	{
+		if (openEocLine(&eocLine,eocChip,eocOffset))
+		{
+			printf("Failed to request line %u of %s for the EOC pin.\n",eocOffset,eocChip);
+			return 1;
+		}
+		BMP085_setEndOfConversionLine(sensor,eocLine);
+	}
+
+	if (retries)
+	{
+		retryPolicy policy = { retries, 1000000L, 100000000LL, 3 };
+
+		BMP085_setRetryPolicy(sensor,&policy);
+	}
+
 	if (printSensorCalibrationTable)
 	{
 		printf("Table of calibration coefficients:\n");
 		BMP085_printCalibrationTable(sensor);
 	}
 
-	if (measureTemperature+measurePressure+calculateAltitude)
+	if (adaptiveLatency >= 0)
+	{
+		adaptivePolicy policy = { adaptiveLatency*1000000LL, 0, BMP085ADAPTIVE_FAST_RATE, BMP085ADAPTIVE_SLOW_RATE,
+			BMP085ADAPTIVE_HOLD_SAMPLES, BMP085ADAPTIVE_WINDOW };
+
+		BMP085Adaptive_init(&adaptive,&policy,mode);
+	}
+
+	if (daemonSegment)
+	{
+		int result = run_daemon(sensor);
+
+		free(sensor);
+		closeEocLine(&eocLine);
+		if (iioDevice)
+			BMP085Iio_close(&iio);
+		closeI2CBus(&I2CBus);
+		return result;
+	}
+
+	if (measureTemperature+measurePressure+calculateAltitude+estimateVerticalSpeed)
 	{
-		if (BMP085_takeMeasurement(sensor))
+		BMP085Scheduler scheduler;
+		int n;
+
+		BMP085Vario_init(&vario,NULL,AVERAGE_SEA_LEVEL_PRESSURE*100);
+
+		if (interval && BMP085Scheduler_init(&scheduler,interval*1000000LL,tNow()))
 		{
-			printf("Failed to retrieve sensor data.\n");
+			printf("Failed to create the sampling timer.\n");
 			exit(1);
 		}
-		if (measureTemperature)
-			printf("Temperature = %+5.2f°C\n",sensor->temperature);
-		if (measurePressure)
-			printf("Pressure = %.2fhPa\n",(float)sensor->pressure/100.0);
-		if (calculateAltitude)
-			printf("Altitude above see level H = %dm\n",BMP085_Altitude((double)(sensor->pressure/100.0),(double)AVERAGE_SEA_LEVEL_PRESSURE));
+
+		for (n=0;!count || n<count;n++)
+		{
+			if (interval && BMP085Scheduler_wait(&scheduler))
+			{
+				printf("Failed to wait for the sampling timer.\n");
+				exit(1);
+			}
+			if (adaptiveLatency >= 0 ? BMP085Adaptive_takeMeasurement(&adaptive,sensor) : BMP085_takeMeasurement(sensor))
+			{
+				printf("Failed to retrieve sensor data.\n");
+				exit(1);
+			}
+			if (measureTemperature)
+				printf("Temperature = %+5.2f°C\n",sensor->temperature);
+			if (measurePressure)
+			{
+				if (adaptiveLatency >= 0)
+					printf("Pressure = %.2fhPa (mode %d)\n",(float)sensor->pressure/100.0,sensor->conversionOss);
+				else
+					printf("Pressure = %.2fhPa\n",(float)sensor->pressure/100.0);
+			}
+			if (calculateAltitude)
+				printf("Altitude above see level H = %dm\n",BMP085_Altitude((double)(sensor->pressure/100.0),(double)AVERAGE_SEA_LEVEL_PRESSURE));
+			if (estimateVerticalSpeed)
+			{
+				BMP085Vario_update(&vario,sensor->conversionStart,sensor->pressure,sensor->conversionOss);
+				printf("Vertical speed = %+.2fm/s at H = %.2fm\n",vario.speed,vario.altitude);
+			}
+		}
+
+		if (interval)
+		{
+			printf("Missed sampling deadlines: %lu\n",scheduler.missed);
+			BMP085Scheduler_destroy(&scheduler);
+		}
+		if (adaptiveLatency >= 0)
+			BMP085Adaptive_printSummary(&adaptive,stdout);
 	}
 
 
+	if (retries)
+		printf("Transaction failures: %lu, retries: %lu, given up: %lu, bus reopened: %lu, longest retry: %.3f ms\n",
+			sensor->retryStats.failures,sensor->retryStats.retries,sensor->retryStats.exhausted,
+			sensor->retryStats.recoveries,sensor->retryStats.maxRetryTime/1e6);
+
+	if (printStats)
+	{
+		BMP085Stats stats;
+
+		if (BMP085_getStats(sensor,&stats))
+			printf("Performance counters are not available, rebuild the library with make STATS=1.\n");
+		else
+		{
+			BMP085Stats_print(&stats,"Sensor",stdout);
+			if (!I2CBus_getStats(I2CBus,&stats))
+				BMP085Stats_print(&stats,device,stdout);
+		}
+	}
+
+	if (eocChip)
+		printf("Conversions without an EOC edge: %lu\n",sensor->eocMissed);
+
 	free(sensor);
+	closeEocLine(&eocLine);
+	if (iioDevice)
+		BMP085Iio_close(&iio);
 
 	closeI2CBus(&I2CBus);
 
@@ -96,15 +267,127 @@ int main(int argc, char **argv)
 
 }
 
+void stop_daemon(int signal)
+{
+	(void)signal;
+	stopRequested = 1;
+}
+
+/* Samples the sensor periodically and publishes the samples in shared memory until stopped. */
+int run_daemon(BMP085 *sensor)
+{
+	BMP085ShmPublisher publisher;
+	BMP085Scheduler scheduler;
+	BMP085Sample sample;
+	struct sigaction action;
+	long long period = (interval ? interval : 1000) * 1000000LL;
+	unsigned long n;
+
+	if (BMP085ShmPublisher_open(&publisher,daemonSegment,sensor,period))
+	{
+		printf("Failed to create the shared memory segment %s.\n",daemonSegment);
+		return 1;
+	}
+	if (BMP085Scheduler_init(&scheduler,period,tNow()))
+	{
+		printf("Failed to create the sampling timer.\n");
+		BMP085ShmPublisher_close(&publisher);
+		return 1;
+	}
+
+	memset(&action,0,sizeof(action));
+	action.sa_handler = stop_daemon;
+	sigaction(SIGINT,&action,NULL);
+	sigaction(SIGTERM,&action,NULL);
+
+	for (n=0;!stopRequested && (!countPresent || !count || n<(unsigned long)count);n++)
+	{
+		if (BMP085Scheduler_wait(&scheduler))
+			break;
+		if (adaptiveLatency >= 0 ? BMP085Adaptive_takeMeasurement(&adaptive,sensor) : BMP085_takeMeasurement(sensor))
+		{
+			BMP085ShmPublisher_failed(&publisher);
+			continue;
+		}
+		BMP085Stream_sample(sensor,&sample);
+		sample.sequence = n;
+		BMP085ShmPublisher_publish(&publisher,&sample);
+	}
+
+	printf("Published %lu samples, missed sampling deadlines: %lu\n",n,scheduler.missed);
+	if (adaptiveLatency >= 0)
+		BMP085Adaptive_printSummary(&adaptive,stdout);
+	BMP085Scheduler_destroy(&scheduler);
+	BMP085ShmPublisher_close(&publisher);
+	return 0;
+}
+
+/* Prints the latest samples published by a daemon, without accessing the bus. */
+int run_client(void)
+{
+	BMP085ShmClient client;
+	BMP085Scheduler scheduler;
+	BMP085Sample sample;
+	int n;
+
+	if (BMP085ShmClient_open(&client,clientSegment))
+	{
+		printf("No sampling daemon publishes %s.\n",clientSegment);
+		return 1;
+	}
+	if (interval && BMP085Scheduler_init(&scheduler,interval*1000000LL,tNow()))
+	{
+		printf("Failed to create the sampling timer.\n");
+		return 1;
+	}
+	if (!(measureTemperature+measurePressure+calculateAltitude))
+		measureTemperature = measurePressure = 1;
+
+	for (n=0;!count || n<count;n++)
+	{
+		if (interval && BMP085Scheduler_wait(&scheduler))
+			break;
+		if (BMP085ShmClient_latest(&client,&sample))
+		{
+			printf("No sample published yet.\n");
+			continue;
+		}
+		printf("Sample %lu, %.0f ms old\n",sample.sequence,(tNow()-sample.timestamp)/1e6);
+		if (measureTemperature)
+			printf("Temperature = %+5.2f°C\n",sample.temperature*0.1);
+		if (measurePressure)
+			printf("Pressure = %.2fhPa\n",sample.pressure/100.0);
+		if (calculateAltitude)
+			printf("Altitude above see level H = %dm\n",BMP085_Altitude(sample.pressure/100.0,(double)AVERAGE_SEA_LEVEL_PRESSURE));
+	}
+
+	if (interval)
+		BMP085Scheduler_destroy(&scheduler);
+	BMP085ShmClient_close(&client);
+	return 0;
+}
+
 void print_usage(const char *prog)
 {
-        printf("Usage: %s [-adtTpm]\n", prog);
+        printf("Usage: %s [-adtTpAVmicsrDSCIOEL]\n", prog);
         puts("  -a --address\t\t mandatory, sets the I2C bus address of the BMP085 sensor;\n"
              "  -d --device\t\t set the I2C device (default is /dev/i2c-0);\n"
              "  -t --table\t\t print calibration table;\n"
+             "  -i --interval\t\t sample periodically every interval [ms];\n"
+             "  -c --count\t\t number of periodic samples, 0 for no limit (default is 1);\n"
+             "  -r --retries\t\t retry a failed transaction up to retries times within 100 ms and reopen the bus after 3 failures;\n"
+             "  -D --daemon\t\t sample every interval (default 1000 ms) and publish the samples in the named shared memory segment;\n"
+             "  -S --subscribe\t print the latest samples of the daemon publishing the named segment, without accessing the bus;\n"
+             "  -I --iio\t\t read the sensor through the kernel driver at the given sysfs directory instead of i2c-dev;\n"
+             "  -C --cache\t\t keep the calibration table in the named cache file and validate it instead of reading it;\n"
+             "  -E --eoc\t\t wait for the EOC pin wired to the given GPIO line, as chip:offset (for example /dev/gpiochip0:17);\n"
+             "  -L --lock\t\t lock the I2C device for every transaction, so other processes can use other devices on the bus;\n"
+             "  -O --adaptive\t\t select the mode of every sample from the rate of change of the pressure, with the given latency budget [ms] (0 for none);\n"
+             "  -s --stats\t\t print the performance counters of the sensor and the bus (needs make STATS=1);\n"
              "  -T --temperature\t measure temperature and print the value in [C];\n"
              "  -p --pressure\t\t measure the atmospheric pressure and print the value in [hPa];\n"
 		"   -A --altitude\t\t calculates the relative amplitude change in [m];\n"
+             "  -V --vario\t\t estimate the vertical speed in [m/s] from the samples, use with -i;\n"
         	 "  -m --mode\t\t sets the measurement mode. Default value 1 = STANDARD. Allowed values:\n"
 	         "                                        0 = ULTRA LOW POWER\n"
              "                                            1 = STANDARD\n"
@@ -126,12 +409,24 @@ void parse_opts(int argc, char *argv[])
                         { "temperature", no_argument, NULL, 'T' },
                         { "pressure", no_argument, NULL, 'p' },
 						{ "altitude", no_argument, NULL, 'A' },
+						{ "interval", required_argument, NULL, 'i' },
+						{ "count", required_argument, NULL, 'c' },
+						{ "stats", no_argument, NULL, 's' },
+						{ "retries", required_argument, NULL, 'r' },
+						{ "daemon", required_argument, NULL, 'D' },
+						{ "subscribe", required_argument, NULL, 'S' },
+						{ "cache", required_argument, NULL, 'C' },
+						{ "iio", required_argument, NULL, 'I' },
+						{ "adaptive", required_argument, NULL, 'O' },
+						{ "eoc", required_argument, NULL, 'E' },
+						{ "lock", no_argument, NULL, 'L' },
+						{ "vario", no_argument, NULL, 'V' },
                         { NULL, 0, 0, 0 },
         	};
 
         	int c;
 
-            c = getopt_long(argc, argv, "a:d:m:tTpA", lopts, NULL);
+            c = getopt_long(argc, argv, "a:d:m:tTpAVi:c:sr:D:S:C:I:O:E:L", lopts, NULL);
 
             if (c == -1)
             	break;
@@ -162,6 +457,51 @@ void parse_opts(int argc, char *argv[])
                 	case 'A':
                 		calculateAltitude = 1;
                 		break;
+                	case 'V':
+                		estimateVerticalSpeed = 1;
+                		break;
+                	case 'i':
+                		interval = atol(optarg);
+                		break;
+                	case 'c':
+                		count = atoi(optarg);
+                		countPresent = 1;
+                		break;
+                	case 's':
+                		printStats = 1;
+                		break;
+                	case 'r':
+                		retries = atoi(optarg);
+                		break;
+                	case 'D':
+                		daemonSegment = optarg;
+                		break;
+                	case 'S':
+                		clientSegment = optarg;
+                		break;
+                	case 'C':
+                		cacheFile = optarg;
+                		break;
+                	case 'I':
+                		iioDevice = optarg;
+                		break;
+                	case 'O':
+                		adaptiveLatency = atol(optarg);
+                		break;
+                	case 'L':
+                		lockBus = 1;
+                		break;
+                	case 'E':
+                		{
+                			char *separator = strrchr(optarg,':');
+
+                			if (!separator)
+                				print_usage(argv[0]);
+                			*separator = 0;
+                			eocChip = optarg;
+                			eocOffset = strtoul(separator + 1,NULL,0);
+                		}
+                		break;
                 	default:
                 		print_usage(argv[0]);
                         break;
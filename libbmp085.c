@@ -3,6 +3,7 @@
  * libbmp085.c
  *
  * Copyright (c) 2014  Goce Boshkovski
+ * Copyright (c) 2026  libBMP085 contributors
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -13,100 +14,730 @@
  *  @brief Implements the functions defined in the header file libbmp085.h.
  *
  *  @author Goce Boshkovski
+ *  @author libBMP085 contributors
  */
+#define _GNU_SOURCE
 #include "libbmp085.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <math.h>
+#include <errno.h>
+#include <poll.h>
 #include "I2Cbus.h"
 
+const long BMP085_TemperatureConversionTime = 4500000L;
 const long BMP085_PressureConversionTime[]={ 5000000L, 8000000L, 14000000L, 26000000L };
+const long BMP085_TemperatureTypicalConversionTime = 3000000L;
+const long BMP085_PressureTypicalConversionTime[]={ 3000000L, 5000000L, 9000000L, 17000000L };
+
+/* Calls the recover operation of the transport after too many consecutive failures. */
+static void BMP085_recoverBus(BMP085 *sensor,void *context)
+{
+	const retryPolicy *policy = &(sensor->retryPolicy);
+
+	if (!policy->recoverAfter || sensor->consecutiveFailures < policy->recoverAfter || !sensor->busOps->recover)
+		return;
+
+	sensor->consecutiveFailures = 0;
+	if (sensor->busOps->recover(context))
+		sensor->retryStats.failedRecoveries++;
+	else
+		sensor->retryStats.recoveries++;
+}
+
+/*
+ * Decides whether a failed transaction is attempted again and sleeps for the backoff.
+ * A retry is allowed while the retries are not used up and it ends within the budget.
+ */
+static int BMP085_retryAllowed(BMP085 *sensor,unsigned int attempt,long long now)
+{
+	const retryPolicy *policy = &(sensor->retryPolicy);
+	long long backoff;
+
+	if (attempt >= policy->maxRetries)
+		return 0;
+
+	backoff = (long long)policy->backoff << (attempt < 20 ? attempt : 20);
+	if (policy->budget && now + backoff > sensor->measurementStart + policy->budget)
+		return 0;
+	if (backoff)
+		tDelay(backoff);
+
+	return 1;
+}
+
+/* Records the time spent retrying a transaction. */
+static void BMP085_retryDone(BMP085 *sensor,long long firstFailure)
+{
+	long long time = tNow() - firstFailure;
+
+	sensor->retryStats.retryTime += time;
+	if (time > sensor->retryStats.maxRetryTime)
+		sensor->retryStats.maxRetryTime = time;
+	BMP085STATS_RECORD(&(sensor->stats),statsRetry,time);
+}
+
+/*
+ * Runs one register access through the transport assigned to the sensor, retried
+ * according to the retry policy. A write sends buffer[0] to the register.
+ */
+static int BMP085_transfer(BMP085 *sensor,int write,unsigned char registry,unsigned char *buffer,int size)
+{
+	void *context = sensor->busContext ? sensor->busContext : &(sensor->I2CBus);
+	long long firstFailure = 0, now;
+	unsigned int attempt = 0;
+	int result;
+
+	while (1)
+	{
+#ifdef BMP085_STATS
+		errno = 0;
+#endif
+		if (write)
+			result = sensor->busOps->write(context,sensor->I2CAddress,registry,buffer[0]);
+		else
+			result = sensor->busOps->read(context,sensor->I2CAddress,registry,buffer,size);
+
+		if (write)
+			BMP085STATS_ADD(&(sensor->stats),writes,1);
+		else
+			BMP085STATS_ADD(&(sensor->stats),reads,1);
+
+		if (!result)
+		{
+			if (write)
+				BMP085STATS_ADD(&(sensor->stats),bytesWritten,2);
+			else
+				BMP085STATS_ADD(&(sensor->stats),bytesRead,size);
+			sensor->consecutiveFailures = 0;
+			if (attempt)
+			{
+				sensor->retryStats.recovered++;
+				BMP085_retryDone(sensor,firstFailure);
+			}
+			return 0;
+		}
+
+		if (write)
+			BMP085STATS_ADD(&(sensor->stats),writeErrors,1);
+		else
+			BMP085STATS_ADD(&(sensor->stats),readErrors,1);
+		BMP085STATS_ERROR(&(sensor->stats),errno);
+		sensor->retryStats.failures++;
+		sensor->consecutiveFailures++;
+		BMP085_recoverBus(sensor,context);
+
+		if (!sensor->retryPolicy.maxRetries)
+			return result;
+		now = tNow();
+		if (!attempt)
+			firstFailure = now;
+		if (!BMP085_retryAllowed(sensor,attempt,now))
+		{
+			sensor->retryStats.exhausted++;
+			if (attempt)
+				BMP085_retryDone(sensor,firstFailure);
+			return result;
+		}
+		attempt++;
+		sensor->retryStats.retries++;
+	}
+}
+
+/* Read sensor registers through the transport assigned to the sensor. */
+static int BMP085_read(BMP085 *sensor,unsigned char registry,unsigned char *buffer,int size)
+{
+	return BMP085_transfer(sensor,0,registry,buffer,size);
+}
+
+/* Write a sensor register through the transport assigned to the sensor. */
+static int BMP085_write(BMP085 *sensor,unsigned char registry,unsigned char value)
+{
+	return BMP085_transfer(sensor,1,registry,&value,1);
+}
 
 /* Sensor initialization. */
 int BMP085_initSensor(BMP085 *sensor,int *I2Cbus,unsigned char I2CAddress,overSampling oss)
 {
 	sensor->I2CBus=*I2Cbus;
+	return BMP085_initSensorOnBus(sensor,&I2CBus_devOps,NULL,I2CAddress,oss);
+}
+
+/* Assigns the transport and restores the default configuration. */
+static void BMP085_setup(BMP085 *sensor,const I2CBusOps *busOps,void *busContext,unsigned char I2CAddress,overSampling oss)
+{
+	sensor->busOps=busOps;
+	sensor->busContext=busContext;
 	sensor->oss=oss;
+	sensor->conversionOss=oss;
 	sensor->I2CAddress=I2CAddress;
-	return I2CSensor_Read(&(sensor->I2CBus),sensor->I2CAddress,BMP085_CALIBRATION_TABLE,sensor->calibrationCoeficients,22);
+	sensor->state=measurementIdle;
+	sensor->eocMode=eocTimed;
+	sensor->eocLine=-1;
+	sensor->eocMissed=0;
+	BMP085_setTemperaturePolicy(sensor,NULL);
+	BMP085_setRetryPolicy(sensor,NULL);
+	BMP085_resetStats(sensor);
 }
 
-/* Starts a temperature and pressure sampling. */
-int BMP085_takeMeasurement(BMP085 *sensor)
+/* Sensor initialization over a custom transport. */
+int BMP085_initSensorOnBus(BMP085 *sensor,const I2CBusOps *busOps,void *busContext,unsigned char I2CAddress,overSampling oss)
 {
-	long rawTemperature,temperature = 0;
-    long rawPressure = 0, pressure = 0;
+	BMP085_setup(sensor,busOps,busContext,I2CAddress,oss);
+	// A transport that measures on its own keeps the calibration table to itself.
+	if (busOps->measure)
+	{
+		memset(sensor->calibrationCoeficients,0,22);
+		memset(&(sensor->calibration),0,sizeof(BMP085Calibration));
+		return 0;
+	}
+	if (BMP085_read(sensor,BMP085_CALIBRATION_TABLE,sensor->calibrationCoeficients,22))
+		return 1;
 
-    long x1, x2, x3, b3, b5, b6 = 0;
-    unsigned long b4, b7 = 0;
+	return BMP085_decodeCalibration(&(sensor->calibration),sensor->calibrationCoeficients);
+}
 
-    short ac1 = createSword(sensor->calibrationCoeficients[0],sensor->calibrationCoeficients[1]);
-    short ac2 = createSword(sensor->calibrationCoeficients[2],sensor->calibrationCoeficients[3]);
-    short ac3 = createSword(sensor->calibrationCoeficients[4],sensor->calibrationCoeficients[5]);
-    unsigned short ac4 = createUword(sensor->calibrationCoeficients[6],sensor->calibrationCoeficients[7]);
-    unsigned short ac5 = createUword(sensor->calibrationCoeficients[8],sensor->calibrationCoeficients[9]);
-    unsigned short ac6 = createUword(sensor->calibrationCoeficients[10],sensor->calibrationCoeficients[11]);
-    short b1 = createSword(sensor->calibrationCoeficients[12],sensor->calibrationCoeficients[13]);
-    short b2 = createSword(sensor->calibrationCoeficients[14],sensor->calibrationCoeficients[15]);
-    short mc = createSword(sensor->calibrationCoeficients[18],sensor->calibrationCoeficients[19]);
-    short md = createSword(sensor->calibrationCoeficients[20],sensor->calibrationCoeficients[21]);
+/* Sensor initialization with a known calibration table. */
+int BMP085_initSensorWithCalibration(BMP085 *sensor,const I2CBusOps *busOps,void *busContext,unsigned char I2CAddress,overSampling oss,const unsigned char *table)
+{
+	unsigned char chipID, fingerprint[BMP085_CALIBRATION_FINGERPRINT];
 
-    // Send the command to start the temperature measurement.
-    if (I2CSensor_Write(&(sensor->I2CBus),sensor->I2CAddress,BMP085_CONTROL_REG,BMP085_START_TEMPERATURE_MEASUREMENT))
-    	return 1;
+	BMP085_setup(sensor,busOps,busContext,I2CAddress,oss);
+	if (BMP085_read(sensor,BMP085_CHIP_ID_REG,&chipID,1) || chipID != BMP085_CHIP_ID)
+		return 1;
+	// Another sensor at the same address has different coefficients at the start of the table.
+	if (BMP085_read(sensor,BMP085_CALIBRATION_TABLE,fingerprint,BMP085_CALIBRATION_FINGERPRINT) ||
+		memcmp(fingerprint,table,BMP085_CALIBRATION_FINGERPRINT))
+		return 1;
 
-    // wait 4.5ms and then read the temperature raw value
-    tDelay(BMP085_PressureConversionTime[sensor->oss]);
+	memcpy(sensor->calibrationCoeficients,table,22);
+	return BMP085_decodeCalibration(&(sensor->calibration),sensor->calibrationCoeficients);
+}
 
-    // Read the temperature raw value
-    if (I2CSensor_Read(&(sensor->I2CBus),sensor->I2CAddress,BMP085_DATA_REG_MSB,sensor->rawTemperatureData,2))
-    	return 1;
-    rawTemperature = (long)((sensor->rawTemperatureData[0]<<8)+sensor->rawTemperatureData[1]);
+/* Decodes and validates the calibration table. */
+int BMP085_decodeCalibration(BMP085Calibration *calibration,const unsigned char *table)
+{
+	int i, oss;
+	unsigned short word;
 
-	// Send the command to start the pressure measurement.
-    if (I2CSensor_Write(&(sensor->I2CBus),sensor->I2CAddress,BMP085_CONTROL_REG,(BMP085_START_PRESSURE_MEASUREMENT+(sensor->oss<<6))))
-    	return 1;
+	// 0x0000 and 0xFFFF indicate a failed communication with the sensor.
+	for (i=0;i<22;i+=2)
+	{
+		word = createUword(table[i],table[i+1]);
+		if (word == 0x0000 || word == 0xFFFF)
+			return 1;
+	}
 
-	// Wait for the pressure conversion to be done.
-	tDelay(BMP085_PressureConversionTime[sensor->oss]);
+	calibration->ac1 = createSword(table[0],table[1]);
+	calibration->ac2 = createSword(table[2],table[3]);
+	calibration->ac3 = createSword(table[4],table[5]);
+	calibration->ac4 = createUword(table[6],table[7]);
+	calibration->ac5 = createUword(table[8],table[9]);
+	calibration->ac6 = createUword(table[10],table[11]);
+	calibration->b1 = createSword(table[12],table[13]);
+	calibration->b2 = createSword(table[14],table[15]);
+	calibration->mb = createSword(table[16],table[17]);
+	calibration->mc = createSword(table[18],table[19]);
+	calibration->md = createSword(table[20],table[21]);
 
-	// Read the pressure raw value.
-	if (I2CSensor_Read(&(sensor->I2CBus),sensor->I2CAddress,BMP085_DATA_REG_MSB,sensor->rawPressureData,2))
-		return 1;
-    if (I2CSensor_Read(&(sensor->I2CBus),sensor->I2CAddress,BMP085_DATA_REG_XLASB,&(sensor->rawPressureData[2]),1))
-    	return 1;
-	rawPressure = ((sensor->rawPressureData[0]<<16) + (sensor->rawPressureData[1]<<8) + sensor->rawPressureData[2])>>(8-sensor->oss);
-
-	//calculate the real temperature value
-    x1 = ((rawTemperature - ac6)*ac5)>>15;
-    x2 = (mc << 11)/(x1 + md);
-    b5 = x1 + x2;
-    temperature = (b5 + 8)>>4;
-    sensor->temperature = temperature * 0.1;
-
-	//calculate the real pressure value in Pa
-	b6 = b5 - 4000;
-	x1 = (b2 * ((b6 * b6) >> 12)) >> 11;
-	x2 = (ac2 * b6) >> 11;
+	calibration->mc11 = (int32_t)calibration->mc * 2048;
+	for (oss=ultraLowPower;oss<=ultraHighResolution;oss++)
+	{
+		calibration->ac1x4[oss] = ((int64_t)calibration->ac1 * 4) << oss;
+		calibration->b7Scale[oss] = 50000 >> oss;
+	}
+
+	return 0;
+}
+
+/* Calculates the temperature and B5 from a raw temperature value. */
+int32_t BMP085_calculateTemperature(const BMP085Calibration *calibration,int32_t rawTemperature,int32_t *b5)
+{
+	int64_t x1, x2;
+
+	x1 = (((int64_t)rawTemperature - calibration->ac6) * calibration->ac5) >> 15;
+	x2 = (x1 + calibration->md) ? calibration->mc11 / (x1 + calibration->md) : 0;
+	*b5 = (int32_t)(x1 + x2);
+
+	return (*b5 + 8) >> 4;
+}
+
+/* Calculates the pressure from a raw pressure value and B5. */
+int32_t BMP085_calculatePressure(const BMP085Calibration *calibration,overSampling oss,int32_t rawPressure,int32_t b5)
+{
+	int64_t x1, x2, x3, b3, b6, pressure;
+	uint64_t b4, b7;
+
+	b6 = (int64_t)b5 - 4000;
+	x1 = (calibration->b2 * ((b6 * b6) >> 12)) >> 11;
+	x2 = (calibration->ac2 * b6) >> 11;
 	x3 = x1 + x2;
-	b3 = ((( ac1 * 4 + x3 ) << sensor->oss) + 2 ) / 4;
-	x1 = (ac3 * b6) >> 13;
-	x2 = (b1 * ((b6 * b6) >> 12)) >> 16;
-	x3 = ((x1+x2)+2) >> 2;
-	b4 = (ac4 * (unsigned long)(x3 + 32768)) >> 15;
-	b7 = ((unsigned long)rawPressure-b3)*(50000>>sensor->oss);
-	if (b7<0x80000000)
-		pressure=(b7*2)/b4;
+	b3 = ((calibration->ac1x4[oss] + (x3 << oss)) + 2) / 4;
+	x1 = (calibration->ac3 * b6) >> 13;
+	x2 = (calibration->b1 * ((b6 * b6) >> 12)) >> 16;
+	x3 = ((x1 + x2) + 2) >> 2;
+	b4 = (calibration->ac4 * (uint64_t)(x3 + 32768)) >> 15;
+	b7 = ((uint64_t)rawPressure - b3) * calibration->b7Scale[oss];
+	if (b4 == 0)
+		pressure = 0;
+	else if (b7 < 0x80000000)
+		pressure = (b7 * 2) / b4;
 	else
-		pressure=(b7/b4)*2;
-	x1=(pressure >> 8)* (pressure >> 8);
-	x1=(x1*3038)>>16;
-	x2=(-7357*pressure)>>16;
-	pressure+=((x1+x2+3791)>>4);
+		pressure = (b7 / b4) * 2;
+	x1 = (pressure >> 8) * (pressure >> 8);
+	x1 = (x1 * 3038) >> 16;
+	x2 = (-7357 * pressure) >> 16;
+	pressure += (x1 + x2 + 3791) >> 4;
+
+	return (int32_t)pressure;
+}
+
+/* Calculates B5 and the temperature from the raw temperature read from the sensor. */
+static void BMP085_compensateTemperature(BMP085 *sensor)
+{
+	int32_t rawTemperature = (sensor->rawTemperatureData[0]<<8) + sensor->rawTemperatureData[1];
+	int32_t b5;
+
+	sensor->temperature = BMP085_calculateTemperature(&(sensor->calibration),rawTemperature,&b5) * 0.1;
+	sensor->b5 = b5;
+}
+
+/* Calculates the pressure from the raw pressure read from the sensor and the last B5. */
+static void BMP085_compensatePressure(BMP085 *sensor)
+{
+	int32_t rawPressure = ((sensor->rawPressureData[0]<<16) + (sensor->rawPressureData[1]<<8) + sensor->rawPressureData[2]) >> (8-sensor->conversionOss);
+
+	sensor->pressure = BMP085_calculatePressure(&(sensor->calibration),sensor->conversionOss,rawPressure,sensor->b5);
+}
+
+/* Decides whether the last B5 can be used for the next pressure sample. */
+static int BMP085_temperatureReusable(BMP085 *sensor)
+{
+	const temperaturePolicy *policy = &(sensor->temperaturePolicy);
+	long maxAge = policy->maxAge;
+
+	if (!sensor->temperatureValid || policy->maxSamples == 1)
+		return 0;
+	// Without a sample limit the temperature is kept until one of the other limits is reached.
+	if (policy->maxSamples ? sensor->temperatureSamples >= policy->maxSamples : !maxAge && !policy->driftThreshold)
+		return 0;
+	// The drift is measured only on a refresh, so a drift limit alone could never trigger one.
+	if (!policy->maxSamples && !maxAge)
+		maxAge = BMP085_DEFAULT_MAX_AGE;
+	if (maxAge && tNow() - sensor->temperatureTime >= maxAge*1000000LL)
+		return 0;
+	if (policy->driftThreshold && sensor->temperatureDrift > policy->driftThreshold)
+		return 0;
+
+	return 1;
+}
+
+/* EOC line of the sensor when eocLine mode is selected, -1 otherwise. */
+static int BMP085_eocLine(const BMP085 *sensor)
+{
+	return sensor->eocMode == eocLine ? sensor->eocLine : -1;
+}
+
+/* Reads all pending events of the EOC line, returns 1 when there was at least one. */
+static int BMP085_eocEdge(int line)
+{
+	unsigned char events[256];
+	int edge = 0;
+
+	while (read(line,events,sizeof(events)) > 0)
+		edge = 1;
+	return edge;
+}
+
+/* Discards events left from earlier conversions before a conversion is started. */
+static void BMP085_eocArm(BMP085 *sensor)
+{
+	int line = BMP085_eocLine(sensor);
+
+	if (line >= 0)
+		BMP085_eocEdge(line);
+}
+
+/*
+ * Returns 1 while the running conversion is not done: before an EOC edge in
+ * eocLine mode, and before readyTime. A conversion collected at readyTime in
+ * eocLine mode missed its edge.
+ */
+static int BMP085_conversionPending(BMP085 *sensor)
+{
+	int line = BMP085_eocLine(sensor);
+
+	if (line >= 0 && BMP085_eocEdge(line))
+		return 0;
+	if (tNow() < sensor->readyTime)
+		return 1;
+	if (line >= 0)
+		sensor->eocMissed++;
+	return 0;
+}
+
+/* Records the start of a conversion and the time when its result can be collected. */
+static void BMP085_conversionStarted(BMP085 *sensor,long typicalTime,long maximumTime)
+{
+	sensor->conversionStart = tNow();
+	if (sensor->eocMode == eocPollSco)
+		sensor->readyTime = sensor->conversionStart + typicalTime;
+	else
+		sensor->readyTime = sensor->conversionStart + maximumTime;
+}
+
+/*
+ * Checks the Sco bit of the CONTROL register when end-of-conversion polling is enabled.
+ * Returns 0 when the result can be read, BMP085_MEASUREMENT_PENDING to poll again later
+ * and 1 for failure. After the datasheet maximum the result is read regardless of Sco.
+ */
+static int BMP085_conversionDone(BMP085 *sensor,long maximumTime)
+{
+	unsigned char control;
+	long long now;
+
+	if (sensor->eocMode != eocPollSco)
+		return 0;
+
+	now = tNow();
+	if (now >= sensor->conversionStart + maximumTime)
+		return 0;
+
+	if (BMP085_read(sensor,BMP085_CONTROL_REG,&control,1))
+		return 1;
+	if (!(control & BMP085_CONTROL_SCO))
+		return 0;
+
+	sensor->readyTime = now + BMP085_SCO_POLL_INTERVAL;
+	if (sensor->readyTime > sensor->conversionStart + maximumTime)
+		sensor->readyTime = sensor->conversionStart + maximumTime;
+
+	return BMP085_MEASUREMENT_PENDING;
+}
+
+/* Sends the command for the pressure conversion. */
+static int BMP085_startPressureConversion(BMP085 *sensor)
+{
+	overSampling oss = sensor->oss;
+
+	BMP085_eocArm(sensor);
+	BMP085STATS_MARK(&(sensor->stats));
+	if (BMP085_write(sensor,BMP085_CONTROL_REG,(BMP085_START_PRESSURE_MEASUREMENT+(oss<<6))))
+		return 1;
+
+	sensor->conversionOss = oss;
+	BMP085_conversionStarted(sensor,BMP085_PressureTypicalConversionTime[oss],BMP085_PressureConversionTime[oss]);
+	BMP085STATS_RECORD(&(sensor->stats),statsStartCommand,sensor->conversionStart - sensor->stats.mark);
+	sensor->state = pressureConversion;
+
+	return 0;
+}
+
+/* Starts a non-blocking temperature and pressure sampling. */
+int BMP085_startMeasurement(BMP085 *sensor)
+{
+	sensor->state = measurementIdle;
+	if (sensor->retryPolicy.budget)
+		sensor->measurementStart = tNow();
+
+	// The whole measurement is taken by the transport on the first poll.
+	if (sensor->busOps->measure)
+	{
+		sensor->conversionStart = tNow();
+		sensor->readyTime = sensor->conversionStart;
+		sensor->state = transportMeasurement;
+		return 0;
+	}
+
+	// Reuse the last temperature when the policy allows it.
+	if (BMP085_temperatureReusable(sensor))
+	{
+		if (BMP085_startPressureConversion(sensor))
+		{
+			BMP085STATS_ADD(&(sensor->stats),failedMeasurements,1);
+			return 1;
+		}
+		sensor->temperatureSamples++;
+		return 0;
+	}
+
+	// Send the command to start the temperature measurement.
+	BMP085_eocArm(sensor);
+	BMP085STATS_MARK(&(sensor->stats));
+	if (BMP085_write(sensor,BMP085_CONTROL_REG,BMP085_START_TEMPERATURE_MEASUREMENT))
+	{
+		BMP085STATS_ADD(&(sensor->stats),failedMeasurements,1);
+		return 1;
+	}
+
+	BMP085_conversionStarted(sensor,BMP085_TemperatureTypicalConversionTime,BMP085_TemperatureConversionTime);
+	BMP085STATS_RECORD(&(sensor->stats),statsStartCommand,sensor->conversionStart - sensor->stats.mark);
+	sensor->state = temperatureConversion;
+
+	return 0;
+}
+
+/* Returns the time when the running conversion is expected to be done. */
+long long BMP085_readyTime(const BMP085 *sensor)
+{
+	return sensor->readyTime;
+}
+
+/*
+ * Takes a measurement through the measure operation of the transport. The raw
+ * values are not known and are cleared, B5 is set to give the same temperature.
+ */
+static int BMP085_measure(BMP085 *sensor)
+{
+	void *context = sensor->busContext ? sensor->busContext : &(sensor->I2CBus);
+	int32_t temperature, pressure;
+
+	BMP085STATS_MARK(&(sensor->stats));
+	sensor->conversionOss = sensor->oss;
+	if (sensor->busOps->measure(context,sensor->I2CAddress,sensor->conversionOss,&temperature,&pressure))
+		return 1;
+	BMP085STATS_LAP(&(sensor->stats),statsDataRead);
+
+	memset(sensor->rawTemperatureData,0,2);
+	memset(sensor->rawPressureData,0,3);
+	sensor->b5 = (long)temperature * 16;
+	sensor->temperature = temperature * 0.1;
 	sensor->pressure = pressure;
+	sensor->temperatureTime = sensor->conversionStart;
+	sensor->temperatureDrift = 0;
+	return 0;
+}
+
+/* Advances the measurement state machine. */
+int BMP085_pollMeasurement(BMP085 *sensor)
+{
+	long lastTemperature;
+	int result;
+
+	switch (sensor->state)
+	{
+		case temperatureConversion:
+			if (BMP085_conversionPending(sensor))
+				return BMP085_MEASUREMENT_PENDING;
+			if ((result = BMP085_conversionDone(sensor,BMP085_TemperatureConversionTime)))
+			{
+				if (result == BMP085_MEASUREMENT_PENDING)
+					return result;
+				break;
+			}
+
+			// Read the temperature raw value
+			BMP085STATS_RECORD(&(sensor->stats),statsConversion,BMP085STATS_MARK(&(sensor->stats)) - sensor->conversionStart);
+			if (BMP085_read(sensor,BMP085_DATA_REG_MSB,sensor->rawTemperatureData,2))
+				break;
+			BMP085STATS_LAP(&(sensor->stats),statsDataRead);
+
+			lastTemperature = (sensor->b5 + 8)>>4;
+			BMP085_compensateTemperature(sensor);
+			BMP085STATS_LAP(&(sensor->stats),statsCompensation);
+			sensor->temperatureDrift = sensor->temperatureValid ? labs(((sensor->b5 + 8)>>4) - lastTemperature) : 0;
+			sensor->temperatureValid = 1;
+			sensor->temperatureSamples = 1;
+			sensor->temperatureTime = sensor->conversionStart;
 
+			// Send the command to start the pressure measurement.
+			if (BMP085_startPressureConversion(sensor))
+				break;
+			return BMP085_MEASUREMENT_PENDING;
+
+		case pressureConversion:
+			if (BMP085_conversionPending(sensor))
+				return BMP085_MEASUREMENT_PENDING;
+			if ((result = BMP085_conversionDone(sensor,BMP085_PressureConversionTime[sensor->conversionOss])))
+			{
+				if (result == BMP085_MEASUREMENT_PENDING)
+					return result;
+				break;
+			}
+
+			// Read the pressure raw value (MSB, LSB and XLSB) in one burst.
+			BMP085STATS_RECORD(&(sensor->stats),statsConversion,BMP085STATS_MARK(&(sensor->stats)) - sensor->conversionStart);
+			if (BMP085_read(sensor,BMP085_DATA_REG_MSB,sensor->rawPressureData,3))
+				break;
+			BMP085STATS_LAP(&(sensor->stats),statsDataRead);
+
+			BMP085_compensatePressure(sensor);
+			BMP085STATS_LAP(&(sensor->stats),statsCompensation);
+			BMP085STATS_ADD(&(sensor->stats),measurements,1);
+			sensor->state = measurementIdle;
+			return 0;
+
+		case transportMeasurement:
+			if (BMP085_measure(sensor))
+				break;
+			BMP085STATS_ADD(&(sensor->stats),measurements,1);
+			sensor->state = measurementIdle;
+			return 0;
+
+		default:
+			return 1;
+	}
+
+	BMP085STATS_ADD(&(sensor->stats),failedMeasurements,1);
+	sensor->state = measurementIdle;
+	return 1;
+}
+
+/* Changes the over sampling mode from the next pressure conversion. */
+void BMP085_setOverSampling(BMP085 *sensor,overSampling oss)
+{
+	sensor->oss=oss;
+}
+
+/* Selects how the end of a conversion is detected. */
+void BMP085_setEndOfConversionMode(BMP085 *sensor,endOfConversion eocMode)
+{
+	sensor->eocMode=eocMode;
+}
+
+/* Detects the end of a conversion with the EOC line. */
+void BMP085_setEndOfConversionLine(BMP085 *sensor,int line)
+{
+	sensor->eocLine=line;
+	sensor->eocMode=line >= 0 ? eocLine : eocTimed;
+	sensor->eocMissed=0;
+}
+
+/*
+ * Sleeps until the given time or until the EOC line of one of the sensors with a
+ * running measurement becomes readable.
+ */
+static void BMP085_waitReady(BMP085 **sensors,int count,long long time)
+{
+	struct pollfd lines[count];
+	struct timespec timeout;
+	long long now;
+	int i, n = 0;
+
+	for (i=0;i<count;i++)
+		if (sensors[i]->state != measurementIdle && BMP085_eocLine(sensors[i]) >= 0)
+		{
+			lines[n].fd = sensors[i]->eocLine;
+			lines[n].events = POLLIN;
+			n++;
+		}
+	if (!n)
+	{
+		tDelayUntil(time);
+		return;
+	}
+
+	while ((now = tNow()) < time)
+	{
+		timeout.tv_sec = (time - now) / 1000000000LL;
+		timeout.tv_nsec = (time - now) % 1000000000LL;
+		if (ppoll(lines,n,&timeout,NULL) != -1 || errno != EINTR)
+			return;
+	}
+}
+
+/* Configures when the temperature is refreshed. */
+void BMP085_setTemperaturePolicy(BMP085 *sensor,const temperaturePolicy *policy)
+{
+	if (policy)
+		sensor->temperaturePolicy=*policy;
+	else
+		memset(&(sensor->temperaturePolicy),0,sizeof(temperaturePolicy));
+	sensor->temperatureValid=0;
+}
+
+/* Configures retrying of failed transactions. */
+void BMP085_setRetryPolicy(BMP085 *sensor,const retryPolicy *policy)
+{
+	if (policy)
+		sensor->retryPolicy=*policy;
+	else
+		memset(&(sensor->retryPolicy),0,sizeof(retryPolicy));
+	memset(&(sensor->retryStats),0,sizeof(retryStats));
+	sensor->consecutiveFailures=0;
+}
+
+/* Starts a temperature and pressure sampling and waits for the result. */
+int BMP085_takeMeasurement(BMP085 *sensor)
+{
+	int result;
+
+	if (BMP085_startMeasurement(sensor))
+		return 1;
+
+	while ((result = BMP085_pollMeasurement(sensor)) == BMP085_MEASUREMENT_PENDING)
+		BMP085_waitReady(&sensor,1,BMP085_readyTime(sensor));
+
+	return result;
+}
+
+/* Samples several sensors sharing a bus with overlapping conversions. */
+int BMP085_takeGroupMeasurement(BMP085 **sensors,int count,int *status)
+{
+	long long next;
+	int i, pending = 0, failed = 0, result;
+
+	// Send the start commands back to back.
+	for (i=0;i<count;i++)
+	{
+		if (BMP085_startMeasurement(sensors[i]))
+		{
+			failed++;
+			if (status)
+				status[i] = 1;
+			continue;
+		}
+		if (status)
+			status[i] = BMP085_MEASUREMENT_PENDING;
+		pending++;
+	}
+
+	// Wait for the earliest conversion, then collect every sensor that is ready.
+	while (pending)
+	{
+		next = 0;
+		for (i=0;i<count;i++)
+			if (sensors[i]->state != measurementIdle && (!next || sensors[i]->readyTime < next))
+				next = sensors[i]->readyTime;
+		BMP085_waitReady(sensors,count,next);
+
+		for (i=0;i<count;i++)
+		{
+			if (sensors[i]->state == measurementIdle)
+				continue;
+			result = BMP085_pollMeasurement(sensors[i]);
+			if (result == BMP085_MEASUREMENT_PENDING)
+				continue;
+			pending--;
+			failed += result;
+			if (status)
+				status[i] = result;
+		}
+	}
+
+	return failed ? 1 : 0;
+}
+
+/* Copies the counters of the sensor. */
+int BMP085_getStats(const BMP085 *sensor,BMP085Stats *stats)
+{
+#ifdef BMP085_STATS
+	*stats = sensor->stats;
 	return 0;
+#else
+	(void)sensor;
+	(void)stats;
+	return 1;
+#endif
+}
+
+/* Clears the counters of the sensor. */
+void BMP085_resetStats(BMP085 *sensor)
+{
+	memset(&(sensor->stats),0,sizeof(BMP085Stats));
 }
 
 /* Prints the calibration table of the sensor on the standard output. */
@@ -135,6 +766,12 @@ void BMP085_printCalibrationTable(BMP085 *sensor)
 /* Calculates the relative altitude changes based on pressure differences at two measurement points. */
 int BMP085_Altitude(double lastPressureReading,double baseLinePressure)
 {
-	return round(44330*(1-pow((lastPressureReading/baseLinePressure),(1/5.255))));
+	return round(BMP085_calculateAltitude(lastPressureReading,baseLinePressure));
+}
+
+/* Calculates the relative altitude change in fractional metres with the international barometric formula. */
+double BMP085_calculateAltitude(double pressure,double baseLinePressure)
+{
+	return 44330*(1-pow((pressure/baseLinePressure),(1/5.255)));
 }
 
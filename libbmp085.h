@@ -3,6 +3,7 @@
  * libbmp085.h
  *
  * Copyright (c) 2014  Goce Boshkovski
+ * Copyright (c) 2026  libBMP085 contributors
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -17,6 +18,7 @@
   * and constants.
   *
   * @author Goce Boshkovski
+  * @author libBMP085 contributors
   * @copyright GNU General Public License v2.
   *
   */
@@ -24,6 +26,14 @@
 #ifndef LIBBMP085_H_
 #define LIBBMP085_H_
 
+#include <stdint.h>
+#include "I2Cbus.h"
+#include "bmp085stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** \defgroup libMacros libBMP085 library macros */
 /* @{ */
 /**
@@ -47,6 +57,13 @@
 #define BMP085_DATA_REG_LSB 0xF7
 #define BMP085_DATA_REG_XLASB 0xF8
 #define BMP085_CONTROL_REG 0xF4
+#define BMP085_CHIP_ID_REG 0xD0
+/** Content of the chip ID register. */
+#define BMP085_CHIP_ID 0x55
+/** Bytes at the start of the calibration table compared by BMP085_initSensorWithCalibration(). */
+#define BMP085_CALIBRATION_FINGERPRINT 4
+/** Start of conversion bit of the CONTROL register, cleared by the sensor when the conversion is done. */
+#define BMP085_CONTROL_SCO 0x20
 /* @} */
 
 /** \defgroup SENSOR_CMD Bosch BMP085 commands (CONTROL register values). */
@@ -55,11 +72,27 @@
 #define BMP085_START_PRESSURE_MEASUREMENT 0x34
 /* @} */
 
+/** \defgroup MEASUREMENT_STATUS Status codes of the non-blocking measurement */
+/* @{ */
+/** The measurement is still in progress, poll again after BMP085_readyTime(). */
+#define BMP085_MEASUREMENT_PENDING 2
+/** Interval in [ns] between two reads of the Sco bit in eocPollSco mode. */
+#define BMP085_SCO_POLL_INTERVAL 250000L
+/* @} */
+
 /** \defgroup CONST Average sea level pressure. */
 /* @{ */
 #define AVERAGE_SEA_LEVEL_PRESSURE 1013.25
 /* @} */
 
+/** \defgroup CONVERSION_TIME Conversion times in [ns] */
+/* @{ */
+extern const long BMP085_TemperatureConversionTime;	/**< Maximum temperature conversion time. */
+extern const long BMP085_PressureConversionTime[];	/**< Maximum pressure conversion time, indexed by overSampling. */
+extern const long BMP085_TemperatureTypicalConversionTime;	/**< Typical temperature conversion time. */
+extern const long BMP085_PressureTypicalConversionTime[];	/**< Typical pressure conversion time, indexed by overSampling. */
+/* @} */
+
 /**
  * @brief Barometric pressure measurement modes.
  */
@@ -71,6 +104,100 @@ typedef enum oversampling
 	ultraHighResolution
 } overSampling;
 
+/**
+ * @brief Decoded calibration table with the terms that depend only on the calibration.
+ *
+ * Filled in by BMP085_decodeCalibration(). The oss-dependent terms are
+ * precomputed for every mode, so samples taken in different modes can be
+ * compensated with the same context.
+ */
+typedef struct bmp085calibration
+{
+	int16_t ac1;	/**< AC1 calibration coefficient. */
+	int16_t ac2;	/**< AC2 calibration coefficient. */
+	int16_t ac3;	/**< AC3 calibration coefficient. */
+	uint16_t ac4;	/**< AC4 calibration coefficient. */
+	uint16_t ac5;	/**< AC5 calibration coefficient. */
+	uint16_t ac6;	/**< AC6 calibration coefficient. */
+	int16_t b1;	/**< B1 calibration coefficient. */
+	int16_t b2;	/**< B2 calibration coefficient. */
+	int16_t mb;	/**< MB calibration coefficient. */
+	int16_t mc;	/**< MC calibration coefficient. */
+	int16_t md;	/**< MD calibration coefficient. */
+	int32_t mc11;	/**< MC * 2^11. */
+	int64_t ac1x4[4];	/**< (AC1 * 4) << oss, indexed by overSampling. */
+	uint32_t b7Scale[4];	/**< 50000 >> oss, indexed by overSampling. */
+} BMP085Calibration;
+
+/**
+ * @brief Methods for detecting the end of a conversion.
+ */
+typedef enum endofconversion
+{
+	eocTimed = 0,	/**< Wait for the maximum conversion time from the datasheet. */
+	eocPollSco,	/**< Poll the Sco bit of the CONTROL register after the typical conversion time. */
+	eocLine	/**< Wait for the rising edge of the EOC pin, see BMP085_setEndOfConversionLine(). */
+} endOfConversion;
+
+/** Maximum age in [ms] of a temperature reused by a policy that sets only driftThreshold, once per second as in the datasheet. */
+#define BMP085_DEFAULT_MAX_AGE 1000
+
+/**
+ * @brief Policy for reusing the last temperature (B5) for the following pressure samples.
+ *
+ * The temperature is refreshed when any of the enabled limits is reached.
+ * The default policy, all members set to 0, refreshes the temperature on every sample.
+ * The drift is only measured when the temperature is refreshed, so a policy
+ * with driftThreshold alone also refreshes it after BMP085_DEFAULT_MAX_AGE.
+ */
+typedef struct temperaturepolicy
+{
+	unsigned int maxSamples;	/**< Number of pressure samples that share one temperature conversion, 1 refreshes on every sample, 0 sets no limit when maxAge or driftThreshold is set and refreshes on every sample otherwise. */
+	long maxAge;	/**< Maximum age of a reused temperature in [ms], 0 disables the limit unless only driftThreshold is set. */
+	long driftThreshold;	/**< Change between the last two temperature readings in 0.1 degrees Celsius above which every sample refreshes the temperature, 0 disables the check. */
+} temperaturePolicy;
+
+/**
+ * @brief Policy for retrying failed bus transactions.
+ *
+ * Only the failed transaction is repeated, the measurement continues from the
+ * phase it was in. The default policy, all members set to 0, fails the
+ * measurement on the first error.
+ */
+typedef struct retrypolicy
+{
+	unsigned int maxRetries;	/**< Retries of one failed transaction, 0 disables retrying. */
+	long backoff;	/**< Delay in [ns] before the first retry, doubled for every following retry. */
+	long long budget;	/**< Latency budget of one measurement in [ns]; a retry that would end after it is not attempted, 0 disables the limit. */
+	unsigned int recoverAfter;	/**< Consecutive failed transactions after which the transport is recovered (the i2c-dev bus is reopened), 0 disables the recovery. */
+} retryPolicy;
+
+/**
+ * @brief Counters of failed transactions, retries and bus recoveries.
+ */
+typedef struct retrystats
+{
+	unsigned long failures;	/**< Failed transaction attempts. */
+	unsigned long retries;	/**< Repeated transaction attempts. */
+	unsigned long recovered;	/**< Transactions that succeeded after one or more retries. */
+	unsigned long exhausted;	/**< Transactions that failed after the last allowed retry or at the end of the budget. */
+	unsigned long recoveries;	/**< Successful transport recoveries. */
+	unsigned long failedRecoveries;	/**< Failed transport recoveries. */
+	long long retryTime;	/**< Total time in [ns] from the first failure of a transaction to its final result. */
+	long long maxRetryTime;	/**< Longest time in [ns] spent retrying a single transaction. */
+} retryStats;
+
+/**
+ * @brief States of the non-blocking measurement.
+ */
+typedef enum measurementstate
+{
+	measurementIdle = 0,	/**< No measurement in progress. */
+	temperatureConversion,	/**< Waiting for the temperature conversion. */
+	pressureConversion,	/**< Waiting for the pressure conversion. */
+	transportMeasurement	/**< Waiting for the measure operation of the transport. */
+} measurementState;
+
 /**
  * @brief Represents Bosch BMP085 sensor readings and configuration.
  */
@@ -79,11 +206,32 @@ typedef struct bmp085
 	char I2CAddress;	/**< I2C address of the Bosch BMP085 sensor.*/
 	int I2CBus;	/**< File descriptor for accessing I2C bus.*/
 	unsigned char calibrationCoeficients[22];	/**< Bosch BMP085 calibration table.*/
+	BMP085Calibration calibration;	/**< Calibration table decoded by BMP085_initSensor().*/
 	unsigned char rawPressureData[3]; /**< Buffer for the raw pressure data reading from the sensor.*/
 	unsigned char rawTemperatureData[2];	/**< Buffer for the raw temperature data reading from the sensor.*/
 	float temperature;	/**< Last temperature reading in degrees Celsius. */
 	long pressure;	/**< Last barometric pressure reading in Pa. */
 	overSampling oss;	/**< Bosch BMP085 sensor mode of operation for the pressure measurement. */
+	const I2CBusOps *busOps;	/**< Transport used for accessing the sensor registers.*/
+	void *busContext;	/**< Context passed to the transport operations, NULL selects I2CBus.*/
+	measurementState state;	/**< State of the running measurement. */
+	long long readyTime;	/**< CLOCK_MONOTONIC time in [ns] when the running conversion is done. */
+	long long conversionStart;	/**< CLOCK_MONOTONIC time in [ns] when the running conversion was started. */
+	overSampling conversionOss;	/**< Over sampling mode of the running or the last pressure conversion. */
+	endOfConversion eocMode;	/**< Method for detecting the end of a conversion. */
+	int eocLine;	/**< Non-blocking file descriptor of the EOC line events, -1 when no line is configured. */
+	unsigned long eocMissed;	/**< Conversions collected at the maximum conversion time without an EOC edge. */
+	long b5;	/**< B5 term calculated from the last raw temperature. */
+	struct temperaturepolicy temperaturePolicy;	/**< Policy for reusing the last temperature. */
+	int temperatureValid;	/**< Set when b5 holds a temperature that can be reused. */
+	unsigned int temperatureSamples;	/**< Number of pressure samples that used the current temperature. */
+	long long temperatureTime;	/**< CLOCK_MONOTONIC time in [ns] of the current temperature conversion. */
+	long temperatureDrift;	/**< Change between the last two temperature readings in 0.1 degrees Celsius. */
+	struct retrypolicy retryPolicy;	/**< Policy for retrying failed transactions. */
+	struct retrystats retryStats;	/**< Failed transactions, retries and recoveries. */
+	long long measurementStart;	/**< CLOCK_MONOTONIC time in [ns] when the running measurement was started, set only with a retry budget. */
+	unsigned int consecutiveFailures;	/**< Failed transaction attempts since the last successful one. */
+	BMP085Stats stats;	/**< Performance counters and latency histograms, updated only with BMP085_STATS. */
 } BMP085;
 
 
@@ -99,6 +247,9 @@ typedef struct bmp085
  * calculating the temperature and pressure values.
  * Call this function first, before any other function related to the sensor.
  *
+ * The function fails when the calibration table contains a 0x0000 or 0xFFFF
+ * coefficient, which indicates a failed communication with the sensor.
+ *
  * @param[in,out] sensor pointer to the structure that represents the sensor.
  * @param[in] I2Cbus pointer to the file descriptor of the I2C bus present on the system.
  * @param[in] I2CAddress address of the sensor on the I2C bus.
@@ -107,6 +258,41 @@ typedef struct bmp085
  */
 int BMP085_initSensor(BMP085 *sensor,int *I2Cbus,unsigned char I2CAddress,overSampling oss);
 
+/**
+ * @brief Sensor initialization over a custom transport.
+ *
+ * Same as BMP085_initSensor(), but the sensor registers are accessed through
+ * the operations in \a busOps instead of the Linux i2c-dev interface.
+ * When the transport provides the measure operation, the calibration table is
+ * not read and stays zero.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] busOps transport operations used for accessing the sensor.
+ * @param[in] busContext context passed to the transport operations.
+ * @param[in] I2CAddress address of the sensor on the I2C bus.
+ * @param[in] oss defining the over sampling mode of the sensor for the pressure measurement.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085_initSensorOnBus(BMP085 *sensor,const I2CBusOps *busOps,void *busContext,unsigned char I2CAddress,overSampling oss);
+
+/**
+ * @brief Sensor initialization with a calibration table known from an earlier initialization.
+ *
+ * Same as BMP085_initSensorOnBus(), but instead of reading the whole calibration
+ * table the function reads the chip ID register and the first
+ * BMP085_CALIBRATION_FINGERPRINT bytes of the table, and uses \a table when they
+ * match. See bmp085calcache.h for keeping the tables between runs.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] busOps transport operations used for accessing the sensor.
+ * @param[in] busContext context passed to the transport operations.
+ * @param[in] I2CAddress address of the sensor on the I2C bus.
+ * @param[in] oss defining the over sampling mode of the sensor for the pressure measurement.
+ * @param[in] table 22 bytes of calibration data read from the sensor before.
+ * @return int returns 0 for successful operation, 1 for failure or when the sensor does not match \a table.
+ */
+int BMP085_initSensorWithCalibration(BMP085 *sensor,const I2CBusOps *busOps,void *busContext,unsigned char I2CAddress,overSampling oss,const unsigned char *table);
+
 
 /**
  * @brief Starts the process of temperature and pressure measurement.
@@ -115,11 +301,176 @@ int BMP085_initSensor(BMP085 *sensor,int *I2Cbus,unsigned char I2CAddress,overSa
  * the function calculates the temperature values in degrees Celsius and
  * barometric pressure in [Pa].
  *
+ * The function blocks until both conversions are done. It is a wrapper
+ * around BMP085_startMeasurement() and BMP085_pollMeasurement().
+ *
  * @param[in,out] sensor pointer to the structure that represents the sensor.
  * @return int returns 0 for successful operation, 1 for failure.
  */
 int BMP085_takeMeasurement(BMP085 *sensor);
 
+/**
+ * @brief Samples several sensors that share a bus with overlapping conversions.
+ *
+ * The start commands are sent to all sensors back to back and the results are
+ * collected as the conversions finish, so the group costs about one conversion
+ * time instead of one conversion time per sensor.
+ *
+ * @param[in,out] sensors pointers to the sensors of the group.
+ * @param[in] count number of sensors in the group.
+ * @param[out] status result of every sensor, 0 for success and 1 for failure; can be NULL.
+ * @return int returns 0 when all sensors were sampled successfully, 1 otherwise.
+ */
+int BMP085_takeGroupMeasurement(BMP085 **sensors,int count,int *status);
+
+/**
+ * @brief Starts a non-blocking temperature and pressure measurement.
+ *
+ * Sends the command for the temperature conversion and returns immediately.
+ * The measurement is completed by calling BMP085_pollMeasurement() once
+ * the time returned by BMP085_readyTime() is reached or, in eocLine mode,
+ * as soon as the EOC line descriptor becomes readable.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @return int returns 0 for successful operation, 1 for failure.
+ */
+int BMP085_startMeasurement(BMP085 *sensor);
+
+/**
+ * @brief Returns the earliest time the running measurement can make progress.
+ *
+ * @param[in] sensor pointer to the structure that represents the sensor.
+ * @return long long CLOCK_MONOTONIC time in [ns], see tNow().
+ */
+long long BMP085_readyTime(const BMP085 *sensor);
+
+/**
+ * @brief Advances the non-blocking measurement.
+ *
+ * Calling the function before BMP085_readyTime() has no effect on the sensor.
+ * When the temperature conversion is done, the function reads the raw temperature
+ * and starts the pressure conversion. When the pressure conversion is done, it reads
+ * the raw pressure and updates the temperature and pressure values of the sensor.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @return int returns 0 when the measurement is complete, BMP085_MEASUREMENT_PENDING
+ * while it is in progress, 1 for failure or when no measurement was started.
+ */
+int BMP085_pollMeasurement(BMP085 *sensor);
+
+/**
+ * @brief Changes the over sampling mode of the pressure measurement.
+ *
+ * The mode takes effect from the next pressure conversion. A running
+ * conversion is completed and compensated in the mode it was started with,
+ * which is kept in conversionOss.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] oss the new over sampling mode.
+ */
+void BMP085_setOverSampling(BMP085 *sensor,overSampling oss);
+
+/**
+ * @brief Selects how the end of a conversion is detected.
+ *
+ * In eocTimed mode (the default) the library waits for the maximum conversion time
+ * from the datasheet. In eocPollSco mode it waits for the typical conversion time and
+ * then polls the Sco bit of the CONTROL register every BMP085_SCO_POLL_INTERVAL,
+ * collecting the result as soon as the sensor is done. Polling never waits longer than
+ * the maximum conversion time. eocLine mode needs a line set with
+ * BMP085_setEndOfConversionLine() and falls back to eocTimed without one.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] eocMode method for detecting the end of a conversion.
+ */
+void BMP085_setEndOfConversionMode(BMP085 *sensor,endOfConversion eocMode);
+
+/**
+ * @brief Detects the end of a conversion with the EOC pin of the sensor.
+ *
+ * The EOC pin goes high when a conversion is done. \a line is a non-blocking
+ * file descriptor that becomes readable on the rising edge, like the one
+ * returned by openEocLine(); any descriptor with the same behaviour works, for
+ * example a timerfd or a pipe in tests. Pending events are discarded before
+ * every conversion. BMP085_takeMeasurement() sleeps in ppoll() on the line and
+ * reads the result as soon as the edge arrives. In an event loop, watch the
+ * line and call BMP085_pollMeasurement() when it is readable or when
+ * BMP085_readyTime() is reached. Without an edge the result is read at the
+ * maximum conversion time and counted in eocMissed.
+ *
+ * The line is not closed by the library.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] line file descriptor of the line events, -1 to go back to eocTimed mode.
+ */
+void BMP085_setEndOfConversionLine(BMP085 *sensor,int line);
+
+/**
+ * @brief Configures when the temperature is refreshed.
+ *
+ * The pressure compensation needs the B5 term from a temperature measurement.
+ * When the temperature changes slowly, B5 can be reused and a sample then costs
+ * a single pressure conversion. The policy takes effect from the next measurement,
+ * which always refreshes the temperature.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] policy the new policy, NULL restores the default of refreshing on every sample.
+ */
+void BMP085_setTemperaturePolicy(BMP085 *sensor,const temperaturePolicy *policy);
+
+/**
+ * @brief Configures retrying of failed transactions and the recovery of the bus.
+ *
+ * A failed read or write is repeated after the backoff, up to maxRetries times,
+ * while the retry ends within the latency budget of the measurement. After
+ * recoverAfter consecutive failures the recover operation of the transport is
+ * called; for the i2c-dev transport it reopens the bus device on the same file
+ * descriptor. The backoff sleeps, also inside BMP085_pollMeasurement().
+ * Failures and retry times are counted in retryStats.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ * @param[in] policy the new policy, NULL restores the default of not retrying.
+ */
+void BMP085_setRetryPolicy(BMP085 *sensor,const retryPolicy *policy);
+
+/**
+ * @brief Decodes and validates a raw calibration table.
+ *
+ * @param[out] calibration the decoded calibration table.
+ * @param[in] table 22 bytes of calibration data as read from the sensor at BMP085_CALIBRATION_TABLE.
+ * @return int returns 0 for a valid table, 1 when any coefficient is 0x0000 or 0xFFFF.
+ */
+int BMP085_decodeCalibration(BMP085Calibration *calibration,const unsigned char *table);
+
+/**
+ * @brief Calculates the temperature from a raw temperature value.
+ *
+ * Pure implementation of the datasheet algorithm, does not access the sensor.
+ * Intermediate values are 64 bit wide, so the result does not depend on the size of long.
+ * A division by zero in the algorithm yields a zero quotient.
+ *
+ * @param[in] calibration decoded calibration table.
+ * @param[in] rawTemperature raw temperature value (UT).
+ * @param[out] b5 B5 term needed for the pressure calculation.
+ * @return int32_t temperature in 0.1 degrees Celsius.
+ */
+int32_t BMP085_calculateTemperature(const BMP085Calibration *calibration,int32_t rawTemperature,int32_t *b5);
+
+/**
+ * @brief Calculates the pressure from a raw pressure value.
+ *
+ * Pure implementation of the datasheet algorithm, does not access the sensor.
+ * Intermediate values are 64 bit wide, so the result does not depend on the size of long.
+ * A division by zero in the algorithm yields a zero quotient.
+ *
+ * @param[in] calibration decoded calibration table.
+ * @param[in] oss over sampling mode used for the pressure conversion.
+ * @param[in] rawPressure raw pressure value (UP), already shifted right by 8-oss.
+ * @param[in] b5 B5 term returned by BMP085_calculateTemperature().
+ * @return int32_t pressure in [Pa].
+ */
+int32_t BMP085_calculatePressure(const BMP085Calibration *calibration,overSampling oss,int32_t rawPressure,int32_t b5);
+
 /**
  * @brief The function prints the calibration table of the BMP085 sensor on the standard output.
  *
@@ -143,4 +494,38 @@ void BMP085_printCalibrationTable(BMP085 *sensor);
  */
 int BMP085_Altitude(double lastPressureReading,double baseLinePressure);
 
+/**
+ * @brief Calculates the relative altitude change in [m] without rounding it to whole metres.
+ *
+ * Uses the same formula as BMP085_Altitude(). For converting many readings,
+ * see BMP085_approximateAltitude() and BMP085_approximateAltitudeBatch().
+ *
+ * @param[in] pressure pressure at the measurement point, in the same unit as \a baseLinePressure.
+ * @param[in] baseLinePressure reference pressure.
+ * @return double the relative altitude change in [m].
+ */
+double BMP085_calculateAltitude(double pressure,double baseLinePressure);
+
+/**
+ * @brief Copies the performance counters and latency histograms of a sensor.
+ *
+ * The counters are kept only when the library is built with BMP085_STATS.
+ *
+ * @param[in] sensor pointer to the structure that represents the sensor.
+ * @param[out] stats the counters of the sensor.
+ * @return int returns 0 for successful operation, 1 when the library is built without BMP085_STATS.
+ */
+int BMP085_getStats(const BMP085 *sensor,BMP085Stats *stats);
+
+/**
+ * @brief Clears the performance counters and latency histograms of a sensor.
+ *
+ * @param[in,out] sensor pointer to the structure that represents the sensor.
+ */
+void BMP085_resetStats(BMP085 *sensor);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* LIBBMP085_H_ */
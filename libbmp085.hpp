@@ -0,0 +1,327 @@
+/*
+ * BMP085 library
+ * libbmp085.hpp
+ *
+ * Copyright (c) 2026  libBMP085 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License.
+ */
+
+ /**
+  * @file libbmp085.hpp
+  * @brief
+  * Header-only C++ interface of libBMP085 library.
+  *
+  * Bus is an RAII handle of an i2c-dev bus. Sensor is templated on the over
+  * sampling mode, so the pressure command, the conversion times and the shifts
+  * of the compensation are compile-time constants in Sensor::measure(). The
+  * compensation is available as constexpr functions, usable in constant
+  * expressions and static_assert. Nothing in the measurement path allocates
+  * memory or throws; only the constructors throw std::system_error.
+  *
+  * Requires C++14.
+  *
+  * @author libBMP085 contributors
+  * @copyright GNU General Public License v2.
+  *
+  */
+
+#ifndef LIBBMP085_HPP_
+#define LIBBMP085_HPP_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <system_error>
+#include "libbmp085.h"
+
+namespace libbmp085
+{
+
+/**
+ * @brief Calibration coefficients of a sensor, decodable at compile time.
+ */
+struct Calibration
+{
+	int16_t ac1, ac2, ac3;
+	uint16_t ac4, ac5, ac6;
+	int16_t b1, b2, mb, mc, md;
+
+	/**
+	 * @brief Decodes the 22 bytes read from BMP085_CALIBRATION_TABLE.
+	 */
+	static constexpr Calibration fromTable(const unsigned char *table)
+	{
+		return Calibration{
+			word(table,0), word(table,2), word(table,4),
+			uword(table,6), uword(table,8), uword(table,10),
+			word(table,12), word(table,14), word(table,16), word(table,18), word(table,20) };
+	}
+
+private:
+	static constexpr int16_t word(const unsigned char *table,int i)
+	{
+		return static_cast<int16_t>((table[i] << 8) | table[i+1]);
+	}
+
+	static constexpr uint16_t uword(const unsigned char *table,int i)
+	{
+		return static_cast<uint16_t>((table[i] << 8) | table[i+1]);
+	}
+};
+
+/**
+ * @brief Result of the temperature compensation.
+ */
+struct Temperature
+{
+	int32_t value;	/**< Temperature in 0.1 degrees Celsius. */
+	int32_t b5;	/**< B5 term for the pressure compensation. */
+};
+
+/**
+ * @brief Calculates the temperature from a raw temperature value.
+ *
+ * Same result as BMP085_calculateTemperature().
+ */
+constexpr Temperature calculateTemperature(const Calibration &calibration,int32_t rawTemperature)
+{
+	int64_t x1 = ((static_cast<int64_t>(rawTemperature) - calibration.ac6) * calibration.ac5) >> 15;
+	int64_t x2 = (x1 + calibration.md) ? (static_cast<int32_t>(calibration.mc) * 2048) / (x1 + calibration.md) : 0;
+	int32_t b5 = static_cast<int32_t>(x1 + x2);
+
+	return Temperature{ (b5 + 8) >> 4, b5 };
+}
+
+/**
+ * @brief Calculates the pressure in [Pa] from a raw pressure value and B5.
+ *
+ * Same result as BMP085_calculatePressure() with the over sampling mode
+ * fixed at compile time.
+ *
+ * @tparam OSS over sampling mode of the pressure conversion.
+ */
+template <overSampling OSS>
+constexpr int32_t calculatePressure(const Calibration &calibration,int32_t rawPressure,int32_t b5)
+{
+	int64_t b6 = static_cast<int64_t>(b5) - 4000;
+	int64_t x1 = (calibration.b2 * ((b6 * b6) >> 12)) >> 11;
+	int64_t x2 = (calibration.ac2 * b6) >> 11;
+	int64_t x3 = x1 + x2;
+	int64_t b3 = (((static_cast<int64_t>(calibration.ac1) * 4 * (1 << OSS)) + x3 * (1 << OSS)) + 2) / 4;
+	x1 = (calibration.ac3 * b6) >> 13;
+	x2 = (calibration.b1 * ((b6 * b6) >> 12)) >> 16;
+	x3 = ((x1 + x2) + 2) >> 2;
+	uint64_t b4 = (calibration.ac4 * static_cast<uint64_t>(x3 + 32768)) >> 15;
+	uint64_t b7 = (static_cast<uint64_t>(rawPressure) - b3) * (50000 >> OSS);
+	int64_t pressure = 0;
+
+	if (b4 == 0)
+		return 0;
+	if (b7 < 0x80000000)
+		pressure = (b7 * 2) / b4;
+	else
+		pressure = (b7 / b4) * 2;
+	x1 = (pressure >> 8) * (pressure >> 8);
+	x1 = (x1 * 3038) >> 16;
+	x2 = (-7357 * pressure) >> 16;
+	pressure += (x1 + x2 + 3791) >> 4;
+
+	return static_cast<int32_t>(pressure);
+}
+
+/**
+ * @brief Owns the file descriptor of an i2c-dev bus, replacing openI2CBus() and closeI2CBus().
+ */
+class Bus
+{
+public:
+	/**
+	 * @brief Opens the bus device.
+	 *
+	 * @param device name of the bus device, for example "/dev/i2c-1".
+	 * @throw std::system_error when the device cannot be opened.
+	 */
+	explicit Bus(const char *device)
+	{
+		if (openI2CBus(&fd_,const_cast<char *>(device)))
+			throw std::system_error(errno,std::generic_category(),device);
+	}
+
+	~Bus()
+	{
+		if (fd_ >= 0)
+			closeI2CBus(&fd_);
+	}
+
+	Bus(Bus &&other) noexcept : fd_(other.fd_)
+	{
+		other.fd_ = -1;
+	}
+
+	Bus &operator=(Bus &&other) noexcept
+	{
+		if (this != &other)
+		{
+			if (fd_ >= 0)
+				closeI2CBus(&fd_);
+			fd_ = other.fd_;
+			other.fd_ = -1;
+		}
+		return *this;
+	}
+
+	Bus(const Bus &) = delete;
+	Bus &operator=(const Bus &) = delete;
+
+	/** File descriptor of the bus. */
+	int fd() const noexcept { return fd_; }
+
+private:
+	int fd_ = -1;
+};
+
+/**
+ * @brief BMP085 sensor with the over sampling mode fixed at compile time.
+ *
+ * Wraps a BMP085 structure, so the C functions remain available through raw().
+ * measure() runs the blocking measurement with constant commands, waits and
+ * shifts; it does not apply the retry policy, the temperature reuse policy,
+ * the end-of-conversion mode or the counters of the C state machine, use the
+ * C functions on raw() for those. A successful measure() updates the conversion
+ * times, the mode and the temperature state of raw() like BMP085_takeMeasurement(),
+ * so helpers such as BMP085Stream_sample() and BMP085LogWriter_appendSensor()
+ * see the current sample.
+ *
+ * @tparam OSS over sampling mode of the pressure measurement.
+ */
+template <overSampling OSS>
+class Sensor
+{
+	static_assert(OSS >= ultraLowPower && OSS <= ultraHighResolution,"unsupported over sampling mode");
+
+public:
+	/** Maximum temperature conversion time in [ns]. */
+	static constexpr long temperatureConversionTime = 4500000L;
+	/** Maximum pressure conversion time of the mode in [ns]. */
+	static constexpr long pressureConversionTime = OSS == ultraLowPower ? 5000000L :
+		OSS == standard ? 8000000L : OSS == highResolution ? 14000000L : 26000000L;
+	/** Command written to the CONTROL register for the pressure conversion. */
+	static constexpr unsigned char pressureCommand = BMP085_START_PRESSURE_MEASUREMENT + (OSS << 6);
+
+	/**
+	 * @brief Initializes a sensor on an i2c-dev bus.
+	 *
+	 * @param bus the bus, it must outlive the sensor.
+	 * @param I2CAddress address of the sensor on the bus.
+	 * @throw std::system_error when the calibration table cannot be read.
+	 */
+	Sensor(const Bus &bus,unsigned char I2CAddress)
+	{
+		int fd = bus.fd();
+
+		if (BMP085_initSensor(&sensor_,&fd,I2CAddress,OSS))
+			throw std::system_error(errno ? errno : EIO,std::generic_category(),"BMP085_initSensor");
+		calibration_ = Calibration::fromTable(sensor_.calibrationCoeficients);
+	}
+
+	/**
+	 * @brief Initializes a sensor over a custom transport.
+	 *
+	 * @param busOps transport operations, for example BMP085Sim_busOps.
+	 * @param busContext context passed to the transport operations.
+	 * @param I2CAddress address of the sensor on the bus.
+	 * @throw std::system_error when the calibration table cannot be read.
+	 */
+	Sensor(const I2CBusOps &busOps,void *busContext,unsigned char I2CAddress)
+	{
+		if (BMP085_initSensorOnBus(&sensor_,&busOps,busContext,I2CAddress,OSS))
+			throw std::system_error(errno ? errno : EIO,std::generic_category(),"BMP085_initSensorOnBus");
+		calibration_ = Calibration::fromTable(sensor_.calibrationCoeficients);
+	}
+
+	/**
+	 * @brief Measures the temperature and pressure and waits for the result.
+	 *
+	 * @return int returns 0 for successful operation, 1 for failure.
+	 */
+	int measure() noexcept
+	{
+		void *context = sensor_.busContext ? sensor_.busContext : &(sensor_.I2CBus);
+		const I2CBusOps *ops = sensor_.busOps;
+		Temperature temperature;
+		long long temperatureStart, pressureStart;
+
+		if (ops->measure)
+			return BMP085_takeMeasurement(&sensor_);
+
+		if (ops->write(context,sensor_.I2CAddress,BMP085_CONTROL_REG,BMP085_START_TEMPERATURE_MEASUREMENT))
+			return 1;
+		temperatureStart = tNow();
+		tDelay(temperatureConversionTime);
+		if (ops->read(context,sensor_.I2CAddress,BMP085_DATA_REG_MSB,sensor_.rawTemperatureData,2))
+			return 1;
+		temperature = calculateTemperature(calibration_,(sensor_.rawTemperatureData[0] << 8) + sensor_.rawTemperatureData[1]);
+
+		if (ops->write(context,sensor_.I2CAddress,BMP085_CONTROL_REG,pressureCommand))
+			return 1;
+		pressureStart = tNow();
+		tDelay(pressureConversionTime);
+		if (ops->read(context,sensor_.I2CAddress,BMP085_DATA_REG_MSB,sensor_.rawPressureData,3))
+			return 1;
+
+		// Same sample state as the C state machine leaves behind.
+		sensor_.temperatureDrift = sensor_.temperatureValid ? std::abs(temperature.value - ((sensor_.b5 + 8) >> 4)) : 0;
+		sensor_.temperatureValid = 1;
+		sensor_.temperatureSamples = 1;
+		sensor_.temperatureTime = temperatureStart;
+		sensor_.conversionStart = pressureStart;
+		sensor_.conversionOss = OSS;
+		sensor_.b5 = temperature.b5;
+		sensor_.temperature = temperature.value * 0.1f;
+		sensor_.pressure = calculatePressure<OSS>(calibration_,rawPressure(),temperature.b5);
+		return 0;
+	}
+
+	/** Last temperature in degrees Celsius. */
+	float temperature() const noexcept { return sensor_.temperature; }
+
+	/** Last pressure in [Pa]. */
+	long pressure() const noexcept { return sensor_.pressure; }
+
+	/** Raw pressure value (UP) of the last measurement. */
+	int32_t rawPressure() const noexcept
+	{
+		return ((sensor_.rawPressureData[0] << 16) + (sensor_.rawPressureData[1] << 8) + sensor_.rawPressureData[2]) >> (8 - OSS);
+	}
+
+	/** Calibration coefficients of the sensor. */
+	const Calibration &calibration() const noexcept { return calibration_; }
+
+	/** The wrapped C structure. */
+	BMP085 &raw() noexcept { return sensor_; }
+	const BMP085 &raw() const noexcept { return sensor_; }
+
+private:
+	BMP085 sensor_;
+	Calibration calibration_;
+};
+
+namespace detail
+{
+/* Calibration example from the Bosch datasheet. */
+constexpr unsigned char datasheetTable[22] = {
+	0x01, 0x98, 0xFF, 0xB8, 0xC7, 0xD1, 0x7F, 0xE5, 0x7F, 0xF5, 0x5A, 0x71,
+	0x18, 0x2E, 0x00, 0x04, 0x80, 0x00, 0xDD, 0xF9, 0x0B, 0x34 };
+constexpr Calibration datasheetCalibration = Calibration::fromTable(datasheetTable);
+}
+
+static_assert(calculateTemperature(detail::datasheetCalibration,27898).value == 150,"datasheet temperature example");
+static_assert(calculatePressure<ultraLowPower>(detail::datasheetCalibration,23843,
+	calculateTemperature(detail::datasheetCalibration,27898).b5) == 69964,"datasheet pressure example");
+
+}
+
+#endif /* LIBBMP085_HPP_ */